@@ -0,0 +1,129 @@
+/**
+ * LED-Panel-ESP12F - Fuzz Target Support
+ *
+ * Shared by the libFuzzer targets in fuzz/ (see fuzz/run.sh):
+ *
+ * - FUZZ_CHECK() aborts with a message when an invariant breaks, so
+ *   libFuzzer (or the standalone driver) records the input as a crash
+ * - Meter times the parser work of each input and, at exit, prints the
+ *   throughput as Bench result lines (include/bench.h): ns per input and
+ *   ns per KiB. With FUZZ_BENCH_OUT set they are also appended to that
+ *   file, so tools/benchcmp.py can compare parser speed across versions.
+ *   Only the parser is timed, not input generation. When the same inputs
+ *   are run in laps (a corpus replay, lap() after each pass), the fastest
+ *   lap is reported, as Bench::measure() does; otherwise the mean
+ *
+ *   static Fuzz::Meter meter("status_line");
+ *   extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+ *       meter.run(size, [&] { ... });
+ *       return 0;
+ *   }
+ */
+
+#ifndef FUZZ_H
+#define FUZZ_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "bench.h"
+
+#define FUZZ_CHECK(cond)                                                        \
+    do {                                                                        \
+        if (!(cond)) {                                                          \
+            fprintf(stderr, "%s:%d: invariant failed: %s\n", __FILE__, __LINE__, \
+                    #cond);                                                     \
+            abort();                                                            \
+        }                                                                       \
+    } while (0)
+
+namespace Fuzz {
+
+inline uint64_t nowNs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1000000000ull + static_cast<uint64_t>(ts.tv_nsec);
+}
+
+class Meter {
+public:
+    explicit Meter(const char* target) : _target(target) { active() = this; }
+
+    // The binary's meter (one target per binary)
+    static Meter*& active() {
+        static Meter* meter = nullptr;
+        return meter;
+    }
+
+    ~Meter() { report(); }
+
+    template <class Fn>
+    void run(size_t size, Fn&& fn) {
+        uint64_t start = nowNs();
+        fn();
+        uint64_t ns = nowNs() - start;
+        _ns       += ns;
+        _bytes    += size;
+        _lapNs    += ns;
+        _lapBytes += size;
+        _inputs++;
+        _lapInputs++;
+    }
+
+    /**
+     * End a lap over the same inputs; keeps the fastest
+     */
+    void lap() {
+        if (_lapInputs && (_bestInputs == 0 || _lapNs < _bestNs)) {
+            _bestNs     = _lapNs;
+            _bestBytes  = _lapBytes;
+            _bestInputs = _lapInputs;
+        }
+        _lapNs = _lapBytes = _lapInputs = 0;
+    }
+
+    void report() const {
+        if (_inputs == 0) return;
+
+        char name[2][48];
+        snprintf(name[0], sizeof(name[0]), "fuzz.%s", _target);
+        snprintf(name[1], sizeof(name[1]), "fuzz.%s.kib", _target);
+        uint64_t ns     = _bestInputs ? _bestNs : _ns;
+        uint64_t bytes  = _bestInputs ? _bestBytes : _bytes;
+        uint64_t inputs = _bestInputs ? _bestInputs : _inputs;
+        uint64_t perInput = (ns + inputs / 2) / inputs;
+        uint64_t perKib   = bytes ? (ns * 1024 + bytes / 2) / bytes : 0;
+        Bench::Result results[] = {
+            {name[0], clamp(_inputs), clamp(perInput), "ns"},
+            {name[1], clamp(_inputs), clamp(perKib), "ns"},
+        };
+
+        const char* path = getenv("FUZZ_BENCH_OUT");
+        FILE* out = (path && *path) ? fopen(path, "a") : nullptr;
+        for (const Bench::Result& r : results) {
+            char line[Bench::LINE_SIZE];
+            if (!Bench::format(r, "native", line, sizeof(line))) continue;
+            fprintf(stderr, "%s\n", line);
+            if (out) fprintf(out, "%s\n", line);
+        }
+        if (out) fclose(out);
+    }
+
+private:
+    static uint32_t clamp(uint64_t v) {
+        return v > 0xFFFFFFFFull ? 0xFFFFFFFFu : static_cast<uint32_t>(v);
+    }
+
+    const char* _target;
+    uint64_t    _ns     = 0;
+    uint64_t    _bytes  = 0;
+    uint64_t    _inputs = 0;
+    uint64_t    _lapNs = 0, _lapBytes = 0, _lapInputs = 0;
+    uint64_t    _bestNs = 0, _bestBytes = 0, _bestInputs = 0;
+};
+
+}  // namespace Fuzz
+
+#endif
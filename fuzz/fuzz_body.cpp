@@ -0,0 +1,100 @@
+/**
+ * LED-Panel-ESP12F - Fuzz Target: Response Body
+ *
+ * The body path of a check: BodyDecoder strips the framing, then the
+ * rules Evaluator scans the payload with the body matcher and the JSON
+ * field parser. Input layout:
+ *
+ *   byte 0      bit 0 set = chunked
+ *   bytes 1-2   Content-Length, big-endian; 0xFFFF = until close
+ *   bytes 3..   body bytes as received
+ *
+ * The body is run through whole and a byte at a time, as the probe would
+ * with different socket reads; payload, end of body and verdict must
+ * match, and the decoder must never emit more than it was given.
+ *
+ * Build and run: fuzz/run.sh body
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <vector>
+#include "http_probe.h"
+#include "probe_rules.h"
+#include "fuzz.h"
+
+static const char RULES[] =
+    "status=200-299; body~\"healthy\"; body!~error; json.status=ok; "
+    "json.checks.db!=down; bytes=512";
+
+static Fuzz::Meter meter("body");
+
+namespace {
+
+struct Outcome {
+    std::vector<uint8_t>  payload;
+    bool                  done = false;
+    ProbeRules::Reason    verdict;
+};
+
+const ProbeRules::Table& rules() {
+    static ProbeRules::Table table;
+    static bool compiled = false;
+    if (!compiled) {
+        FUZZ_CHECK(ProbeRules::compile(RULES, table) == ProbeRules::Error::NONE);
+        compiled = true;
+    }
+    return table;
+}
+
+/**
+ * Decode and judge the body, handed over in steps of at most `step` bytes
+ */
+void run(const uint8_t* data, size_t size, int32_t contentLength, bool chunked, size_t step,
+         Outcome& out) {
+    std::vector<uint8_t> rx(data, data + size);   // decode() works in place
+    HttpProbe::BodyDecoder decoder;
+    decoder.reset(contentLength, chunked);
+    ProbeRules::Evaluator eval(rules());
+
+    bool wanted = true;
+    size_t n;
+    for (size_t i = 0; i < size && !decoder.done(); i += n) {
+        n = (size - i < step) ? size - i : step;
+        size_t payload = decoder.decode(rx.data() + i, n);
+        FUZZ_CHECK(payload <= n);
+        out.payload.insert(out.payload.end(), rx.data() + i, rx.data() + i + payload);
+        if (wanted && payload > 0) wanted = eval.body(rx.data() + i, payload);
+        FUZZ_CHECK(eval.bodyBytes() <= rules().bodyLimit);
+    }
+    out.done    = decoder.done();
+    out.verdict = eval.verdict(200, 0);
+}
+
+}  // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    if (size < 3) return 0;
+    bool    chunked = data[0] & 1;
+    int32_t length  = (data[1] << 8) | data[2];
+    if (length == 0xFFFF) length = -1;
+    data += 3;
+    size -= 3;
+
+    Outcome whole, split;
+    meter.run(size, [&] {
+        run(data, size, length, chunked, SIZE_MAX, whole);
+        run(data, size, length, chunked, 1, split);
+    });
+
+    FUZZ_CHECK(whole.payload == split.payload);
+    FUZZ_CHECK(whole.done == split.done);
+    FUZZ_CHECK(whole.verdict == split.verdict);
+    FUZZ_CHECK(whole.payload.size() <= size);
+    if (!chunked) {
+        FUZZ_CHECK(length < 0 || whole.payload.size() <= static_cast<size_t>(length));
+        FUZZ_CHECK(whole.done == (length >= 0 && size >= static_cast<size_t>(length)));
+    }
+    return 0;
+}
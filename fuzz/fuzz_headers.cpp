@@ -0,0 +1,33 @@
+/**
+ * LED-Panel-ESP12F - Fuzz Target: Response Headers
+ *
+ * The input is the header block of a response whose status line is
+ * fixed; a blank line is added so the head always ends. Checks that
+ * Location stays bounded and terminated, Content-Length never goes
+ * negative or wraps, every header line reaches the hook trimmed, and
+ * that splitting the bytes does not change any of it.
+ *
+ * Build and run: fuzz/run.sh headers
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include "parse_response.h"
+
+static Fuzz::Meter meter("headers");
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static const uint8_t STATUS[] = "HTTP/1.1 200 OK\r\n";
+    static const uint8_t END[]    = "\r\n\r\n";
+    const uint8_t* parts[] = {STATUS, data, END};
+    size_t         lens[]  = {sizeof(STATUS) - 1, size, sizeof(END) - 1};
+
+    Fuzz::Head head;
+    meter.run(size, [&] { Fuzz::parseBothWays(parts, lens, 3, head); });
+
+    const HttpProbe::ResponseParser& p = head.parser;
+    FUZZ_CHECK(p.headersDone());
+    FUZZ_CHECK(p.statusCode() == 200);
+    FUZZ_CHECK(head.used <= lens[0] + size + lens[2]);
+    return 0;
+}
@@ -0,0 +1,34 @@
+/**
+ * LED-Panel-ESP12F - Fuzz Target: Status Line
+ *
+ * The input is one status line ("HTTP/1.1 200 OK"); a line end is added
+ * so every input is judged. ResponseParser must either accept it with a
+ * three-digit code or fail, the same way whether the bytes arrive at once
+ * or one by one.
+ *
+ * Build and run: fuzz/run.sh status_line
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "parse_response.h"
+
+static Fuzz::Meter meter("status_line");
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size) {
+    static const uint8_t END[] = "\r\n";
+    const uint8_t* parts[] = {data, END};
+    size_t         lens[]  = {size, sizeof(END) - 1};
+
+    Fuzz::Head head;
+    meter.run(size, [&] { Fuzz::parseBothWays(parts, lens, 2, head); });
+
+    const HttpProbe::ResponseParser& p = head.parser;
+    FUZZ_CHECK(p.phase() != HttpProbe::ResponseParser::Phase::STATUS_LINE);
+    if (!p.failed()) {
+        FUZZ_CHECK(size >= 5 && memcmp(data, "HTTP/", 5) == 0);
+        FUZZ_CHECK(p.statusCode() <= 999);
+    }
+    return 0;
+}
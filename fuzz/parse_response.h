@@ -0,0 +1,97 @@
+/**
+ * LED-Panel-ESP12F - Response Parser Harness
+ *
+ * Runs HttpProbe::ResponseParser over one response head twice, once in a
+ * single feed() and once a byte at a time (the probe reads whatever the
+ * socket has, so any split must parse the same), and checks the
+ * invariants both runs must keep. Used by fuzz_status_line and
+ * fuzz_headers.
+ */
+
+#ifndef PARSE_RESPONSE_H
+#define PARSE_RESPONSE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "http_probe.h"
+#include "fuzz.h"
+
+namespace Fuzz {
+
+using HttpProbe::ResponseParser;
+
+struct Head {
+    ResponseParser parser;
+    size_t         used    = 0;   // Bytes consumed before the body
+    uint32_t       headers = 0;   // Header hook calls
+    uint32_t       names   = 0;   // Sum of name lengths, to compare runs
+};
+
+inline void countHeader(void* ctx, const char* name, const char* value) {
+    Head& head = *static_cast<Head*>(ctx);
+    size_t nameLen  = strlen(name);
+    size_t valueLen = strlen(value);
+    FUZZ_CHECK(nameLen + valueLen < HttpProbe::LINE_MAX);
+    FUZZ_CHECK(strchr(name, ':') == nullptr);
+    FUZZ_CHECK(*value != ' ' && *value != '\t');
+    head.headers++;
+    head.names += static_cast<uint32_t>(nameLen);
+}
+
+/**
+ * Feed the parts in order, each in steps of at most `step` bytes
+ */
+inline void parse(Head& head, const uint8_t* const* parts, const size_t* lens, size_t count,
+                  size_t step) {
+    head.parser.reset();
+    head.parser.setHeaderHook(countHeader, &head);
+    for (size_t p = 0; p < count; p++) {
+        size_t n;
+        for (size_t i = 0; i < lens[p]; i += n) {
+            if (head.parser.headersDone() || head.parser.failed()) return;
+            n = (lens[p] - i < step) ? lens[p] - i : step;
+            size_t used = head.parser.feed(parts[p] + i, n);
+            FUZZ_CHECK(used <= n);
+            head.used += used;
+        }
+    }
+}
+
+inline void checkHead(const Head& head) {
+    const ResponseParser& p = head.parser;
+    FUZZ_CHECK(p.statusCode() >= 0 && p.statusCode() <= 999);
+    FUZZ_CHECK(p.contentLength() >= -1);
+    FUZZ_CHECK(strlen(p.location()) < HttpProbe::LINE_MAX);
+    if (p.phase() == ResponseParser::Phase::STATUS_LINE || p.failed()) {
+        FUZZ_CHECK(p.statusCode() == 0);
+        FUZZ_CHECK(head.headers == 0 && !p.hasLocation());
+    }
+}
+
+/**
+ * Parse the parts whole and byte by byte; both must agree
+ */
+inline void parseBothWays(const uint8_t* const* parts, const size_t* lens, size_t count,
+                          Head& whole) {
+    Head split;
+    whole = Head();
+    parse(whole, parts, lens, count, SIZE_MAX);
+    parse(split, parts, lens, count, 1);
+    checkHead(whole);
+    checkHead(split);
+
+    const ResponseParser& a = whole.parser;
+    const ResponseParser& b = split.parser;
+    FUZZ_CHECK(a.phase() == b.phase());
+    FUZZ_CHECK(a.statusCode() == b.statusCode());
+    FUZZ_CHECK(a.contentLength() == b.contentLength());
+    FUZZ_CHECK(a.chunked() == b.chunked());
+    FUZZ_CHECK(strcmp(a.location(), b.location()) == 0);
+    FUZZ_CHECK(whole.used == split.used);
+    FUZZ_CHECK(whole.headers == split.headers && whole.names == split.names);
+}
+
+}  // namespace Fuzz
+
+#endif
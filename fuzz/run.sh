@@ -0,0 +1,67 @@
+#!/bin/sh
+#
+# LED-Panel-ESP12F - Build and run the parser fuzz targets
+#
+#   fuzz/run.sh TARGET [FLAGS...]      fuzz one target (or "all")
+#   fuzz/run.sh -r TARGET [FLAGS...]   replay the seed corpus FUZZ_REPLAYS times
+#                                      (default 1000) for throughput
+#
+# Targets: status_line, headers, body (fuzz/fuzz_<target>.cpp). With a
+# clang that has libFuzzer, targets are built with
+# -fsanitize=fuzzer,address,undefined and fuzz for FUZZ_TIME seconds
+# (default 60); new inputs go to _fuzz_build/corpus/<target>, the seeds in
+# fuzz/corpus/<target> are never written. Otherwise, or with
+# FUZZ_STANDALONE=1, the target is linked with fuzz/standalone.cpp under
+# address and undefined sanitizers and runs FUZZ_RUNS mutated inputs
+# (default 200000). FLAGS are passed to the fuzzer.
+#
+# Each run prints parser throughput as benchmark result lines; set
+# FUZZ_BENCH_OUT=fuzz.jsonl to collect them and compare two versions with
+# tools/benchcmp.py. Replays (-r) give the comparable numbers: they always
+# use the standalone driver, built at -O2 without sanitizers, and report
+# the fastest pass over the seeds.
+
+set -e
+cd "$(dirname "$0")/.."
+
+replay=0
+if [ "$1" = "-r" ]; then
+    replay=1
+    shift
+fi
+target=$1
+[ -n "$target" ] || { sed -n '5,7p' "$0" | sed 's/^# *//'; exit 2; }
+shift
+
+if [ "$target" = "all" ]; then
+    flag=
+    [ $replay = 1 ] && flag=-r
+    for t in status_line headers body; do
+        "$0" $flag $t "$@"
+    done
+    exit 0
+fi
+[ -f fuzz/fuzz_$target.cpp ] || { echo "unknown target: $target" >&2; exit 2; }
+
+out=_fuzz_build
+bin=$out/fuzz_$target
+mkdir -p $out/corpus/$target
+flags="-std=gnu++17 -g -Wall -Iinclude -Ifuzz"
+sanitize="-O1 -fsanitize=address,undefined -fno-sanitize-recover=all"
+[ $replay = 1 ] && sanitize=-O2
+
+CXX=${CXX:-clang++}
+if [ -z "$FUZZ_STANDALONE" ] && [ $replay = 0 ] && echo 'extern "C" int LLVMFuzzerTestOneInput(const char*, unsigned long) { return 0; }' |
+        $CXX -x c++ -fsanitize=fuzzer - -o $out/.probe 2>/dev/null; then
+    $CXX $flags $sanitize -fsanitize=fuzzer fuzz/fuzz_$target.cpp -o $bin
+    exec $bin -dict=fuzz/http.dict -artifact_prefix=$out/ -max_total_time=${FUZZ_TIME:-60} \
+        $out/corpus/$target fuzz/corpus/$target "$@"
+fi
+
+[ "$CXX" = clang++ ] && ! command -v clang++ >/dev/null && CXX=g++
+$CXX $flags $sanitize fuzz/fuzz_$target.cpp fuzz/standalone.cpp -o $bin
+if [ $replay = 1 ]; then
+    exec $bin -replays=${FUZZ_REPLAYS:-1000} "$@" fuzz/corpus/$target
+fi
+exec $bin -runs=${FUZZ_RUNS:-200000} -artifact_prefix=$out/ "$@" fuzz/corpus/$target \
+    $out/corpus/$target
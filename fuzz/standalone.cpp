@@ -0,0 +1,212 @@
+/**
+ * LED-Panel-ESP12F - Standalone Fuzz Driver
+ *
+ * Stands in for libFuzzer's main() where clang's -fsanitize=fuzzer is not
+ * available (e.g. a gcc-only host): links with one fuzz target and
+ *
+ * - replays every file given, or every file in each directory given
+ *   (the seed corpus, or crash inputs saved by libFuzzer), -replays=N
+ *   times over; each pass is one Fuzz::Meter lap, so throughput is that
+ *   of the fastest pass
+ * - then, with -runs=N, runs N inputs made by mutating corpus entries
+ *   (byte flips, inserts, deletes, repeats and HTTP/JSON tokens); no
+ *   coverage feedback, but with the sanitizers it still finds shallow bugs
+ *
+ *   fuzz_headers [-runs=N] [-replays=N] [-seed=S] [-max_len=N] [-artifact_prefix=DIR/]
+ *                fuzz/corpus/headers
+ *
+ * An input that trips an invariant or a sanitizer is written to
+ * crash-<pid> (after -artifact_prefix=, as with libFuzzer) before the
+ * process dies. Throughput is printed at exit by
+ * the target's Fuzz::Meter (fuzz.h).
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <string>
+#include <vector>
+#include "fuzz.h"
+
+extern "C" int LLVMFuzzerTestOneInput(const uint8_t* data, size_t size);
+
+// Sanitizer reports end in abort(), so the input gets saved
+extern "C" const char* __asan_default_options() { return "abort_on_error=1"; }
+extern "C" const char* __ubsan_default_options() { return "abort_on_error=1:print_stacktrace=1"; }
+
+namespace {
+
+typedef std::vector<uint8_t> Input;
+
+const char* const TOKENS[] = {
+    "\r\n", "\n", ": ", " ", "HTTP/1.1 ", "HTTP/1.0 ", "200", "301 ", "Location: ",
+    "Content-Length: ", "Transfer-Encoding: chunked", "0\r\n\r\n", "ffffffff",
+    "4294967296", "{\"status\":\"ok\"}", "\"checks\":{\"db\":", "\\u0000", "healthy", "error",
+};
+
+const Input* current = nullptr;   // Input being run, saved on a crash
+char crashPath[256];
+
+void onSignal(int sig) {
+    if (current) {
+        int fd = open(crashPath, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        if (fd >= 0) {
+            if (write(fd, current->data(), current->size()) < 0) {}
+            close(fd);
+            fprintf(stderr, "input written to %s\n", crashPath);
+        }
+    }
+    signal(sig, SIG_DFL);
+    raise(sig);
+}
+
+bool readFile(const std::string& path, size_t maxLen, Input& out) {
+    FILE* f = fopen(path.c_str(), "rb");
+    if (!f) return false;
+    out.clear();
+    uint8_t buf[4096];
+    size_t n;
+    while ((n = fread(buf, 1, sizeof(buf), f)) > 0) out.insert(out.end(), buf, buf + n);
+    fclose(f);
+    if (out.size() > maxLen) out.resize(maxLen);
+    return true;
+}
+
+void load(const char* path, size_t maxLen, std::vector<Input>& corpus) {
+    struct stat st;
+    if (stat(path, &st) != 0) {
+        fprintf(stderr, "cannot open %s\n", path);
+        exit(2);
+    }
+    Input input;
+    if (!S_ISDIR(st.st_mode)) {
+        if (readFile(path, maxLen, input)) corpus.push_back(input);
+        return;
+    }
+
+    DIR* dir = opendir(path);
+    std::vector<std::string> names;
+    while (dirent* e = dir ? readdir(dir) : nullptr) {
+        if (e->d_name[0] != '.') names.push_back(e->d_name);
+    }
+    if (dir) closedir(dir);
+    for (const std::string& name : names) {
+        std::string file = std::string(path) + "/" + name;
+        if (stat(file.c_str(), &st) == 0 && S_ISREG(st.st_mode) && readFile(file, maxLen, input)) {
+            corpus.push_back(input);
+        }
+    }
+}
+
+struct Rng {
+    uint64_t s;
+    uint32_t next() {
+        s ^= s << 13;
+        s ^= s >> 7;
+        s ^= s << 17;
+        return static_cast<uint32_t>(s >> 16);
+    }
+    size_t below(size_t n) { return n ? next() % n : 0; }
+};
+
+void mutate(Input& in, Rng& rng, size_t maxLen) {
+    uint32_t edits = 1 + rng.below(4);
+    for (uint32_t e = 0; e < edits; e++) {
+        size_t at = rng.below(in.size() + 1);
+        switch (rng.below(6)) {
+            case 0:   // Flip a bit
+                if (!in.empty()) in[rng.below(in.size())] ^= 1 << rng.below(8);
+                break;
+            case 1:   // Random byte
+                in.insert(in.begin() + at, static_cast<uint8_t>(rng.next()));
+                break;
+            case 2: {  // Delete a run
+                size_t n = 1 + rng.below(8);
+                if (at + n > in.size()) n = in.size() - at;
+                in.erase(in.begin() + at, in.begin() + at + n);
+                break;
+            }
+            case 3: {  // Repeat a run
+                if (in.empty()) break;
+                size_t from = rng.below(in.size());
+                size_t n = 1 + rng.below(in.size() - from);
+                Input run(in.begin() + from, in.begin() + from + n);
+                in.insert(in.begin() + at, run.begin(), run.end());
+                break;
+            }
+            case 4: {  // Token
+                const char* t = TOKENS[rng.below(sizeof(TOKENS) / sizeof(TOKENS[0]))];
+                in.insert(in.begin() + at, t, t + strlen(t));
+                break;
+            }
+            default:   // Digit, for lengths and status codes
+                if (!in.empty()) in[rng.below(in.size())] = '0' + rng.below(10);
+                break;
+        }
+    }
+    if (in.size() > maxLen) in.resize(maxLen);
+}
+
+bool flag(const char* arg, const char* name, unsigned long& value) {
+    size_t n = strlen(name);
+    if (strncmp(arg, name, n) != 0) return false;
+    value = strtoul(arg + n, nullptr, 10);
+    return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+    unsigned long runs = 0, replays = 1, seed = 1, maxLen = 4096;
+    const char* prefix = "";
+    std::vector<Input> corpus;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "-artifact_prefix=", 17) == 0) {
+            prefix = argv[i] + 17;
+            continue;
+        }
+        if (flag(argv[i], "-runs=", runs) || flag(argv[i], "-replays=", replays) ||
+            flag(argv[i], "-seed=", seed) ||
+            flag(argv[i], "-max_len=", maxLen)) {
+            continue;
+        }
+        if (argv[i][0] == '-') {
+            fprintf(stderr, "ignoring %s\n", argv[i]);   // libFuzzer-only flag
+            continue;
+        }
+        load(argv[i], maxLen, corpus);
+    }
+
+    snprintf(crashPath, sizeof(crashPath), "%scrash-%d", prefix, static_cast<int>(getpid()));
+    signal(SIGABRT, onSignal);
+
+    for (unsigned long r = 0; r < replays; r++) {
+        for (const Input& input : corpus) {
+            current = &input;
+            LLVMFuzzerTestOneInput(input.data(), input.size());
+        }
+        if (replays > 1 && Fuzz::Meter::active()) Fuzz::Meter::active()->lap();
+    }
+    fprintf(stderr, "replayed %zu input(s)\n", corpus.size());
+
+    if (runs == 0) return 0;
+    if (corpus.empty()) corpus.push_back(Input());
+
+    Rng rng = {seed ? seed : 1};
+    Input input;
+    for (unsigned long r = 0; r < runs; r++) {
+        input = corpus[rng.below(corpus.size())];
+        mutate(input, rng, maxLen);
+        current = &input;
+        LLVMFuzzerTestOneInput(input.data(), input.size());
+    }
+    fprintf(stderr, "ran %lu mutated input(s)\n", runs);
+    return 0;
+}
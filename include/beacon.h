@@ -0,0 +1,154 @@
+/**
+ * LED-Panel-ESP12F - Status Beacon
+ *
+ * Fixed-size binary packet a board multicasts after each check, so peers
+ * and wall displays can follow its results without probing themselves.
+ *
+ * Layout (SIZE bytes, little-endian):
+ *
+ *   0  magic      "LP"
+ *   2  version    VERSION
+ *   3  flags      FLAG_*
+ *   4  boardId    Chip id of the sender
+ *   8  targetId   targetId(SITE_URL), so boards on the same site match
+ *  12  seq        Incremented per beacon sent
+ *  16  httpCode   int16, HTTP status or HttpProbe error
+ *  18  term       Election term (see election.h); 0 if unused
+ *  20  latencyMs
+ *  24  ageMs      How old the result was when sent
+ *  28  tag        SipHash-2-4 of bytes 0..27 under the fleet key
+ *
+ * The fleet key is the shared PUSH_KEY. Any host on the LAN can send to
+ * the group, so a packet without a valid tag is dropped before any field
+ * is read: a forged prober claim could otherwise silence every board's
+ * checks and feed them a made-up result.
+ *
+ * Encoding and decoding work on byte arrays; nothing is allocated and the
+ * layout does not depend on struct packing.
+ */
+
+#ifndef BEACON_H
+#define BEACON_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "siphash.h"
+
+namespace Beacon {
+
+constexpr uint8_t MAGIC0  = 'L';
+constexpr uint8_t MAGIC1  = 'P';
+constexpr uint8_t VERSION = 2;
+constexpr size_t  SIZE    = 36;
+
+constexpr uint8_t FLAG_UP     = 0x01;   // Target was up at the last check
+constexpr uint8_t FLAG_PROBER = 0x02;   // Sender probes the target itself
+constexpr uint8_t FLAG_VALID  = 0x04;   // Carries a check result (not just presence)
+
+struct Status {
+    uint32_t boardId;
+    uint32_t targetId;
+    uint32_t seq;
+    uint8_t  flags;
+    int16_t  httpCode;
+    uint16_t term;
+    uint32_t latencyMs;
+    uint32_t ageMs;
+
+    bool up()     const { return flags & FLAG_UP; }
+    bool prober() const { return flags & FLAG_PROBER; }
+    bool valid()  const { return flags & FLAG_VALID; }
+};
+
+/**
+ * 32-bit FNV-1a of the target URL
+ */
+inline uint32_t targetId(const char* url) {
+    uint32_t h = 2166136261u;
+    for (; *url; ++url) {
+        h ^= static_cast<uint8_t>(*url);
+        h *= 16777619u;
+    }
+    return h;
+}
+
+namespace detail {
+
+inline void put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void put32(uint8_t* p, uint32_t v) {
+    put16(p, static_cast<uint16_t>(v));
+    put16(p + 2, static_cast<uint16_t>(v >> 16));
+}
+
+inline uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t get32(const uint8_t* p) {
+    return get16(p) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+}
+
+constexpr size_t SIGNED = 28;   // Bytes covered by the tag
+
+inline uint64_t tag(const uint8_t key[SipHash::KEY_SIZE], const uint8_t* data) {
+    return SipHash::hash(key, data, SIGNED);
+}
+
+}  // namespace detail
+
+inline void encode(const Status& s, const uint8_t key[SipHash::KEY_SIZE], uint8_t out[SIZE]) {
+    out[0] = MAGIC0;
+    out[1] = MAGIC1;
+    out[2] = VERSION;
+    out[3] = s.flags;
+    detail::put32(out + 4,  s.boardId);
+    detail::put32(out + 8,  s.targetId);
+    detail::put32(out + 12, s.seq);
+    detail::put16(out + 16, static_cast<uint16_t>(s.httpCode));
+    detail::put16(out + 18, s.term);
+    detail::put32(out + 20, s.latencyMs);
+    detail::put32(out + 24, s.ageMs);
+    uint64_t t = detail::tag(key, out);
+    detail::put32(out + 28, static_cast<uint32_t>(t));
+    detail::put32(out + 32, static_cast<uint32_t>(t >> 32));
+}
+
+/**
+ * Validate and decode; false for foreign, truncated, corrupt or forged
+ * packets (and for packets from a fleet with another key)
+ */
+inline bool decode(const uint8_t* data, size_t len, const uint8_t key[SipHash::KEY_SIZE], Status& s) {
+    if (len != SIZE || data[0] != MAGIC0 || data[1] != MAGIC1 || data[2] != VERSION) {
+        return false;
+    }
+    uint64_t given = detail::get32(data + 28) | (static_cast<uint64_t>(detail::get32(data + 32)) << 32);
+    uint64_t diff  = given ^ detail::tag(key, data);   // Compare without an early exit
+    uint8_t  acc   = 0;
+    for (int i = 0; i < 8; i++) acc |= static_cast<uint8_t>(diff >> (8 * i));
+    if (acc != 0) return false;
+
+    s.flags     = data[3];
+    s.boardId   = detail::get32(data + 4);
+    s.targetId  = detail::get32(data + 8);
+    s.seq       = detail::get32(data + 12);
+    s.httpCode  = static_cast<int16_t>(detail::get16(data + 16));
+    s.term      = detail::get16(data + 18);
+    s.latencyMs = detail::get32(data + 20);
+    s.ageMs     = detail::get32(data + 24);
+    return true;
+}
+
+/**
+ * True if seq a is newer than b (serial number arithmetic, wraps)
+ */
+inline bool seqNewer(uint32_t a, uint32_t b) {
+    return static_cast<int32_t>(a - b) > 0;
+}
+
+}  // namespace Beacon
+
+#endif
@@ -0,0 +1,88 @@
+/**
+ * LED-Panel-ESP12F - Micro-benchmark Runner
+ *
+ * Times short hot paths the same way on the build host and on the board,
+ * and formats each result as one JSON line so runs of different firmware
+ * versions can be compared (tools/benchcmp.py).
+ *
+ * - measure() repeats the operation in growing batches until one batch
+ *   takes at least minUs, so a coarse clock (micros() on the board) still
+ *   gives ns resolution; then it times ROUNDS batches of that size and
+ *   reports the fastest, which filters out interrupts and other tasks
+ * - Plain quantities (memory, a single TLS handshake) are reported with
+ *   value() in their own unit
+ * - Clock must provide: uint32_t us(); Bench::Clock (bench_clock.h) is
+ *   micros() on the board and the steady clock on the host
+ *
+ *   Bench::Result r = Bench::measure("probe.fetch", clock, 20000, [&] { ... });
+ *   Bench::format(r, "native", line, sizeof(line));
+ *   // {"target":"native","bench":"probe.fetch","iterations":8192,"value":1840,"unit":"ns"}
+ */
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+
+namespace Bench {
+
+constexpr size_t   LINE_SIZE = 128;   // Enough for any result line
+constexpr uint32_t BATCH_MAX = 1u << 24;
+constexpr uint8_t  ROUNDS    = 5;
+
+struct Result {
+    const char* name;
+    uint32_t    iterations;   // Operations timed; 0 for a plain value
+    uint32_t    value;
+    const char* unit;         // "ns" per operation, "us", "bytes"
+};
+
+template <class Clock, class Fn>
+uint32_t timeBatch(Clock& clock, uint32_t batch, Fn& fn) {
+    uint32_t start = clock.us();
+    for (uint32_t i = 0; i < batch; i++) {
+        fn();
+    }
+    return clock.us() - start;
+}
+
+/**
+ * Time of fn() in ns: the best of ROUNDS batches lasting at least minUs
+ */
+template <class Clock, class Fn>
+Result measure(const char* name, Clock& clock, uint32_t minUs, Fn&& fn) {
+    uint32_t batch = 1;
+    uint32_t best  = timeBatch(clock, batch, fn);
+    while (best < minUs && batch < BATCH_MAX) {
+        batch *= (best < minUs / 16) ? 16 : 2;   // Close in quickly on fast operations
+        best   = timeBatch(clock, batch, fn);
+    }
+    for (uint8_t r = 1; r < ROUNDS; r++) {
+        uint32_t us = timeBatch(clock, batch, fn);
+        if (us < best) best = us;
+    }
+
+    uint64_t ns = (1000ull * best + batch / 2) / batch;
+    return {name, batch, static_cast<uint32_t>(ns > 0xFFFFFFFFull ? 0xFFFFFFFFull : ns), "ns"};
+}
+
+inline Result value(const char* name, uint32_t v, const char* unit) {
+    return {name, 0, v, unit};
+}
+
+/**
+ * One JSON line (no newline); returns its length, or 0 if it does not fit
+ */
+inline size_t format(const Result& r, const char* target, char* buf, size_t cap) {
+    int n = snprintf(buf, cap,
+                     "{\"target\":\"%s\",\"bench\":\"%s\",\"iterations\":%lu,\"value\":%lu,\"unit\":\"%s\"}",
+                     target, r.name, static_cast<unsigned long>(r.iterations),
+                     static_cast<unsigned long>(r.value), r.unit);
+    return (n > 0 && static_cast<size_t>(n) < cap) ? static_cast<size_t>(n) : 0;
+}
+
+}  // namespace Bench
+
+#endif
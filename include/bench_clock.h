@@ -0,0 +1,43 @@
+/**
+ * LED-Panel-ESP12F - Benchmark Clock
+ *
+ * Microsecond clock for Bench::measure() (include/bench.h) and for the
+ * speed checks in the tests: micros() on the board, the host's steady
+ * clock in native builds. Wraps like micros(); only differences count.
+ *
+ *   uint32_t start = Bench::nowUs();
+ *   ...
+ *   uint32_t us = Bench::nowUs() - start;
+ */
+
+#ifndef BENCH_CLOCK_H
+#define BENCH_CLOCK_H
+
+#include <stdint.h>
+#ifdef ARDUINO
+#include <Arduino.h>
+#else
+#include <chrono>
+#endif
+
+namespace Bench {
+
+inline uint32_t nowUs() {
+#ifdef ARDUINO
+    return micros();
+#else
+    using namespace std::chrono;
+    return static_cast<uint32_t>(duration_cast<microseconds>(steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/**
+ * Clock for measure()
+ */
+struct Clock {
+    uint32_t us() { return nowUs(); }
+};
+
+}  // namespace Bench
+
+#endif
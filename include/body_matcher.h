@@ -0,0 +1,154 @@
+/**
+ * LED-Panel-ESP12F - Streaming Multi-Pattern Matcher
+ *
+ * Aho-Corasick automaton for finding a few marker strings in a response
+ * body that is far larger than RAM, as it arrives in small chunks.
+ *
+ * - Up to MaxPatterns patterns (8 at most, one bit each in a mask) share
+ *   one trie of at most MaxStates nodes, 5 bytes per node
+ * - Nodes store first-child / next-sibling links instead of a 256-entry
+ *   row, so the whole automaton fits in a few hundred bytes
+ * - Each body byte costs one transition (amortised), however many
+ *   patterns there are; matches across chunk boundaries are found because
+ *   the scan position lives in a Scan, not in the data
+ * - feed() stops as soon as every pattern has been seen
+ *
+ *   Automaton<4, 129> a;
+ *   a.add("healthy", 7);
+ *   a.build();
+ *   BodyMatcher::Scan s;
+ *   a.feed(s, chunk, len);   // Repeat per chunk; s.found is the mask
+ */
+
+#ifndef BODY_MATCHER_H
+#define BODY_MATCHER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace BodyMatcher {
+
+/**
+ * Position of one scan through a body
+ */
+struct Scan {
+    uint8_t  state = 0;
+    uint8_t  found = 0;    // Bit i = pattern i seen
+    uint32_t bytes = 0;    // Bytes consumed so far
+};
+
+template <uint8_t MaxPatterns, uint16_t MaxStates>
+class Automaton {
+    static_assert(MaxPatterns >= 1 && MaxPatterns <= 8, "pattern mask is 8 bits");
+    static_assert(MaxStates >= 2 && MaxStates <= 256, "node links are 8 bits");
+
+public:
+    Automaton() { clear(); }
+
+    void clear() {
+        _nodes[0] = Node();
+        _nodeCount    = 1;
+        _patternCount = 0;
+    }
+
+    /**
+     * Add pattern number patternCount(); false if it is empty or does not fit
+     */
+    bool add(const char* text, size_t len) {
+        if (len == 0 || _patternCount == MaxPatterns) return false;
+
+        // Follow the shared prefix first, so a pattern that does not fit
+        // leaves the trie untouched
+        uint8_t s = 0;
+        size_t  i = 0;
+        for (uint8_t next; i < len && (next = child(s, static_cast<uint8_t>(text[i]))); i++) {
+            s = next;
+        }
+        if (_nodeCount + (len - i) > MaxStates) return false;
+
+        for (; i < len; i++) {
+            uint8_t next = static_cast<uint8_t>(_nodeCount++);
+            _nodes[next]      = Node();
+            _nodes[next].ch   = static_cast<uint8_t>(text[i]);
+            _nodes[next].next = _nodes[s].child;
+            _nodes[s].child   = next;
+            s = next;
+        }
+        _nodes[s].out |= static_cast<uint8_t>(1 << _patternCount++);
+        return true;
+    }
+
+    /**
+     * Compute failure links; call once after the last add()
+     */
+    void build() {
+        uint8_t queue[MaxStates];
+        size_t  head = 0, tail = 0;
+
+        for (uint8_t v = _nodes[0].child; v; v = _nodes[v].next) {
+            _nodes[v].fail = 0;
+            queue[tail++] = v;
+        }
+        while (head < tail) {
+            uint8_t u = queue[head++];
+            for (uint8_t v = _nodes[u].child; v; v = _nodes[v].next) {
+                _nodes[v].fail = step(_nodes[u].fail, _nodes[v].ch);
+                _nodes[v].out |= _nodes[_nodes[v].fail].out;
+                queue[tail++] = v;
+            }
+        }
+    }
+
+    /**
+     * Scan len bytes; stops early once every pattern is found.
+     * Returns the number of bytes consumed.
+     */
+    size_t feed(Scan& scan, const uint8_t* data, size_t len) const {
+        const uint8_t all = allMask();
+        size_t i = 0;
+        for (; i < len && scan.found != all; i++) {
+            scan.state  = step(scan.state, data[i]);
+            scan.found |= _nodes[scan.state].out;
+        }
+        scan.bytes += static_cast<uint32_t>(i);
+        return i;
+    }
+
+    bool done(const Scan& scan) const { return scan.found == allMask(); }
+
+    uint8_t  patternCount() const { return _patternCount; }
+    uint16_t stateCount()   const { return _nodeCount; }
+    uint8_t  allMask()      const { return static_cast<uint8_t>((1u << _patternCount) - 1); }
+
+private:
+    struct Node {
+        uint8_t ch    = 0;    // Edge label from the parent
+        uint8_t child = 0;    // First child; 0 = none (the root is never a child)
+        uint8_t next  = 0;    // Next sibling
+        uint8_t fail  = 0;
+        uint8_t out   = 0;    // Patterns ending here, including via fail links
+    };
+
+    uint8_t child(uint8_t s, uint8_t c) const {
+        for (uint8_t v = _nodes[s].child; v; v = _nodes[v].next) {
+            if (_nodes[v].ch == c) return v;
+        }
+        return 0;
+    }
+
+    uint8_t step(uint8_t s, uint8_t c) const {
+        for (;;) {
+            uint8_t v = child(s, c);
+            if (v || s == 0) return v;
+            s = _nodes[s].fail;
+        }
+    }
+
+    Node     _nodes[MaxStates];
+    uint16_t _nodeCount    = 1;
+    uint8_t  _patternCount = 0;
+};
+
+}  // namespace BodyMatcher
+
+#endif
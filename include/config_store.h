@@ -0,0 +1,231 @@
+/**
+ * LED-Panel-ESP12F - Binary Configuration Record
+ *
+ * Versioned, CRC-protected settings file (/config.bin on LittleFS) that
+ * overrides the compiled-in defaults from config.h without a reflash.
+ *
+ * Layout (little-endian):
+ *
+ *   0  magic            "LPCF"
+ *   4  version          VERSION
+ *   5  flags            Reserved, 0
+ *   6  length           Total record length in bytes
+ *   8  crc              CRC-32 of bytes 12..length-1
+ *  12  checkIntervalMs
+ *  16  httpTimeoutMs
+ *  20  reconnectMs      WiFi reconnect attempt interval
+ *  24  intensity        0-15
+ *  25  reserved
+ *  26  scrollSpeed      ms per column
+ *  28  ssid             Offset of a NUL-terminated string, 0 = default
+ *  30  pass             "
+ *  32  siteUrl          "
+ *  34  rules            " (probe rules, see probe_rules.h)
+ *  36  strings...
+ *
+ * A numeric field of 0 also means "keep the default". Config is a view
+ * over the caller's buffer: strings are returned as pointers into it, so
+ * nothing is copied and the buffer must outlive the view. Records are
+ * produced on the host by tools/mkconfig.py, or by build() on the board.
+ */
+
+#ifndef CONFIG_STORE_H
+#define CONFIG_STORE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "crc32.h"
+
+namespace ConfigStore {
+
+constexpr uint8_t  VERSION     = 1;
+constexpr size_t   HEADER_SIZE = 36;
+constexpr size_t   RECORD_MAX  = 384;
+constexpr uint32_t CHECK_MIN   = 5000;    // Shortest allowed check interval
+constexpr uint32_t TIMEOUT_MIN = 500;
+
+enum class Error : uint8_t {
+    NONE = 0,
+    TOO_SHORT,
+    BAD_MAGIC,
+    BAD_VERSION,
+    BAD_LENGTH,
+    BAD_CRC,
+    BAD_STRING,
+    BAD_VALUE,
+    COUNT
+};
+
+inline const char* errorName(Error e) {
+    static const char* const NAMES[] = {
+        "none", "too_short", "bad_magic", "bad_version", "bad_length", "bad_crc",
+        "bad_string", "bad_value"
+    };
+    uint8_t i = static_cast<uint8_t>(e);
+    return (i < static_cast<uint8_t>(Error::COUNT)) ? NAMES[i] : "unknown";
+}
+
+namespace detail {
+
+inline uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t get32(const uint8_t* p) {
+    return get16(p) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+}
+
+inline void put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void put32(uint8_t* p, uint32_t v) {
+    put16(p, static_cast<uint16_t>(v));
+    put16(p + 2, static_cast<uint16_t>(v >> 16));
+}
+
+}  // namespace detail
+
+/**
+ * Bytes needed by storedCrc()
+ */
+constexpr size_t PEEK_SIZE = 12;
+
+/**
+ * CRC field of a record header; lets a poller skip unchanged files
+ * after reading only PEEK_SIZE bytes
+ */
+inline uint32_t storedCrc(const uint8_t* header) {
+    return detail::get32(header + 8);
+}
+
+/**
+ * Settings as plain values; strings may be nullptr (= default)
+ */
+struct Values {
+    uint32_t    checkIntervalMs;
+    uint32_t    httpTimeoutMs;
+    uint32_t    reconnectMs;
+    uint8_t     intensity;
+    uint16_t    scrollSpeed;
+    const char* ssid;
+    const char* pass;
+    const char* siteUrl;
+    const char* rules;
+};
+
+/**
+ * Validated view over a record
+ */
+class Config {
+public:
+    /**
+     * Check a record; on success the accessors read from data
+     */
+    Error parse(const uint8_t* data, size_t len) {
+        _data = nullptr;
+        if (len < HEADER_SIZE)               return Error::TOO_SHORT;
+        if (memcmp(data, "LPCF", 4) != 0)    return Error::BAD_MAGIC;
+        if (data[4] != VERSION)              return Error::BAD_VERSION;
+
+        size_t length = detail::get16(data + 6);
+        if (length < HEADER_SIZE || length > len || length > RECORD_MAX) return Error::BAD_LENGTH;
+        if (storedCrc(data) != Crc::crc32(data + 12, length - 12)) return Error::BAD_CRC;
+
+        for (size_t field = 28; field <= 34; field += 2) {
+            if (!validString(data, length, detail::get16(data + field))) return Error::BAD_STRING;
+        }
+
+        uint32_t check   = detail::get32(data + 12);
+        uint32_t timeout = detail::get32(data + 16);
+        if ((check && check < CHECK_MIN) || (timeout && timeout < TIMEOUT_MIN) ||
+            data[24] > 15) {
+            return Error::BAD_VALUE;
+        }
+
+        _data = data;
+        _crc  = storedCrc(data);
+        return Error::NONE;
+    }
+
+    bool     valid()           const { return _data != nullptr; }
+    uint32_t crc()             const { return _crc; }
+    uint32_t checkIntervalMs() const { return detail::get32(_data + 12); }
+    uint32_t httpTimeoutMs()   const { return detail::get32(_data + 16); }
+    uint32_t reconnectMs()     const { return detail::get32(_data + 20); }
+    uint8_t  intensity()       const { return _data[24]; }
+    uint16_t scrollSpeed()     const { return detail::get16(_data + 26); }
+    const char* ssid()         const { return string(28); }
+    const char* pass()         const { return string(30); }
+    const char* siteUrl()      const { return string(32); }
+    const char* rules()        const { return string(34); }
+
+    /**
+     * Overlay the set fields onto v (unset ones keep v's value)
+     */
+    void applyTo(Values& v) const {
+        if (checkIntervalMs()) v.checkIntervalMs = checkIntervalMs();
+        if (httpTimeoutMs())   v.httpTimeoutMs   = httpTimeoutMs();
+        if (reconnectMs())     v.reconnectMs     = reconnectMs();
+        if (intensity())       v.intensity       = intensity();
+        if (scrollSpeed())     v.scrollSpeed     = scrollSpeed();
+        if (ssid())            v.ssid            = ssid();
+        if (pass())            v.pass            = pass();
+        if (siteUrl())         v.siteUrl         = siteUrl();
+        if (rules())           v.rules           = rules();
+    }
+
+private:
+    static bool validString(const uint8_t* data, size_t length, uint16_t offset) {
+        if (offset == 0) return true;
+        if (offset < HEADER_SIZE || offset >= length) return false;
+        return memchr(data + offset, '\0', length - offset) != nullptr;
+    }
+
+    const char* string(size_t field) const {
+        uint16_t offset = detail::get16(_data + field);
+        return offset ? reinterpret_cast<const char*>(_data + offset) : nullptr;
+    }
+
+    const uint8_t* _data = nullptr;
+    uint32_t       _crc  = 0;
+};
+
+/**
+ * Serialise values into out; returns the record length, 0 if too long
+ *
+ * An intensity of 0 cannot be stored (it means "default").
+ */
+inline size_t build(const Values& v, uint8_t* out, size_t cap) {
+    if (cap > RECORD_MAX) cap = RECORD_MAX;
+    if (cap < HEADER_SIZE) return 0;
+    memset(out, 0, HEADER_SIZE);
+
+    size_t pos = HEADER_SIZE;
+    const char* strings[] = {v.ssid, v.pass, v.siteUrl, v.rules};
+    for (size_t i = 0; i < 4; i++) {
+        if (!strings[i]) continue;
+        size_t n = strlen(strings[i]) + 1;
+        if (pos + n > cap) return 0;
+        memcpy(out + pos, strings[i], n);
+        detail::put16(out + 28 + 2 * i, static_cast<uint16_t>(pos));
+        pos += n;
+    }
+
+    memcpy(out, "LPCF", 4);
+    out[4] = VERSION;
+    detail::put16(out + 6, static_cast<uint16_t>(pos));
+    detail::put32(out + 12, v.checkIntervalMs);
+    detail::put32(out + 16, v.httpTimeoutMs);
+    detail::put32(out + 20, v.reconnectMs);
+    out[24] = v.intensity;
+    detail::put16(out + 26, v.scrollSpeed);
+    detail::put32(out + 8, Crc::crc32(out + 12, pos - 12));
+    return pos;
+}
+
+}  // namespace ConfigStore
+
+#endif
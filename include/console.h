@@ -0,0 +1,175 @@
+/**
+ * LED-Panel-ESP12F - Serial Command Console
+ *
+ * Line-based commands on the serial port, e.g. "interval 60000".
+ *
+ * - LineBuffer collects bytes as they arrive (CR, LF or CRLF ends a line,
+ *   backspace edits); an overlong line is dropped whole, never run cut off
+ * - split() tokenizes the line in place; handlers get argc/argv pointing
+ *   into the buffer
+ * - dispatch() looks the first word up in a command table and checks the
+ *   argument count before calling the handler
+ *
+ * Nothing here reads the port or blocks; the caller feeds whatever bytes
+ * are available each loop pass.
+ */
+
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace Console {
+
+constexpr size_t  LINE_MAX = 64;
+constexpr uint8_t ARGS_MAX = 4;     // Command name included
+
+enum class Result : uint8_t {
+    OK = 0,
+    EMPTY,        // Blank line
+    UNKNOWN,      // No such command
+    BAD_ARGS,     // Wrong count, or rejected by the handler
+    COUNT
+};
+
+inline const char* resultName(Result r) {
+    static const char* const NAMES[] = {"ok", "empty", "unknown", "bad_args"};
+    uint8_t i = static_cast<uint8_t>(r);
+    return (i < static_cast<uint8_t>(Result::COUNT)) ? NAMES[i] : "unknown";
+}
+
+/**
+ * Incremental line assembly in a fixed buffer
+ */
+class LineBuffer {
+public:
+    /**
+     * Feed one byte; true when a complete line is ready in line()
+     *
+     * The line stays valid until the next feed().
+     */
+    bool feed(char c) {
+        if (_ready) {
+            _len   = 0;
+            _ready = false;
+        }
+
+        if (c == '\r' || c == '\n') {
+            // CRLF: the LF after a CR ends nothing
+            bool pairedLf = (c == '\n' && _lastCr);
+            _lastCr = (c == '\r');
+            if (pairedLf) return false;
+
+            if (_overflow) {
+                _overflow = false;
+                _len = 0;
+                return false;
+            }
+            _line[_len] = '\0';
+            _ready = true;
+            return true;
+        }
+        _lastCr = false;
+
+        if (c == '\b' || c == 0x7F) {
+            if (_len > 0 && !_overflow) _len--;
+            return false;
+        }
+        if (_overflow) return false;
+        if (_len >= LINE_MAX - 1) {
+            _overflow = true;
+            _overflows++;
+            return false;
+        }
+        _line[_len++] = c;
+        return false;
+    }
+
+    char*    line()            { return _line; }
+    size_t   length()    const { return _len; }
+    uint32_t overflows() const { return _overflows; }
+
+private:
+    char     _line[LINE_MAX] = {};
+    size_t   _len       = 0;
+    bool     _ready     = false;
+    bool     _overflow  = false;
+    bool     _lastCr    = false;
+    uint32_t _overflows = 0;
+};
+
+/**
+ * Split line on spaces and tabs, in place; returns the word count, or
+ * max + 1 if there are more words than slots
+ */
+inline uint8_t split(char* line, char* argv[], uint8_t max) {
+    uint8_t argc = 0;
+    char* p = line;
+    while (*p) {
+        while (*p == ' ' || *p == '\t') *p++ = '\0';
+        if (!*p) break;
+        if (argc == max) return max + 1;   // More words than slots
+        argv[argc++] = p;
+        while (*p && *p != ' ' && *p != '\t') p++;
+    }
+    return argc;
+}
+
+/**
+ * Unsigned decimal; false if empty, not a number or too big
+ */
+inline bool parseUint(const char* s, uint32_t& out) {
+    if (!*s) return false;
+    uint64_t v = 0;
+    for (; *s; ++s) {
+        if (*s < '0' || *s > '9') return false;
+        v = v * 10 + (*s - '0');
+        if (v > UINT32_MAX) return false;
+    }
+    out = static_cast<uint32_t>(v);
+    return true;
+}
+
+/**
+ * Handler for argv[1..argc-1]; return false for a usage error
+ */
+typedef bool (*Handler)(uint8_t argc, char** argv);
+
+struct Command {
+    const char* name;
+    const char* usage;      // Arguments, for help output
+    uint8_t     minArgs;    // Not counting the name
+    uint8_t     maxArgs;
+    Handler     run;
+};
+
+/**
+ * Run the command on line (modified in place); matched is set to the
+ * table entry, or nullptr, so the caller can print its usage
+ */
+inline Result dispatch(const Command* commands, size_t count, char* line,
+                       const Command** matched = nullptr) {
+    if (matched) *matched = nullptr;
+
+    char*   argv[ARGS_MAX];
+    uint8_t argc = split(line, argv, ARGS_MAX);
+    if (argc == 0) return Result::EMPTY;
+
+    const Command* cmd = nullptr;
+    for (size_t i = 0; i < count && !cmd; i++) {
+        if (strcmp(argv[0], commands[i].name) == 0) cmd = &commands[i];
+    }
+    if (!cmd) return Result::UNKNOWN;
+    if (matched) *matched = cmd;
+
+    if (argc > ARGS_MAX) return Result::BAD_ARGS;
+    uint8_t args = argc - 1;
+    if (args < cmd->minArgs || args > cmd->maxArgs) return Result::BAD_ARGS;
+    return cmd->run(argc, argv) ? Result::OK : Result::BAD_ARGS;
+}
+
+}  // namespace Console
+
+#endif
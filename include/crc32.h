@@ -0,0 +1,32 @@
+/**
+ * LED-Panel-ESP12F - CRC-32
+ *
+ * IEEE 802.3 CRC-32, bitwise. Only used on small records and packets,
+ * so the 1 KB lookup table is not worth the RAM.
+ */
+
+#ifndef CRC32_H
+#define CRC32_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Crc {
+
+/**
+ * CRC of data, optionally continuing from a previous result
+ */
+inline uint32_t crc32(const uint8_t* data, size_t len, uint32_t crc = 0) {
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & (0u - (crc & 1u)));
+        }
+    }
+    return ~crc;
+}
+
+}  // namespace Crc
+
+#endif
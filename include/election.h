@@ -0,0 +1,136 @@
+/**
+ * LED-Panel-ESP12F - Prober Election
+ *
+ * Picks one board per target to run the site check; the others mirror
+ * its results from beacons. Total probe load on the site is one check
+ * per CHECK_INTERVAL, however many boards watch it.
+ *
+ * Every board beacons at least every heartbeat. A board is live while a
+ * beacon from it is younger than the lease.
+ *
+ * - A live board claiming FLAG_PROBER is the incumbent; the best claim
+ *   wins (newer term, then lower board id) and any other prober steps
+ *   down when it hears it
+ * - Without a live incumbent, the lowest live board id takes over with
+ *   term = highest term seen + 1; everyone else keeps waiting
+ * - A new board only listens for the first lease, and never preempts a
+ *   working incumbent, so joins do not cause churn
+ *
+ * Failover after the leader goes silent takes at most one lease plus
+ * one heartbeat. A board that has not joined the beacon group (join
+ * failed, or a network that drops multicast) can neither hear nor be
+ * heard by the fleet, so it probes for itself; see shouldProbe().
+ */
+
+#ifndef ELECTION_H
+#define ELECTION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "beacon.h"
+#include "fleet_table.h"
+
+class Election {
+public:
+    enum class Role : uint8_t { LISTENING, FOLLOWER, LEADER };
+
+    void begin(uint32_t selfId, uint32_t targetId, uint32_t leaseMs, uint32_t now) {
+        *this = Election();
+        _self    = selfId;
+        _target  = targetId;
+        _leaseMs = leaseMs;
+        _started = now;
+    }
+
+    /**
+     * Re-evaluate from the fleet table; returns true if the role changed
+     */
+    template <size_t N>
+    bool update(const FleetTable<N>& fleet, uint32_t now) {
+        uint16_t maxTerm    = _term;
+        uint32_t lowestLive = _self;
+        const Beacon::Status* incumbent = nullptr;
+
+        for (size_t i = 0; i < fleet.count(); i++) {
+            const typename FleetTable<N>::Entry& e = fleet.at(i);
+            if (e.status.targetId != _target || now - e.heardAt > _leaseMs) continue;
+
+            if (termNewer(e.status.term, maxTerm)) maxTerm = e.status.term;
+            if (e.status.boardId < lowestLive) lowestLive = e.status.boardId;
+            if (e.status.prober() && (!incumbent || outranks(e.status, *incumbent))) {
+                incumbent = &e.status;
+            }
+        }
+
+        Role previous = _role;
+
+        if (_role == Role::LEADER) {
+            if (incumbent && claimBeats(incumbent->term, incumbent->boardId, _term, _self)) {
+                _role   = Role::FOLLOWER;
+                _leader = incumbent->boardId;
+                _term   = incumbent->term;
+            }
+        } else if (incumbent) {
+            _role   = Role::FOLLOWER;
+            _leader = incumbent->boardId;
+            _term   = incumbent->term;
+        } else if (now - _started < _leaseMs) {
+            _role   = Role::LISTENING;
+            _leader = 0;
+        } else if (lowestLive == _self) {
+            _role   = Role::LEADER;
+            _leader = _self;
+            _term   = static_cast<uint16_t>(maxTerm + 1);
+        } else {
+            _role   = Role::FOLLOWER;   // Waiting for a lower id to take over
+            _leader = 0;
+        }
+
+        if (_role != previous) _changes++;
+        return _role != previous;
+    }
+
+    Role     role()     const { return _role; }
+    bool     isLeader() const { return _role == Role::LEADER; }
+    uint16_t term()     const { return _term; }
+    uint32_t leaderId() const { return _leader; }     // 0 = none yet
+    uint32_t changes()  const { return _changes; }
+
+    /**
+     * True if this board runs the site check: the elected prober, or any
+     * board outside the beacon group, which is alone as far as it knows
+     */
+    bool shouldProbe(bool joined) const { return !joined || isLeader(); }
+
+    /**
+     * True if `a` is newer than `b` (wrapping 16-bit terms)
+     */
+    static bool termNewer(uint16_t a, uint16_t b) {
+        return static_cast<int16_t>(a - b) > 0;
+    }
+
+    static const char* roleName(Role r) {
+        static const char* const NAMES[] = {"listening", "follower", "leader"};
+        return NAMES[static_cast<uint8_t>(r)];
+    }
+
+private:
+    static bool claimBeats(uint16_t termA, uint32_t idA, uint16_t termB, uint32_t idB) {
+        return termNewer(termA, termB) || (termA == termB && idA < idB);
+    }
+
+    static bool outranks(const Beacon::Status& a, const Beacon::Status& b) {
+        return claimBeats(a.term, a.boardId, b.term, b.boardId);
+    }
+
+    uint32_t _self    = 0;
+    uint32_t _target  = 0;
+    uint32_t _leaseMs = 0;
+    uint32_t _started = 0;
+    Role     _role    = Role::LISTENING;
+    uint16_t _term    = 0;
+    uint32_t _leader  = 0;
+    uint32_t _changes = 0;
+};
+
+#endif
@@ -0,0 +1,296 @@
+/**
+ * LED-Panel-ESP12F - Flash Event Log
+ *
+ * Append-only log of fixed-size event records (status changes, probe
+ * failures, WiFi loss, resets), kept across reboots so an overnight flap
+ * can be reconstructed in the morning.
+ *
+ * - Storage is SEGMENTS append-only segments used as a ring: records go
+ *   into the newest segment until it is full, then the oldest segment is
+ *   erased and reused. Every segment is erased equally often, and the
+ *   log always holds the most recent (SEGMENTS - 1) to SEGMENTS
+ *   segments' worth of events.
+ * - Each segment starts with a header holding a sequence number; the
+ *   newest segment is found by comparing them at begin()
+ * - Records are collected in RAM and written BATCH at a time by flush(),
+ *   so flash sees one write per batch rather than per event
+ * - A segment whose length is not a whole number of records (power cut
+ *   mid-write) is closed and the next append moves on
+ *
+ * Storage provides, per segment number:
+ *   size_t size(uint8_t seg)
+ *   size_t read(uint8_t seg, size_t offset, uint8_t* buf, size_t len)
+ *   bool   append(uint8_t seg, const uint8_t* buf, size_t len)
+ *   bool   erase(uint8_t seg)
+ *
+ * Record layout (16 bytes, little-endian; decoded by tools/eventlog.py):
+ *
+ *   0  type       Event::Type
+ *   1  check      CRC-8 of bytes 2..15
+ *   2  code       HTTP code or cause (int16)
+ *   4  boot       Boot count
+ *   6  extra      Type-specific
+ *   8  uptimeMs
+ *  12  value      Latency, reset reason, ...
+ */
+
+#ifndef EVENT_LOG_H
+#define EVENT_LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "crc32.h"
+
+namespace Event {
+
+constexpr size_t  RECORD_SIZE = 16;
+constexpr size_t  HEADER_SIZE = 16;
+constexpr uint8_t VERSION     = 1;
+
+enum class Type : uint8_t {
+    NONE = 0,
+    RESET,          // value = reset reason, code = exception cause, extra = last section
+    SITE_UP,        // code = HTTP code, value = latency ms
+    SITE_DOWN,      // code = HTTP code or error, value = latency ms
+    PROBE_FAIL,     // code = HTTP code or error, value = latency ms
+    WIFI_DOWN,
+    WIFI_UP,        // value = reconnects so far
+    SITE_SLOW,      // code = HTTP code, value = latency ms
+    COUNT
+};
+
+inline const char* typeName(Type t) {
+    static const char* const NAMES[] = {
+        "none", "reset", "site_up", "site_down", "probe_fail", "wifi_down", "wifi_up",
+        "site_slow"
+    };
+    uint8_t i = static_cast<uint8_t>(t);
+    return (i < static_cast<uint8_t>(Type::COUNT)) ? NAMES[i] : "unknown";
+}
+
+struct Record {
+    Type     type;
+    int16_t  code;
+    uint16_t boot;
+    uint16_t extra;
+    uint32_t uptimeMs;
+    uint32_t value;
+};
+
+namespace detail {
+
+inline uint8_t crc8(const uint8_t* data, size_t len) {
+    uint8_t crc = 0;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (uint8_t b = 0; b < 8; b++) {
+            crc = (crc & 0x80) ? static_cast<uint8_t>((crc << 1) ^ 0x07) : static_cast<uint8_t>(crc << 1);
+        }
+    }
+    return crc;
+}
+
+inline void put16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+}
+
+inline void put32(uint8_t* p, uint32_t v) {
+    put16(p, static_cast<uint16_t>(v));
+    put16(p + 2, static_cast<uint16_t>(v >> 16));
+}
+
+inline uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t get32(const uint8_t* p) {
+    return get16(p) | (static_cast<uint32_t>(get16(p + 2)) << 16);
+}
+
+}  // namespace detail
+
+inline void encode(const Record& r, uint8_t out[RECORD_SIZE]) {
+    out[0] = static_cast<uint8_t>(r.type);
+    detail::put16(out + 2, static_cast<uint16_t>(r.code));
+    detail::put16(out + 4, r.boot);
+    detail::put16(out + 6, r.extra);
+    detail::put32(out + 8, r.uptimeMs);
+    detail::put32(out + 12, r.value);
+    out[1] = detail::crc8(out + 2, RECORD_SIZE - 2);
+}
+
+/**
+ * False for torn or unknown records
+ */
+inline bool decode(const uint8_t* in, Record& r) {
+    if (in[0] == 0 || in[0] >= static_cast<uint8_t>(Type::COUNT)) return false;
+    if (in[1] != detail::crc8(in + 2, RECORD_SIZE - 2)) return false;
+    r.type     = static_cast<Type>(in[0]);
+    r.code     = static_cast<int16_t>(detail::get16(in + 2));
+    r.boot     = detail::get16(in + 4);
+    r.extra    = detail::get16(in + 6);
+    r.uptimeMs = detail::get32(in + 8);
+    r.value    = detail::get32(in + 12);
+    return true;
+}
+
+}  // namespace Event
+
+template <class Storage, uint8_t SEGMENTS, size_t SEGMENT_SIZE, size_t BATCH>
+class EventLog {
+public:
+    static_assert(SEGMENTS >= 2, "one segment is erased while the others keep history");
+    static constexpr size_t PER_SEGMENT = (SEGMENT_SIZE - Event::HEADER_SIZE) / Event::RECORD_SIZE;
+    static constexpr size_t CAPACITY    = (SEGMENTS - 1) * PER_SEGMENT;   // Always retained
+
+    explicit EventLog(Storage& storage) : _storage(storage) {}
+
+    /**
+     * Find the newest segment and where to continue
+     */
+    void begin() {
+        _current = 0;
+        _open    = false;
+        _started = false;
+        for (uint8_t s = 0; s < SEGMENTS; s++) {
+            uint32_t seq;
+            if (!readHeader(s, seq)) continue;
+            if (!_started || static_cast<int32_t>(seq - _seq) > 0) {
+                _seq     = seq;
+                _current = s;
+                _started = true;
+            }
+        }
+        if (!_started) return;   // Empty log: first flush starts segment 0
+
+        size_t size = _storage.size(_current);
+        _used = (size - Event::HEADER_SIZE) / Event::RECORD_SIZE;
+        _open = ((size - Event::HEADER_SIZE) % Event::RECORD_SIZE == 0) && _used < PER_SEGMENT;
+    }
+
+    /**
+     * Queue an event; flushes first if the batch is full
+     */
+    void append(const Event::Record& r) {
+        if (_pending == BATCH && !flush()) {
+            _dropped++;
+            return;
+        }
+        Event::encode(r, _batch + _pending * Event::RECORD_SIZE);
+        _pending++;
+    }
+
+    /**
+     * Write queued events to storage; false on a storage error (events
+     * stay queued)
+     */
+    bool flush() {
+        size_t done = 0;
+        while (done < _pending) {
+            if (!_open && !rotate()) break;
+            size_t n = PER_SEGMENT - _used;
+            if (n > _pending - done) n = _pending - done;
+            if (!_storage.append(_current, _batch + done * Event::RECORD_SIZE, n * Event::RECORD_SIZE)) {
+                _open = false;   // Do not append after a possibly partial write
+                break;
+            }
+            _used += n;
+            done  += n;
+            _writes++;
+            if (_used == PER_SEGMENT) _open = false;
+        }
+
+        // Keep whatever was not written
+        memmove(_batch, _batch + done * Event::RECORD_SIZE, (_pending - done) * Event::RECORD_SIZE);
+        _pending -= done;
+        return _pending == 0;
+    }
+
+    /**
+     * Copy up to max records, oldest first, starting at index; includes
+     * queued ones. Returns the number copied.
+     */
+    size_t read(size_t index, uint8_t* out, size_t max) {
+        size_t copied = 0;
+        for (uint8_t i = 1; i <= SEGMENTS && copied < max; i++) {
+            uint8_t seg = (_current + i) % SEGMENTS;    // Oldest first, current last
+            uint32_t seq;
+            if (!readHeader(seg, seq)) continue;
+            size_t count = (_storage.size(seg) - Event::HEADER_SIZE) / Event::RECORD_SIZE;
+            if (index >= count) {
+                index -= count;
+                continue;
+            }
+            size_t n = count - index;
+            if (n > max - copied) n = max - copied;
+            _storage.read(seg, Event::HEADER_SIZE + index * Event::RECORD_SIZE,
+                          out + copied * Event::RECORD_SIZE, n * Event::RECORD_SIZE);
+            copied += n;
+            index   = 0;
+        }
+        if (copied < max && index < _pending) {
+            size_t n = _pending - index;
+            if (n > max - copied) n = max - copied;
+            memcpy(out + copied * Event::RECORD_SIZE, _batch + index * Event::RECORD_SIZE,
+                   n * Event::RECORD_SIZE);
+            copied += n;
+        }
+        return copied;
+    }
+
+    size_t   pending() const { return _pending; }
+    uint32_t writes()  const { return _writes; }
+    uint32_t erases()  const { return _erases; }
+    uint32_t dropped() const { return _dropped; }
+
+private:
+    bool readHeader(uint8_t seg, uint32_t& seq) {
+        uint8_t h[Event::HEADER_SIZE];
+        if (_storage.size(seg) < Event::HEADER_SIZE) return false;
+        if (_storage.read(seg, 0, h, sizeof(h)) != sizeof(h)) return false;
+        if (memcmp(h, "LPEV", 4) != 0 || h[4] != Event::VERSION || h[5] != Event::RECORD_SIZE) return false;
+        if (Event::detail::get32(h + 12) != Crc::crc32(h, 12)) return false;
+        seq = Event::detail::get32(h + 8);
+        return true;
+    }
+
+    /**
+     * Move to the next segment (the oldest), erasing it first
+     */
+    bool rotate() {
+        uint8_t  next = _started ? static_cast<uint8_t>((_current + 1) % SEGMENTS) : 0;
+        uint32_t seq  = _seq + 1;
+
+        if (!_storage.erase(next)) return false;
+        _erases++;
+
+        uint8_t h[Event::HEADER_SIZE] = {'L', 'P', 'E', 'V', Event::VERSION,
+                                         static_cast<uint8_t>(Event::RECORD_SIZE)};
+        Event::detail::put32(h + 8, seq);
+        Event::detail::put32(h + 12, Crc::crc32(h, 12));
+        if (!_storage.append(next, h, sizeof(h))) return false;
+
+        _current = next;
+        _seq     = seq;
+        _started = true;
+        _used    = 0;
+        _open    = true;
+        return true;
+    }
+
+    Storage& _storage;
+    uint8_t  _current = 0;
+    uint32_t _seq     = 0;
+    size_t   _used    = 0;       // Records in the current segment
+    bool     _open    = false;   // Current segment takes more records
+    bool     _started = false;   // Some segment has a valid header
+    uint8_t  _batch[BATCH * Event::RECORD_SIZE];
+    size_t   _pending = 0;
+    uint32_t _writes  = 0;
+    uint32_t _erases  = 0;
+    uint32_t _dropped = 0;
+};
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * LED-Panel-ESP12F - Event Outbox
+ *
+ * Fixed-size FIFO of outgoing messages, kept while the broker is
+ * unreachable and drained in order once it is back.
+ *
+ * - Topics are not copied: they must be string literals or otherwise
+ *   outlive the entry
+ * - Payloads are copied into the entry (truncated to PAYLOAD_MAX)
+ * - When full, the oldest entry is dropped so the newest state survives
+ */
+
+#ifndef EVENT_OUTBOX_H
+#define EVENT_OUTBOX_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+template <size_t N, size_t PAYLOAD_MAX>
+class EventOutbox {
+public:
+    struct Entry {
+        const char* topic;
+        bool        retain;
+        uint16_t    length;
+        char        payload[PAYLOAD_MAX];
+    };
+
+    /**
+     * Queue a message; returns false if an older one had to be dropped
+     */
+    bool push(const char* topic, const char* payload, size_t length, bool retain = false) {
+        bool kept = true;
+        if (_count == N) {
+            pop();
+            _dropped++;
+            kept = false;
+        }
+
+        Entry& e = _entries[(_head + _count) % N];
+        if (length > PAYLOAD_MAX) {
+            length = PAYLOAD_MAX;
+            _truncated++;
+        }
+        e.topic  = topic;
+        e.retain = retain;
+        e.length = static_cast<uint16_t>(length);
+        memcpy(e.payload, payload, length);
+        _count++;
+        return kept;
+    }
+
+    bool push(const char* topic, const char* payload, bool retain = false) {
+        return push(topic, payload, strlen(payload), retain);
+    }
+
+    bool         empty() const { return _count == 0; }
+    size_t       count() const { return _count; }
+    const Entry& front() const { return _entries[_head]; }
+
+    void pop() {
+        if (_count == 0) return;
+        _head = (_head + 1) % N;
+        _count--;
+    }
+
+    uint32_t dropped()   const { return _dropped; }
+    uint32_t truncated() const { return _truncated; }
+
+private:
+    Entry    _entries[N] = {};
+    size_t   _head      = 0;
+    size_t   _count     = 0;
+    uint32_t _dropped   = 0;
+    uint32_t _truncated = 0;
+};
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * LED-Panel-ESP12F - Fleet Table
+ *
+ * Latest beacon heard from each peer board, for mirroring and for the
+ * fleet view in /status.
+ *
+ * - Fixed number of slots; when full, a new board replaces the stalest
+ * - Out-of-order and duplicate beacons (seq not newer) are ignored,
+ *   unless the sender rebooted (seq restarted far behind)
+ * - Entries are kept packed, so at(0..count()-1) are all live
+ */
+
+#ifndef FLEET_TABLE_H
+#define FLEET_TABLE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "beacon.h"
+
+template <size_t N>
+class FleetTable {
+public:
+    struct Entry {
+        Beacon::Status status;
+        uint32_t       heardAt;   // Local millis() when received
+    };
+
+    /**
+     * Store a beacon; returns false if it was stale or a duplicate
+     */
+    bool update(const Beacon::Status& s, uint32_t now) {
+        Entry* e = slot(s.boardId);
+        if (e) {
+            bool newer    = Beacon::seqNewer(s.seq, e->status.seq);
+            bool rebooted = s.seq < REBOOT_SEQ && e->status.seq >= REBOOT_SEQ;
+            if (!newer && !rebooted) {
+                _stale++;
+                return false;
+            }
+        } else if (_count < N) {
+            e = &_entries[_count++];
+        } else {
+            e = &_entries[0];
+            for (size_t i = 1; i < _count; i++) {
+                if (now - _entries[i].heardAt > now - e->heardAt) e = &_entries[i];
+            }
+            _evicted++;
+        }
+        e->status  = s;
+        e->heardAt = now;
+        return true;
+    }
+
+    /**
+     * Forget boards not heard from within timeoutMs
+     */
+    void expire(uint32_t now, uint32_t timeoutMs) {
+        for (size_t i = 0; i < _count;) {
+            if (now - _entries[i].heardAt > timeoutMs) {
+                _entries[i] = _entries[--_count];
+            } else {
+                i++;
+            }
+        }
+    }
+
+    /**
+     * Freshest valid result for a target, or nullptr; the result's age
+     * includes time since it was heard
+     */
+    const Entry* freshestFor(uint32_t targetId, uint32_t now, uint32_t maxAgeMs) const {
+        const Entry* best = nullptr;
+        uint32_t bestAge  = maxAgeMs;
+        for (size_t i = 0; i < _count; i++) {
+            const Entry& e = _entries[i];
+            if (e.status.targetId != targetId || !e.status.valid()) continue;
+            uint32_t age = e.status.ageMs + (now - e.heardAt);
+            if (age <= bestAge) {
+                best    = &e;
+                bestAge = age;
+            }
+        }
+        return best;
+    }
+
+    const Entry* find(uint32_t boardId) const {
+        for (size_t i = 0; i < _count; i++) {
+            if (_entries[i].status.boardId == boardId) return &_entries[i];
+        }
+        return nullptr;
+    }
+
+    size_t       count()   const { return _count; }
+    const Entry& at(size_t i) const { return _entries[i]; }
+    uint32_t     stale()   const { return _stale; }
+    uint32_t     evicted() const { return _evicted; }
+
+private:
+    static constexpr uint32_t REBOOT_SEQ = 16;   // Seq this low after a high one = restart
+
+    Entry* slot(uint32_t boardId) {
+        return const_cast<Entry*>(static_cast<const FleetTable*>(this)->find(boardId));
+    }
+
+    Entry    _entries[N] = {};
+    size_t   _count   = 0;
+    uint32_t _stale   = 0;
+    uint32_t _evicted = 0;
+};
+
+#endif
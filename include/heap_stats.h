@@ -0,0 +1,135 @@
+/**
+ * LED-Panel-ESP12F - Heap Telemetry
+ *
+ * Fixed-size ring buffer of heap samples taken around each probe.
+ *
+ * - Tracks free heap, largest free block and fragmentation
+ * - Min/max over the window and a free-heap trend (bytes per sample)
+ * - Counts consecutive samples whose largest block is too small for TLS,
+ *   and turns that streak into a restart decision (restartNeed())
+ *
+ * No allocation; safe to keep as a global.
+ */
+
+#ifndef HEAP_STATS_H
+#define HEAP_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+enum class HeapRestart : uint8_t {
+    NONE,
+    WHEN_QUIET,   // Restart at the next quiet moment
+    NOW           // Restart regardless of what is shown or sounded
+};
+
+struct HeapSample {
+    uint32_t freeHeap;
+    uint32_t maxBlock;
+    uint8_t  fragmentation;  // Percent, as reported by the SDK
+};
+
+template <size_t N>
+class HeapStats {
+public:
+    static_assert(N >= 2, "Need at least two samples for a trend");
+
+    /**
+     * Record a sample; lowBlockLimit is the smallest usable largest-block
+     */
+    void record(const HeapSample& s, uint32_t lowBlockLimit) {
+        _samples[_head] = s;
+        _head = (_head + 1) % N;
+        if (_count < N) _count++;
+
+        if (s.maxBlock < _minBlockEver || _total == 0) _minBlockEver = s.maxBlock;
+        _total++;
+
+        _lowStreak = (s.maxBlock < lowBlockLimit) ? _lowStreak + 1 : 0;
+    }
+
+    size_t   count()          const { return _count; }
+    uint32_t total()          const { return _total; }
+    uint32_t lowBlockStreak() const { return _lowStreak; }
+    uint32_t minBlockEver()   const { return _minBlockEver; }
+
+    /**
+     * A restart is wanted once the largest block has been too small for
+     * `streak` samples in a row, and forced after `grace` more: a starved
+     * heap fails every TLS check, so the site may never read as up (and
+     * the board never quiet) again
+     */
+    HeapRestart restartNeed(uint32_t streak, uint32_t grace) const {
+        if (_lowStreak >= streak + grace) return HeapRestart::NOW;
+        if (_lowStreak >= streak) return HeapRestart::WHEN_QUIET;
+        return HeapRestart::NONE;
+    }
+
+    const HeapSample& latest() const { return at(_count - 1); }
+
+    /**
+     * Sample i in chronological order (0 = oldest in window)
+     */
+    const HeapSample& at(size_t i) const {
+        size_t start = (_count < N) ? 0 : _head;
+        return _samples[(start + i) % N];
+    }
+
+    uint32_t minFreeHeap() const {
+        uint32_t v = UINT32_MAX;
+        for (size_t i = 0; i < _count; i++) if (at(i).freeHeap < v) v = at(i).freeHeap;
+        return _count ? v : 0;
+    }
+
+    uint32_t maxFreeHeap() const {
+        uint32_t v = 0;
+        for (size_t i = 0; i < _count; i++) if (at(i).freeHeap > v) v = at(i).freeHeap;
+        return v;
+    }
+
+    uint32_t minMaxBlock() const {
+        uint32_t v = UINT32_MAX;
+        for (size_t i = 0; i < _count; i++) if (at(i).maxBlock < v) v = at(i).maxBlock;
+        return _count ? v : 0;
+    }
+
+    uint8_t maxFragmentation() const {
+        uint8_t v = 0;
+        for (size_t i = 0; i < _count; i++) if (at(i).fragmentation > v) v = at(i).fragmentation;
+        return v;
+    }
+
+    /**
+     * Least-squares slope of free heap over the window, in bytes per sample
+     * (negative = heap shrinking)
+     */
+    int32_t freeHeapTrend() const {
+        if (_count < 2) return 0;
+
+        // x = 0..n-1; integer sums stay well within 64 bits for small N
+        int64_t n = _count;
+        int64_t sumX = n * (n - 1) / 2;
+        int64_t sumXX = (n - 1) * n * (2 * n - 1) / 6;
+        int64_t sumY = 0, sumXY = 0;
+        for (size_t i = 0; i < _count; i++) {
+            int64_t y = at(i).freeHeap;
+            sumY  += y;
+            sumXY += static_cast<int64_t>(i) * y;
+        }
+
+        int64_t denom = n * sumXX - sumX * sumX;
+        return static_cast<int32_t>((n * sumXY - sumX * sumY) / denom);
+    }
+
+    void reset() { *this = HeapStats(); }
+
+private:
+    HeapSample _samples[N] = {};
+    size_t     _head         = 0;
+    size_t     _count        = 0;
+    uint32_t   _total        = 0;
+    uint32_t   _lowStreak    = 0;
+    uint32_t   _minBlockEver = 0;
+};
+
+#endif
@@ -0,0 +1,591 @@
+/**
+ * LED-Panel-ESP12F - Allocation-free HTTP Probe
+ *
+ * Minimal HTTP/1.1 GET used by checkSiteStatus() in place of HTTPClient.
+ *
+ * - URL, request and response state live in a statically sized ProbeArena
+ * - Status line and headers are parsed as a stream, line by line, from a
+ *   fixed line buffer
+ * - The body is only read if an inspector asks for it, and then streamed
+ *   to it chunk by chunk (Content-Length and chunked framing removed)
+ * - Redirects (301/302/303/307/308) are followed up to REDIRECT_LIMIT hops;
+ *   follow() starts from a URL already in the arena (redirect_cache.h)
+ * - No Arduino String, no heap allocation
+ *
+ * Templated on the client and environment so the same code runs on the
+ * ESP8266 (WiFiClient / BearSSL) and on the host in unit tests.
+ *
+ * Env must provide:
+ *   uint32_t now();                 // Milliseconds
+ *   void     idle();                // Let the network stack run
+ *   Client&  clientFor(const Url&); // Plain or TLS client for the scheme
+ *
+ * An optional Inspector sees the final response (see NoInspector):
+ *   void begin();                              // New response
+ *   void header(const char* name, const char* value);
+ *   bool wantBody(int status);
+ *   bool body(const uint8_t* data, size_t len);  // false = seen enough
+ */
+
+#ifndef HTTP_PROBE_H
+#define HTTP_PROBE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+namespace HttpProbe {
+
+constexpr size_t  HOST_MAX       = 64;
+constexpr size_t  PATH_MAX       = 192;
+constexpr size_t  LINE_MAX       = 256;
+constexpr size_t  REQUEST_MAX    = 384;
+constexpr size_t  RX_CHUNK       = 128;
+constexpr uint8_t REDIRECT_LIMIT = 10;   // Same as HTTPClient
+
+// Error codes mirror ESP8266HTTPClient's HTTPC_ERROR_* values
+enum Error : int {
+    ERR_CONNECTION_FAILED = -1,
+    ERR_SEND_FAILED       = -2,
+    ERR_CONNECTION_LOST   = -5,
+    ERR_NO_HTTP_SERVER    = -7,
+    ERR_READ_TIMEOUT      = -11,
+    ERR_BAD_URL           = -20
+};
+
+// ============== URL ==============
+
+struct Url {
+    char     host[HOST_MAX];
+    char     path[PATH_MAX];
+    uint16_t port;
+    bool     https;
+};
+
+inline bool startsWithNoCase(const char* s, const char* prefix) {
+    for (; *prefix; ++s, ++prefix) {
+        char a = *s, b = *prefix;
+        if (a >= 'A' && a <= 'Z') a += 'a' - 'A';
+        if (a != b) return false;
+    }
+    return true;
+}
+
+/**
+ * Parse an absolute http(s) URL into fixed buffers
+ */
+inline bool parseUrl(const char* text, Url& url) {
+    const char* p;
+    if (startsWithNoCase(text, "https://")) {
+        url.https = true;
+        url.port  = 443;
+        p = text + 8;
+    } else if (startsWithNoCase(text, "http://")) {
+        url.https = false;
+        url.port  = 80;
+        p = text + 7;
+    } else {
+        return false;
+    }
+
+    size_t hostLen = strcspn(p, ":/?#");
+    if (hostLen == 0 || hostLen >= HOST_MAX) return false;
+    memcpy(url.host, p, hostLen);
+    url.host[hostLen] = '\0';
+    p += hostLen;
+
+    if (*p == ':') {
+        uint32_t port = 0;
+        for (++p; *p >= '0' && *p <= '9'; ++p) {
+            port = port * 10 + (*p - '0');
+            if (port > 65535) return false;
+        }
+        if (port == 0) return false;
+        url.port = static_cast<uint16_t>(port);
+    }
+
+    // Path (fragment is never sent)
+    size_t pathLen = strcspn(p, "#");
+    size_t offset  = (*p == '/') ? 0 : 1;
+    if (pathLen + offset >= PATH_MAX) return false;
+    url.path[0] = '/';
+    memcpy(url.path + offset, p, pathLen);
+    url.path[pathLen + offset] = '\0';
+
+    return true;
+}
+
+/**
+ * RFC 3986 remove_dot_segments over the path of `in` (up to any '?'),
+ * which starts with '/'; the query is copied unchanged. out may not be
+ * shorter than in
+ */
+inline void removeDotSegments(const char* in, char* out) {
+    const char* end = in + strcspn(in, "?");
+    size_t      o   = 0;
+    for (const char* p = in; p < end;) {
+        const char* seg    = p + 1;
+        const char* segEnd = static_cast<const char*>(memchr(seg, '/', end - seg));
+        if (!segEnd) segEnd = end;
+        size_t len  = segEnd - seg;
+        bool   last = segEnd == end;
+
+        if (len == 2 && seg[0] == '.' && seg[1] == '.') {
+            while (o > 0 && out[--o] != '/') {}   // Drop the previous segment
+            if (last) out[o++] = '/';
+        } else if (len == 1 && seg[0] == '.') {
+            if (last) out[o++] = '/';
+        } else {
+            out[o++] = '/';
+            memcpy(out + o, seg, len);
+            o += len;
+        }
+        p = segEnd;
+    }
+    if (o == 0) out[o++] = '/';
+    strcpy(out + o, end);
+}
+
+/**
+ * Resolve a Location header against the URL that returned it (RFC 3986
+ * section 5.2: a relative path replaces the last segment of the base)
+ */
+inline bool resolveLocation(const Url& base, const char* location, Url& out) {
+    if (startsWithNoCase(location, "http://") || startsWithNoCase(location, "https://")) {
+        return parseUrl(location, out);
+    }
+
+    if (location[0] == '/' && location[1] == '/') {
+        // Scheme-relative
+        char buf[HOST_MAX + PATH_MAX + 8];
+        int n = snprintf(buf, sizeof(buf), "%s:%s", base.https ? "https" : "http", location);
+        if (n < 0 || static_cast<size_t>(n) >= sizeof(buf)) return false;
+        return parseUrl(buf, out);
+    }
+
+    // Merge into a scratch path first: out may be base
+    char   merged[PATH_MAX];
+    size_t len = strcspn(location, "#");
+    size_t dir;
+    if (len == 0) {
+        dir = strlen(base.path);                  // Same resource
+    } else if (location[0] == '?') {
+        dir = strcspn(base.path, "?");            // Same path, new query
+    } else if (location[0] == '/') {
+        dir = 0;                                  // Absolute path
+    } else {
+        size_t pathLen = strcspn(base.path, "?");
+        dir = pathLen;
+        while (dir > 0 && base.path[dir - 1] != '/') dir--;   // Keep the directory
+    }
+    if (dir + len >= PATH_MAX) return false;
+    memcpy(merged, base.path, dir);
+    memcpy(merged + dir, location, len);
+    merged[dir + len] = '\0';
+
+    if (&out != &base) {
+        memcpy(out.host, base.host, sizeof(out.host));
+        out.port  = base.port;
+        out.https = base.https;
+    }
+    removeDotSegments(merged, out.path);
+    return true;
+}
+
+/**
+ * Write url back as text; returns its length or 0 if it does not fit
+ */
+inline size_t formatUrl(const Url& url, char* buf, size_t cap) {
+    bool defaultPort = url.port == (url.https ? 443 : 80);
+    char portBuf[8] = "";
+    if (!defaultPort) snprintf(portBuf, sizeof(portBuf), ":%u", url.port);
+
+    int n = snprintf(buf, cap, "%s://%s%s%s", url.https ? "https" : "http", url.host, portBuf,
+                     url.path);
+    return (n > 0 && static_cast<size_t>(n) < cap) ? static_cast<size_t>(n) : 0;
+}
+
+/**
+ * Write the GET request into buf; returns its length or 0 if it does not fit
+ */
+inline size_t buildRequest(const Url& url, char* buf, size_t cap) {
+    bool defaultPort = url.port == (url.https ? 443 : 80);
+    char portBuf[8] = "";
+    if (!defaultPort) snprintf(portBuf, sizeof(portBuf), ":%u", url.port);
+
+    int n = snprintf(buf, cap,
+                     "GET %s HTTP/1.1\r\n"
+                     "Host: %s%s\r\n"
+                     "User-Agent: ESP8266-Monitor/2.0\r\n"
+                     "Connection: close\r\n"
+                     "\r\n",
+                     url.path, url.host, portBuf);
+    return (n > 0 && static_cast<size_t>(n) < cap) ? static_cast<size_t>(n) : 0;
+}
+
+inline bool isRedirect(int code) {
+    return code == 301 || code == 302 || code == 303 || code == 307 || code == 308;
+}
+
+// ============== Response Parser ==============
+
+/**
+ * Streaming parser for the status line and headers
+ *
+ * Lines longer than LINE_MAX are truncated; only the first LINE_MAX - 1
+ * bytes of a header are seen.
+ */
+class ResponseParser {
+public:
+    enum class Phase : uint8_t { STATUS_LINE, HEADERS, BODY, FAILED };
+
+    typedef void (*HeaderHook)(void* ctx, const char* name, const char* value);
+
+    void reset() {
+        _phase         = Phase::STATUS_LINE;
+        _lineLen       = 0;
+        _status        = 0;
+        _contentLength = -1;
+        _chunked       = false;
+        _location[0]   = '\0';
+        _hook          = nullptr;
+    }
+
+    /**
+     * Call hook for every header line (after reset())
+     */
+    void setHeaderHook(HeaderHook hook, void* ctx) {
+        _hook    = hook;
+        _hookCtx = ctx;
+    }
+
+    /**
+     * Consume bytes; returns how many were used (stops at the body)
+     */
+    size_t feed(const uint8_t* data, size_t len) {
+        size_t i = 0;
+        while (i < len && (_phase == Phase::STATUS_LINE || _phase == Phase::HEADERS)) {
+            char c = static_cast<char>(data[i++]);
+            if (c == '\n') {
+                if (_lineLen > 0 && _line[_lineLen - 1] == '\r') _lineLen--;
+                _line[_lineLen] = '\0';
+                onLine();
+                _lineLen = 0;
+            } else if (_lineLen < LINE_MAX - 1) {
+                _line[_lineLen++] = c;
+            }
+        }
+        return i;
+    }
+
+    Phase       phase()         const { return _phase; }
+    bool        headersDone()   const { return _phase == Phase::BODY; }
+    bool        failed()        const { return _phase == Phase::FAILED; }
+    int         statusCode()    const { return _status; }
+    int32_t     contentLength() const { return _contentLength; }
+    bool        chunked()       const { return _chunked; }
+    bool        hasLocation()   const { return _location[0] != '\0'; }
+    const char* location()      const { return _location; }
+
+private:
+    void onLine() {
+        if (_phase == Phase::STATUS_LINE) {
+            parseStatusLine();
+            return;
+        }
+
+        if (_lineLen == 0) {
+            _phase = Phase::BODY;
+            return;
+        }
+
+        char* colon = strchr(_line, ':');
+        if (!colon) return;  // Ignore malformed header lines
+        *colon = '\0';
+        const char* value = colon + 1;
+        while (*value == ' ' || *value == '\t') value++;
+
+        if (equalsNoCase(_line, "location")) {
+            strncpy(_location, value, sizeof(_location) - 1);
+            _location[sizeof(_location) - 1] = '\0';
+        } else if (equalsNoCase(_line, "content-length")) {
+            int32_t v = 0;
+            for (const char* p = value; *p >= '0' && *p <= '9'; ++p) {
+                if (v > (INT32_MAX - 9) / 10) break;
+                v = v * 10 + (*p - '0');
+            }
+            _contentLength = v;
+        } else if (equalsNoCase(_line, "transfer-encoding")) {
+            _chunked = startsWithNoCase(value, "chunked");
+        }
+        if (_hook) _hook(_hookCtx, _line, value);
+    }
+
+    void parseStatusLine() {
+        // "HTTP/1.1 200 OK"
+        if (strncmp(_line, "HTTP/", 5) != 0) {
+            _phase = Phase::FAILED;
+            return;
+        }
+        const char* sp = strchr(_line, ' ');
+        if (!sp || !isDigit(sp[1]) || !isDigit(sp[2]) || !isDigit(sp[3]) ||
+            (sp[4] != ' ' && sp[4] != '\0')) {
+            _phase = Phase::FAILED;
+            return;
+        }
+        _status = (sp[1] - '0') * 100 + (sp[2] - '0') * 10 + (sp[3] - '0');
+        _phase  = Phase::HEADERS;
+    }
+
+    static bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+    static bool equalsNoCase(const char* a, const char* lower) {
+        return startsWithNoCase(a, lower) && a[strlen(lower)] == '\0';
+    }
+
+    Phase   _phase = Phase::STATUS_LINE;
+    char    _line[LINE_MAX];
+    size_t  _lineLen = 0;
+    int     _status  = 0;
+    int32_t _contentLength = -1;
+    bool    _chunked = false;
+    char    _location[LINE_MAX];
+    HeaderHook _hook    = nullptr;
+    void*      _hookCtx = nullptr;
+};
+
+// ============== Body Decoder ==============
+
+/**
+ * Strips Content-Length / chunked framing from body bytes, in place
+ */
+class BodyDecoder {
+public:
+    void reset(int32_t contentLength, bool chunked) {
+        _chunked = chunked;
+        _left    = chunked ? 0 : contentLength;   // -1 = until close
+        _state   = State::SIZE;
+        _done    = !chunked && contentLength == 0;
+    }
+
+    /**
+     * Decode len bytes in place; returns the payload bytes now at data
+     */
+    size_t decode(uint8_t* data, size_t len) {
+        if (!_chunked) {
+            if (_left >= 0 && static_cast<int32_t>(len) >= _left) {
+                len   = static_cast<size_t>(_left);
+                _done = true;
+            }
+            if (_left > 0) _left -= static_cast<int32_t>(len);
+            return len;
+        }
+
+        size_t out = 0;
+        for (size_t i = 0; i < len && !_done; i++) {
+            uint8_t c = data[i];
+            switch (_state) {
+                case State::SIZE:
+                    if (hexValue(c) >= 0) {
+                        // Saturate: a chunk that size outlasts any read anyway
+                        _left = (_left > (INT32_MAX >> 4)) ? INT32_MAX
+                                                           : (_left << 4) | hexValue(c);
+                    } else {
+                        _state = (c == '\n') ? afterSize() : State::SIZE_EXT;
+                    }
+                    break;
+                case State::SIZE_EXT:   // ";ext" and CR up to LF
+                    if (c == '\n') _state = afterSize();
+                    break;
+                case State::DATA:
+                    data[out++] = c;
+                    if (--_left == 0) _state = State::DATA_END;
+                    break;
+                case State::DATA_END:   // CRLF after the chunk
+                    if (c == '\n') _state = State::SIZE;
+                    break;
+            }
+        }
+        return out;
+    }
+
+    bool done() const { return _done; }
+
+private:
+    enum class State : uint8_t { SIZE, SIZE_EXT, DATA, DATA_END };
+
+    State afterSize() {
+        if (_left == 0) {
+            _done = true;   // Last chunk; trailers are not needed
+            return State::SIZE;
+        }
+        return State::DATA;
+    }
+
+    static int hexValue(uint8_t c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    }
+
+    bool    _chunked = false;
+    int32_t _left    = -1;
+    State   _state   = State::SIZE;
+    bool    _done    = false;
+};
+
+// ============== Inspector ==============
+
+/**
+ * Inspector that looks at nothing: status only, body never read
+ */
+struct NoInspector {
+    void begin() {}
+    void header(const char*, const char*) {}
+    bool wantBody(int) { return false; }
+    bool body(const uint8_t*, size_t) { return false; }
+};
+
+template <class Inspector>
+void inspectHeader(void* ctx, const char* name, const char* value) {
+    static_cast<Inspector*>(ctx)->header(name, value);
+}
+
+// ============== Probe ==============
+
+/**
+ * All storage a probe needs, allocated once
+ */
+struct ProbeArena {
+    Url            url;
+    ResponseParser parser;
+    BodyDecoder    body;
+    char           request[REQUEST_MAX];
+    uint8_t        rx[RX_CHUNK];
+};
+
+struct ProbeResult {
+    int      code;        // HTTP status or Error
+    uint8_t  redirects;   // Hops followed
+    uint32_t redirectMs;  // Time spent on them, before the final request
+};
+
+/**
+ * One request/response exchange on arena.url
+ *
+ * If the inspector wants the body, it is read after the headers until
+ * the inspector has seen enough, the body ends or the time runs out; the
+ * status code stands either way.
+ */
+template <class Client, class Env, class Inspector>
+int fetchStatus(Client& client, ProbeArena& arena, uint32_t timeoutMs, Env& env, Inspector& inspector) {
+    arena.parser.reset();
+    arena.parser.setHeaderHook(inspectHeader<Inspector>, &inspector);
+    inspector.begin();
+
+    if (!client.connect(arena.url.host, arena.url.port)) {
+        return ERR_CONNECTION_FAILED;
+    }
+
+    size_t len = buildRequest(arena.url, arena.request, sizeof(arena.request));
+    if (len == 0 || client.write(reinterpret_cast<const uint8_t*>(arena.request), len) != len) {
+        client.stop();
+        return ERR_SEND_FAILED;
+    }
+
+    uint32_t start   = env.now();
+    bool     reading = false;    // Headers done, streaming the body to the inspector
+    for (;;) {
+        int avail = client.available();
+        if (avail > 0) {
+            size_t want = (static_cast<size_t>(avail) < sizeof(arena.rx)) ? avail : sizeof(arena.rx);
+            int got = client.read(arena.rx, want);
+            if (got <= 0) continue;
+
+            size_t used = 0;
+            if (!reading) {
+                used = arena.parser.feed(arena.rx, got);
+                if (arena.parser.failed()) {
+                    client.stop();
+                    return ERR_NO_HTTP_SERVER;
+                }
+                if (!arena.parser.headersDone()) continue;
+
+                int code = arena.parser.statusCode();
+                bool follow   = isRedirect(code) && arena.parser.hasLocation();
+                bool bodyless = code < 200 || code == 204 || code == 304;
+                if (follow || bodyless || !inspector.wantBody(code)) break;
+                arena.body.reset(arena.parser.contentLength(), arena.parser.chunked());
+                reading = true;
+            }
+
+            size_t n = arena.body.decode(arena.rx + used, got - used);
+            if ((n > 0 && !inspector.body(arena.rx + used, n)) || arena.body.done()) break;
+            continue;
+        }
+
+        if (reading && arena.body.done()) break;
+        if (!client.connected()) {
+            if (reading) break;   // Body ended with the connection
+            client.stop();
+            return ERR_CONNECTION_LOST;
+        }
+        if (env.now() - start >= timeoutMs) {
+            if (reading) break;
+            client.stop();
+            return ERR_READ_TIMEOUT;
+        }
+        env.idle();
+    }
+
+    client.stop();
+    return arena.parser.statusCode();
+}
+
+/**
+ * Probe arena.url as the caller set it, following redirects; arena.url
+ * is then where the chain ended
+ */
+template <class Env, class Inspector>
+ProbeResult follow(ProbeArena& arena, uint32_t timeoutMs, Env& env, Inspector& inspector) {
+    ProbeResult result = {ERR_BAD_URL, 0, 0};
+    uint32_t    start  = env.now();
+
+    for (;;) {
+        uint32_t hopStart = env.now();
+        result.code = fetchStatus(env.clientFor(arena.url), arena, timeoutMs, env, inspector);
+        result.redirectMs = hopStart - start;
+
+        if (!isRedirect(result.code) || !arena.parser.hasLocation() ||
+            result.redirects >= REDIRECT_LIMIT) {
+            return result;
+        }
+        if (!resolveLocation(arena.url, arena.parser.location(), arena.url)) {
+            return result;
+        }
+        result.redirects++;
+    }
+}
+
+/**
+ * Probe a URL, following redirects
+ */
+template <class Env, class Inspector>
+ProbeResult probe(const char* urlText, ProbeArena& arena, uint32_t timeoutMs, Env& env, Inspector& inspector) {
+    if (!parseUrl(urlText, arena.url)) {
+        return {ERR_BAD_URL, 0, 0};
+    }
+    return follow(arena, timeoutMs, env, inspector);
+}
+
+template <class Env>
+ProbeResult probe(const char* urlText, ProbeArena& arena, uint32_t timeoutMs, Env& env) {
+    NoInspector none;
+    return probe(urlText, arena, timeoutMs, env, none);
+}
+
+}  // namespace HttpProbe
+
+#endif
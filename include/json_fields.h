@@ -0,0 +1,338 @@
+/**
+ * LED-Panel-ESP12F - Streaming JSON Field Extractor
+ *
+ * Picks a few scalar fields out of a JSON health response as it streams
+ * past, e.g. "status" and "checks.db" from
+ *
+ *   {"status":"ok","checks":{"db":"up","cache":"up"},"nodes":[{"ok":true}]}
+ *
+ * - SAX style: one byte at a time, no DOM, no look-ahead, so it can be fed
+ *   straight from the TLS read loop in chunks of any size
+ * - Paths are dotted keys; array elements are numbered from 0
+ *   ("nodes.0.ok"). Keys are compared as they appear in the text (escapes
+ *   are not decoded)
+ * - Bounded state: DEPTH_MAX levels and a PATH_MAX byte current path;
+ *   longer paths are parsed but cannot match, deeper nesting stops the
+ *   parse
+ * - String values are captured unquoted with simple escapes decoded
+ *   (\uXXXX becomes '?'); numbers, true, false and null as written.
+ *   Values longer than VALUE_MAX - 1 are marked truncated
+ * - Stops consuming once every field has been found; malformed input
+ *   stops the parse and keeps what was found before it
+ */
+
+#ifndef JSON_FIELDS_H
+#define JSON_FIELDS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace JsonFields {
+
+constexpr uint8_t FIELD_MAX = 4;
+constexpr uint8_t PATH_MAX  = 32;      // Including NUL
+constexpr uint8_t VALUE_MAX = 16;      // Including NUL
+constexpr uint8_t DEPTH_MAX = 8;
+
+/**
+ * A captured value
+ */
+struct Value {
+    char    text[VALUE_MAX];
+    uint8_t len;
+    bool    found;
+    bool    truncated;
+
+    bool equals(const char* s) const {
+        return found && !truncated && strlen(s) == len && memcmp(s, text, len) == 0;
+    }
+};
+
+class Parser {
+public:
+    /**
+     * Start a new document; paths[i] is captured into values[i]
+     */
+    void begin(const char (*paths)[PATH_MAX], uint8_t count, Value* values) {
+        _paths   = paths;
+        _count   = (count < FIELD_MAX) ? count : FIELD_MAX;
+        _values  = values;
+        _found   = 0;
+        _state   = State::VALUE;
+        _depth   = 0;
+        _pathLen = 0;
+        _capture = -1;
+        for (uint8_t i = 0; i < _count; i++) {
+            _values[i] = Value();
+        }
+    }
+
+    /**
+     * Parse len bytes; returns how many were used (fewer once done())
+     */
+    size_t feed(const uint8_t* data, size_t len) {
+        size_t i = 0;
+        while (i < len && !done()) {
+            if (!step(static_cast<char>(data[i]))) continue;   // Byte not used up yet
+            i++;
+        }
+        return i;
+    }
+
+    /**
+     * Every field found, document complete, or malformed
+     */
+    bool done() const {
+        return _found == allMask() || _state == State::END || _state == State::FAILED;
+    }
+
+    bool    failed()    const { return _state == State::FAILED; }
+    uint8_t foundMask() const { return _found; }
+
+private:
+    enum class State : uint8_t {
+        VALUE,          // Expecting a value
+        KEY_OR_CLOSE,   // After '{'
+        KEY_START,      // After ',' in an object
+        KEY,
+        KEY_ESCAPE,
+        COLON,
+        STRING,
+        STRING_ESCAPE,
+        UNICODE,        // \uXXXX digits
+        LITERAL,        // Number, true, false, null
+        AFTER_VALUE,    // Expecting ',' or a closing bracket
+        END,
+        FAILED
+    };
+
+    uint8_t allMask() const { return static_cast<uint8_t>((1u << _count) - 1); }
+
+    static bool isSpace(char c) {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+    }
+
+    bool inArray() const {
+        return _depth > 0 && (_arrays & (1u << (_depth - 1)));
+    }
+
+    /**
+     * Handle one byte; false if it must be seen again in the new state
+     */
+    bool step(char c) {
+        switch (_state) {
+            case State::VALUE:
+                if (isSpace(c)) return true;
+                return startValue(c);
+
+            case State::KEY_OR_CLOSE:
+            case State::KEY_START:
+                if (isSpace(c)) return true;
+                if (c == '}' && _state == State::KEY_OR_CLOSE) return close(false);
+                if (c != '"') return fail();
+                setPathToBase();
+                if (_pathLen > 0) append('.');
+                _state = State::KEY;
+                return true;
+
+            case State::KEY:
+                if (c == '"') {
+                    _state = State::COLON;
+                } else {
+                    if (c == '\\') _state = State::KEY_ESCAPE;
+                    append(c);
+                }
+                return true;
+
+            case State::KEY_ESCAPE:
+                append(c);
+                _state = State::KEY;
+                return true;
+
+            case State::COLON:
+                if (isSpace(c)) return true;
+                if (c != ':') return fail();
+                _state = State::VALUE;
+                return true;
+
+            case State::STRING:
+                if (c == '"') {
+                    endValue();
+                } else if (c == '\\') {
+                    _state = State::STRING_ESCAPE;
+                } else if (static_cast<uint8_t>(c) < 0x20) {
+                    return fail();
+                } else {
+                    capture(c);
+                }
+                return true;
+
+            case State::STRING_ESCAPE:
+                _state = State::STRING;
+                switch (c) {
+                    case 'n': capture('\n'); break;
+                    case 't': capture('\t'); break;
+                    case 'r': capture('\r'); break;
+                    case 'b': capture('\b'); break;
+                    case 'f': capture('\f'); break;
+                    case 'u':
+                        capture('?');
+                        _hexLeft = 4;
+                        _state   = State::UNICODE;
+                        break;
+                    default:  capture(c); break;   // " \ /
+                }
+                return true;
+
+            case State::UNICODE:
+                if (--_hexLeft == 0) _state = State::STRING;
+                return true;
+
+            case State::LITERAL:
+                if ((c >= '0' && c <= '9') || (c >= 'a' && c <= 'z') ||
+                    c == '-' || c == '+' || c == '.' || c == 'E') {
+                    capture(c);
+                    return true;
+                }
+                endValue();
+                return false;   // The delimiter belongs to the container
+
+            case State::AFTER_VALUE:
+                if (isSpace(c)) return true;
+                if (c == ',') {
+                    if (inArray()) {
+                        _index[_depth - 1]++;
+                        _state = State::VALUE;
+                        setArrayPath();
+                    } else {
+                        _state = State::KEY_START;
+                    }
+                    return true;
+                }
+                if (c == '}' || c == ']') return close(c == ']');
+                return fail();
+
+            case State::END:
+            case State::FAILED:
+                return true;
+        }
+        return true;
+    }
+
+    bool startValue(char c) {
+        if (c == '{' || c == '[') {
+            if (_depth == DEPTH_MAX) return fail();
+            bool array = (c == '[');
+            _base[_depth]  = _pathLen;
+            _index[_depth] = 0;
+            if (array) _arrays |= (1u << _depth);
+            else       _arrays &= ~(1u << _depth);
+            _depth++;
+            if (array) {
+                _state = State::VALUE;
+                setArrayPath();
+            } else {
+                _state = State::KEY_OR_CLOSE;
+            }
+            return true;
+        }
+        if (c == ']' && inArray() && _index[_depth - 1] == 0) {
+            return close(true);   // Empty array
+        }
+
+        _capture = -1;
+        if (_pathLen < PATH_MAX) {
+            for (uint8_t i = 0; i < _count; i++) {
+                if (!(_found & (1 << i)) && strlen(_paths[i]) == _pathLen &&
+                    memcmp(_paths[i], _path, _pathLen) == 0) {
+                    _capture = static_cast<int8_t>(i);
+                    break;
+                }
+            }
+        }
+
+        if (c == '"') {
+            _state = State::STRING;
+            return true;
+        }
+        if (c == '-' || (c >= '0' && c <= '9') || c == 't' || c == 'f' || c == 'n') {
+            _state = State::LITERAL;
+            capture(c);
+            return true;
+        }
+        return fail();
+    }
+
+    void endValue() {
+        if (_capture >= 0) {
+            Value& v = _values[_capture];
+            v.text[v.len] = '\0';
+            v.found = true;
+            _found |= static_cast<uint8_t>(1 << _capture);
+            _capture = -1;
+        }
+        _state = _depth ? State::AFTER_VALUE : State::END;
+    }
+
+    bool close(bool array) {
+        if (_depth == 0 || inArray() != array) return fail();
+        _depth--;
+        _pathLen = _base[_depth];
+        _state   = _depth ? State::AFTER_VALUE : State::END;
+        return true;
+    }
+
+    void capture(char c) {
+        if (_capture < 0) return;
+        Value& v = _values[_capture];
+        if (v.len < VALUE_MAX - 1) v.text[v.len++] = c;
+        else v.truncated = true;
+    }
+
+    void setPathToBase() {
+        _pathLen = _base[_depth - 1];
+    }
+
+    void setArrayPath() {
+        setPathToBase();
+        if (_pathLen > 0) append('.');
+        char digits[6];
+        uint8_t n = 0;
+        uint16_t v = _index[_depth - 1];
+        do {
+            digits[n++] = static_cast<char>('0' + v % 10);
+            v /= 10;
+        } while (v);
+        while (n) append(digits[--n]);
+    }
+
+    // Paths that do not fit become PATH_MAX long, which matches nothing
+    void append(char c) {
+        if (_pathLen < PATH_MAX - 1) _path[_pathLen++] = c;
+        else _pathLen = PATH_MAX;
+    }
+
+    bool fail() {
+        _state = State::FAILED;
+        return true;
+    }
+
+    const char (*_paths)[PATH_MAX] = nullptr;
+    Value*   _values  = nullptr;
+    uint8_t  _count   = 0;
+    uint8_t  _found   = 0;
+    State    _state   = State::VALUE;
+    uint8_t  _depth   = 0;
+    uint8_t  _arrays  = 0;              // Bit d = level d is an array
+    uint8_t  _base[DEPTH_MAX];          // Path length at each container
+    uint16_t _index[DEPTH_MAX];         // Element number in arrays
+    char     _path[PATH_MAX];
+    uint8_t  _pathLen = 0;
+    int8_t   _capture = -1;             // Field being captured
+    uint8_t  _hexLeft = 0;
+};
+
+}  // namespace JsonFields
+
+#endif
@@ -0,0 +1,127 @@
+/**
+ * LED-Panel-ESP12F - Latency Anomaly Detection
+ *
+ * Flags a site as slow (DEGRADED) when probe latency moves well above its
+ * own recent behaviour, before it gets bad enough to fail outright.
+ *
+ * - Exponentially weighted mean and variance of latency, alpha = 2^-shift,
+ *   in integer fixed point (mean in 1/256 ms, variance in ms^2)
+ * - A sample is slow if it exceeds the mean by more than enterSigma10/10
+ *   standard deviations and by at least minDeltaMs; the state clears once
+ *   samples fall back within exitSigma10/10 (hysteresis)
+ * - enterCount slow samples in a row raise the state, exitCount normal
+ *   ones clear it, so a single spike does nothing
+ * - Slow samples still move the baseline, at a quarter of the weight, so
+ *   a lasting change is eventually accepted as the new normal
+ * - No judgement until warmup samples have been seen
+ */
+
+#ifndef LATENCY_EWMA_H
+#define LATENCY_EWMA_H
+
+#include <stdint.h>
+
+class LatencyEwma {
+public:
+    struct Params {
+        uint8_t  alphaShift   = 3;     // alpha = 1/8
+        uint16_t enterSigma10 = 30;    // 3.0 sigma
+        uint16_t exitSigma10  = 20;    // 2.0 sigma
+        uint32_t minDeltaMs   = 200;   // Ignore small absolute changes on a steady site
+        uint8_t  warmup       = 8;
+        uint8_t  enterCount   = 2;
+        uint8_t  exitCount    = 3;
+    };
+
+    LatencyEwma() {}
+    explicit LatencyEwma(const Params& params) : _p(params) {}
+
+    /**
+     * Add a successful probe's latency; returns the (possibly new) state
+     */
+    bool add(uint32_t ms) {
+        if (ms > MAX_MS) ms = MAX_MS;
+
+        if (_samples == 0) {
+            _meanQ8 = ms << 8;
+            _var    = 0;
+            _samples = 1;
+            return _slow;
+        }
+
+        int32_t  diff    = static_cast<int32_t>(ms) - static_cast<int32_t>(meanMs());
+        uint64_t diff2   = static_cast<uint64_t>(static_cast<int64_t>(diff) * diff);
+        bool     judged  = _samples >= _p.warmup;
+        bool     above   = judged && diff > 0 && static_cast<uint32_t>(diff) >= _p.minDeltaMs;
+        bool     outside = above && beyond(diff2, _slow ? _p.exitSigma10 : _p.enterSigma10);
+
+        if (outside) {
+            _normalRun = 0;
+            if (!_slow && ++_slowRun >= _p.enterCount) _slow = true;
+        } else {
+            _slowRun = 0;
+            if (_slow && ++_normalRun >= _p.exitCount) _slow = false;
+        }
+
+        update(ms, diff, (outside ? _p.alphaShift + 2 : _p.alphaShift));
+        if (_samples < 0xFFFF) _samples++;
+        return _slow;
+    }
+
+    bool     slow()    const { return _slow; }
+    uint32_t meanMs()  const { return (_meanQ8 + 128) >> 8; }
+    uint32_t sigmaMs() const { return isqrt(_var); }
+    uint16_t samples() const { return _samples; }
+
+    void reset() {
+        _meanQ8 = 0;
+        _var = 0;
+        _samples = 0;
+        _slow = false;
+        _slowRun = 0;
+        _normalRun = 0;
+    }
+
+private:
+    static constexpr uint32_t MAX_MS = 60000;   // Keeps mean << 8 and diff^2 in range
+
+    // diff^2 > (sigma10 / 10)^2 * var
+    bool beyond(uint64_t diff2, uint16_t sigma10) const {
+        return diff2 * 100 > static_cast<uint64_t>(sigma10) * sigma10 * _var;
+    }
+
+    /**
+     * mean += alpha * diff; var = (1 - alpha) * (var + alpha * diff^2)
+     */
+    void update(uint32_t ms, int32_t diff, uint8_t shift) {
+        int32_t step = ((static_cast<int32_t>(ms) << 8) - static_cast<int32_t>(_meanQ8)) >> shift;
+        _meanQ8 = static_cast<uint32_t>(static_cast<int32_t>(_meanQ8) + step);
+
+        uint64_t v = _var + ((static_cast<uint64_t>(static_cast<int64_t>(diff) * diff)) >> shift);
+        v -= v >> shift;
+        _var = (v > UINT32_MAX) ? UINT32_MAX : static_cast<uint32_t>(v);
+    }
+
+    static uint32_t isqrt(uint32_t v) {
+        uint32_t r = 0;
+        for (uint32_t bit = 1UL << 30; bit; bit >>= 2) {
+            if (v >= r + bit) {
+                v -= r + bit;
+                r = (r >> 1) + bit;
+            } else {
+                r >>= 1;
+            }
+        }
+        return r;
+    }
+
+    Params   _p;
+    uint32_t _meanQ8    = 0;
+    uint32_t _var       = 0;
+    uint16_t _samples   = 0;
+    bool     _slow      = false;
+    uint8_t  _slowRun   = 0;
+    uint8_t  _normalRun = 0;
+};
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * LED-Panel-ESP12F - Levelled Logging
+ *
+ *   LOG_WARN(WIFI, "Reconnect failed, status %d", status);
+ *
+ * prints "[   61234] W wifi: Reconnect failed, status 6".
+ *
+ * - LOG_LEVEL (a build flag, default LOG_LEVEL_WARN) sets the most
+ *   verbose level compiled in; calls below it expand to nothing, so
+ *   neither the format string nor the arguments cost anything
+ * - Formats stay in flash (PSTR); lines are queued in a LogRing and
+ *   drained to Serial by Log::drain() as the UART has room, so a log
+ *   call never waits for the serial port
+ * - With LOG_LEVEL_NONE the ring buffer is not compiled in at all
+ */
+
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_WARN
+#endif
+
+namespace Log {
+
+constexpr size_t BUFFER_SIZE = 1024;    // Queued bytes waiting for the UART
+constexpr size_t LINE_MAX    = 96;      // Longer lines are cut short
+constexpr size_t DRAIN_MAX   = 128;     // Bytes handed to the UART per drain()
+
+enum class Level : uint8_t {
+    ERROR = LOG_LEVEL_ERROR,
+    WARN  = LOG_LEVEL_WARN,
+    INFO  = LOG_LEVEL_INFO,
+    DEBUG = LOG_LEVEL_DEBUG
+};
+
+enum class Category : uint8_t {
+    BOOT = 0,
+    WIFI,
+    PROBE,
+    HEAP,
+    UI,
+    FLEET,
+    PUSH,
+    MQTT,
+    CONFIG,
+    EVENT,
+    COUNT
+};
+
+inline char levelChar(Level l) {
+    static const char CHARS[] = "?EWID";
+    uint8_t i = static_cast<uint8_t>(l);
+    return (i < sizeof(CHARS) - 1) ? CHARS[i] : '?';
+}
+
+inline const char* categoryName(Category c) {
+    static const char* const NAMES[] = {
+        "boot", "wifi", "probe", "heap", "ui", "fleet", "push", "mqtt", "config", "event"
+    };
+    uint8_t i = static_cast<uint8_t>(c);
+    return (i < static_cast<uint8_t>(Category::COUNT)) ? NAMES[i] : "?";
+}
+
+#if LOG_LEVEL > LOG_LEVEL_NONE
+/**
+ * Format and queue one line; fmt is a PSTR
+ */
+void write(Level level, Category category, const char* fmt, ...)
+    __attribute__((format(printf, 3, 4)));
+
+/**
+ * Move queued bytes to Serial, as many as fit without blocking
+ */
+void drain();
+
+uint32_t dropped();
+#else
+inline void drain() {}
+inline uint32_t dropped() { return 0; }
+#endif
+
+}  // namespace Log
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(cat, fmt, ...) Log::write(Log::Level::ERROR, Log::Category::cat, PSTR(fmt), ##__VA_ARGS__)
+#else
+#define LOG_ERROR(cat, fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(cat, fmt, ...)  Log::write(Log::Level::WARN, Log::Category::cat, PSTR(fmt), ##__VA_ARGS__)
+#else
+#define LOG_WARN(cat, fmt, ...)  do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(cat, fmt, ...)  Log::write(Log::Level::INFO, Log::Category::cat, PSTR(fmt), ##__VA_ARGS__)
+#else
+#define LOG_INFO(cat, fmt, ...)  do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(cat, fmt, ...) Log::write(Log::Level::DEBUG, Log::Category::cat, PSTR(fmt), ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(cat, fmt, ...) do {} while (0)
+#endif
+
+#endif
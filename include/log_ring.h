@@ -0,0 +1,71 @@
+/**
+ * LED-Panel-ESP12F - Log Ring Buffer
+ *
+ * Byte FIFO between log calls and the UART. Lines go in whole or not at
+ * all (a full buffer drops the line and counts it, it never waits), and
+ * come out only as fast as the port's transmit FIFO has room, so neither
+ * side ever blocks on the 115200-baud serial line.
+ */
+
+#ifndef LOG_RING_H
+#define LOG_RING_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+template <size_t N>
+class LogRing {
+public:
+    /**
+     * Append a line; false (and counted as dropped) if it does not fit
+     */
+    bool push(const char* data, size_t len) {
+        if (len > N - _used) {
+            _dropped++;
+            return false;
+        }
+        size_t tail  = (_head + _used) % N;
+        size_t first = (len < N - tail) ? len : N - tail;
+        memcpy(_buf + tail, data, first);
+        memcpy(_buf, data + first, len - first);
+        _used += len;
+        return true;
+    }
+
+    /**
+     * Write queued bytes to out without blocking: at most budget bytes,
+     * and never more than out.availableForWrite() reports free
+     */
+    template <class Out>
+    size_t drain(Out& out, size_t budget) {
+        size_t written = 0;
+        while (_used > 0 && written < budget) {
+            int room = out.availableForWrite();
+            if (room <= 0) break;
+
+            size_t n = (_head + _used <= N) ? _used : N - _head;    // Contiguous run
+            if (n > static_cast<size_t>(room)) n = room;
+            if (n > budget - written) n = budget - written;
+            n = out.write(reinterpret_cast<const uint8_t*>(_buf + _head), n);
+            if (n == 0) break;
+
+            _head     = (_head + n) % N;
+            _used    -= n;
+            written  += n;
+        }
+        return written;
+    }
+
+    size_t   used()    const { return _used; }
+    size_t   free()    const { return N - _used; }
+    uint32_t dropped() const { return _dropped; }
+
+private:
+    char     _buf[N];
+    size_t   _head    = 0;
+    size_t   _used    = 0;
+    uint32_t _dropped = 0;
+};
+
+#endif
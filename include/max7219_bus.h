@@ -0,0 +1,68 @@
+/**
+ * LED-Panel-ESP12F - MAX7219 SPI Transport
+ *
+ * Pushes whole frames to the panel without going through MD_MAX72XX's
+ * per-byte SPI.transfer() path.
+ *
+ * - Frame is packed once into a contiguous buffer (64 bytes for 4 modules)
+ * - Each row goes out as one SPI.writeBytes() burst, which the ESP8266
+ *   core loads straight into the 64-byte HSPI FIFO
+ * - CS is toggled once per row via the GPIO set/clear registers
+ *   (CS must be on GPIO0..15)
+ * - CPU time per frame is measured with the cycle counter
+ *
+ * Used for pre-rendered bitmaps; MD_Parola keeps its own driver for
+ * runtime text and resynchronises the panel on its next update.
+ */
+
+#ifndef MAX7219_BUS_H
+#define MAX7219_BUS_H
+
+#include <Arduino.h>
+#include <SPI.h>
+#include "max7219_frame.h"
+
+template <uint8_t DEVICES>
+class Max7219Bus {
+public:
+    static constexpr uint32_t SPI_CLOCK = 8000000;  // Same as MD_MAX72XX
+
+    explicit Max7219Bus(uint8_t csPin) : _csMask(1u << csPin) {}
+
+    /**
+     * Write a frame of DEVICES * 8 columns (left to right)
+     */
+    void writeFrame(const uint8_t* cols) {
+        uint32_t start = ESP.getCycleCount();
+
+        Max7219Frame::packFrame(cols, DEVICES, _packed);
+
+        SPI.beginTransaction(SPISettings(SPI_CLOCK, MSBFIRST, SPI_MODE0));
+        for (uint8_t row = 0; row < Max7219Frame::ROWS; row++) {
+            GPOC = _csMask;
+            SPI.writeBytes(&_packed[row * ROW_BYTES], ROW_BYTES);
+            GPOS = _csMask;  // Rising edge latches the row in every module
+        }
+        SPI.endTransaction();
+
+        uint32_t us = (ESP.getCycleCount() - start) / ESP.getCpuFreqMHz();
+        _lastFrameUs = us;
+        if (us > _maxFrameUs) _maxFrameUs = us;
+        _frames++;
+    }
+
+    uint32_t lastFrameUs() const { return _lastFrameUs; }
+    uint32_t maxFrameUs()  const { return _maxFrameUs; }
+    uint32_t frameCount()  const { return _frames; }
+
+private:
+    static constexpr size_t ROW_BYTES = Max7219Frame::rowBytes(DEVICES);
+
+    uint32_t _csMask;
+    uint8_t  _packed[Max7219Frame::frameBytes(DEVICES)];
+    uint32_t _lastFrameUs = 0;
+    uint32_t _maxFrameUs  = 0;
+    uint32_t _frames      = 0;
+};
+
+#endif
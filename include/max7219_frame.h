@@ -0,0 +1,65 @@
+/**
+ * LED-Panel-ESP12F - MAX7219 Frame Packing
+ *
+ * Converts a display frame (one byte per column, left to right, bit 0 =
+ * top row) into the register writes a chain of FC16 modules expects.
+ *
+ * Layout of a packed frame:
+ *   8 rows x (2 bytes x devices), row-major
+ *   Each row is one SPI burst: [digit, data] per device, last device first
+ *
+ * FC16 modules wire digit registers to rows and reverse the column bits,
+ * matching MD_MAX72XX's FC16_HW mapping.
+ */
+
+#ifndef MAX7219_FRAME_H
+#define MAX7219_FRAME_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Max7219Frame {
+
+constexpr uint8_t ROWS        = 8;
+constexpr uint8_t COLS_PER_DEV = 8;
+constexpr uint8_t OP_DIGIT0   = 1;
+
+constexpr size_t rowBytes(uint8_t devices)   { return 2u * devices; }
+constexpr size_t frameBytes(uint8_t devices) { return ROWS * rowBytes(devices); }
+
+/**
+ * Pack one row of the frame into out[rowBytes(devices)]
+ */
+inline void packRow(const uint8_t* cols, uint8_t devices, uint8_t row, uint8_t* out) {
+    const uint16_t total = devices * COLS_PER_DEV;
+    const uint8_t  mask  = 1u << row;
+
+    for (uint8_t dev = 0; dev < devices; dev++) {
+        // Device 0 is the rightmost module and is shifted out last
+        uint8_t* slot = out + (devices - 1 - dev) * 2;
+        uint8_t  data = 0;
+
+        for (uint8_t c = 0; c < COLS_PER_DEV; c++) {
+            uint16_t mdCol = dev * COLS_PER_DEV + c;      // 0 = rightmost
+            if (cols[total - 1 - mdCol] & mask) {
+                data |= 0x80u >> c;                       // Reversed columns
+            }
+        }
+
+        slot[0] = OP_DIGIT0 + row;
+        slot[1] = data;
+    }
+}
+
+/**
+ * Pack a whole frame into out[frameBytes(devices)]
+ */
+inline void packFrame(const uint8_t* cols, uint8_t devices, uint8_t* out) {
+    for (uint8_t row = 0; row < ROWS; row++) {
+        packRow(cols, devices, row, out + row * rowBytes(devices));
+    }
+}
+
+}  // namespace Max7219Frame
+
+#endif
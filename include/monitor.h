@@ -0,0 +1,195 @@
+/**
+ * LED-Panel-ESP12F - Monitor Scheduling and Alerts
+ *
+ * The decisions loop() makes, without the hardware: when a site check is
+ * due, how WiFi loss and recovery are handled, what a check result shows
+ * and sounds, and the debounced mute button. Outputs go through an Io
+ * adapter, so the same code drives the panel and buzzer on the board and
+ * a recorded timeline in the host simulation (test/test_simulation).
+ *
+ * Io needs:
+ *   void show(Screen s);                // Scroll a status message
+ *   void alarm(bool on);                // Continuous outage tone
+ *   void chirp();                       // Short "slow" tone
+ *   void beep();                        // Unmute confirmation
+ *
+ * All times are millis() values; intervals are compared by subtraction,
+ * so the 49-day wrap is harmless.
+ */
+
+#ifndef MONITOR_H
+#define MONITOR_H
+
+#include <stdint.h>
+
+enum class Screen : uint8_t {
+    SITE_UP,
+    SITE_DOWN,
+    SITE_SLOW,
+    MUTED,
+    UNMUTED,
+    WIFI_RECONNECT
+};
+
+template <class Io>
+class Monitor {
+public:
+    struct Timing {
+        uint32_t firstCheckMs = 5000;   // First check this long after boot
+        uint32_t debounceMs   = 200;
+    };
+
+    enum class WifiEvent : uint8_t {
+        NONE,
+        LOST,
+        RESTORED,     // Came back by itself (auto-reconnect)
+        RECONNECT     // Time to call WiFi.reconnect(); report success with reconnected()
+    };
+
+    /**
+     * What a check result changed
+     */
+    struct Change {
+        bool status;   // Up/down changed, or first result
+        bool slow;     // Slow state changed while up
+    };
+
+    explicit Monitor(Io& io) : _io(io) {}
+    Monitor(Io& io, const Timing& timing) : _io(io), _t(timing) {}
+
+    void begin(uint32_t now, uint32_t intervalMs, bool wifiConnected) {
+        _wifi      = wifiConnected;
+        _lastCheck = now - intervalMs + _t.firstCheckMs;
+    }
+
+    // ============== Checks ==============
+
+    /**
+     * True (and the interval restarts) if this board should check now
+     */
+    bool checkDue(uint32_t now, uint32_t intervalMs, bool prober) {
+        if (!_wifi || !prober || now - _lastCheck < intervalMs) return false;
+        _lastCheck = now;
+        return true;
+    }
+
+    /**
+     * Make the next check due on the next pass
+     */
+    void checkSoon(uint32_t now, uint32_t intervalMs) { _lastCheck = now - intervalMs; }
+
+    /**
+     * A result arrived from elsewhere (mirrored prober); restart the interval
+     */
+    void checked(uint32_t now) { _lastCheck = now; }
+
+    /**
+     * Show and sound a check result; slow only counts while up
+     */
+    Change result(bool isUp, bool slow) {
+        Change c;
+        c.status = !_known || isUp != _up;
+        slow     = isUp && slow;
+        c.slow   = isUp && slow != _slow;
+        _up    = isUp;
+        _slow  = slow;
+        _known = true;
+
+        _io.show(!isUp ? Screen::SITE_DOWN : slow ? Screen::SITE_SLOW : Screen::SITE_UP);
+        if (!isUp) {
+            _io.alarm(!_muted);
+        } else {
+            _io.alarm(false);
+            if (slow && !_muted) _io.chirp();
+        }
+        return c;
+    }
+
+    // ============== WiFi ==============
+
+    /**
+     * Track the link once per pass; at most one event per call
+     */
+    WifiEvent wifi(uint32_t now, bool connected, uint32_t reconnectMs) {
+        if (!connected && _wifi) {
+            _wifi = false;
+            _io.alarm(!_muted);
+            return WifiEvent::LOST;
+        }
+        if (connected && !_wifi) {
+            reconnected();
+            return WifiEvent::RESTORED;
+        }
+        if (!connected && now - _lastReconnect >= reconnectMs) {
+            _lastReconnect = now;
+            _io.show(Screen::WIFI_RECONNECT);
+            return WifiEvent::RECONNECT;
+        }
+        return WifiEvent::NONE;
+    }
+
+    /**
+     * The link is up again after a RECONNECT
+     */
+    void reconnected() {
+        _wifi = true;
+        _reconnects++;
+        _io.alarm(false);
+    }
+
+    /**
+     * Credentials changed: drop the link and try again after reconnectMs
+     */
+    void rejoin(uint32_t now) {
+        _wifi          = false;
+        _lastReconnect = now;
+    }
+
+    // ============== Mute Button ==============
+
+    /**
+     * Button press (from the ISR flag); debounced toggle
+     */
+    bool button(uint32_t now) {
+        if (now - _lastButton < _t.debounceMs) return false;
+        _lastButton = now;
+        setMuted(!_muted);
+        return true;
+    }
+
+    void setMuted(bool muted) {
+        _muted = muted;
+        if (muted) {
+            _io.alarm(false);
+            _io.show(Screen::MUTED);
+        } else {
+            _io.show(Screen::UNMUTED);
+            _io.beep();
+        }
+    }
+
+    // ============== State ==============
+
+    bool     muted()         const { return _muted; }
+    bool     siteUp()        const { return _up; }
+    bool     siteSlow()      const { return _slow; }
+    bool     statusKnown()   const { return _known; }
+    bool     wifiConnected() const { return _wifi; }
+    uint32_t reconnects()    const { return _reconnects; }
+    uint32_t lastCheck()     const { return _lastCheck; }
+
+private:
+    Io&      _io;
+    Timing   _t;
+    bool     _muted         = false;
+    bool     _up            = true;
+    bool     _slow          = false;
+    bool     _known         = false;
+    bool     _wifi          = false;
+    uint32_t _lastCheck     = 0;
+    uint32_t _lastReconnect = 0;
+    uint32_t _lastButton    = 0;
+    uint32_t _reconnects    = 0;
+};
+
+#endif
@@ -0,0 +1,219 @@
+/**
+ * LED-Panel-ESP12F - MQTT 3.1.1 Packets
+ *
+ * Encoder for the handful of packets a QoS 0 publisher needs (CONNECT,
+ * PUBLISH, PINGREQ, DISCONNECT) and a byte-at-a-time reader for what the
+ * broker sends back (CONNACK, PINGRESP).
+ *
+ * - Packets are written into caller buffers; no allocation
+ * - Encoders return the packet length, or 0 if it does not fit
+ */
+
+#ifndef MQTT_PACKET_H
+#define MQTT_PACKET_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+namespace Mqtt {
+
+constexpr uint8_t  PROTOCOL_LEVEL = 4;           // 3.1.1
+constexpr uint32_t REMAINING_MAX  = 268435455;   // Four length bytes
+
+enum Type : uint8_t {
+    CONNECT    = 0x10,
+    CONNACK    = 0x20,
+    PUBLISH    = 0x30,
+    PINGREQ    = 0xC0,
+    PINGRESP   = 0xD0,
+    DISCONNECT = 0xE0
+};
+
+constexpr uint8_t CONNECT_CLEAN_SESSION = 0x02;
+constexpr uint8_t PUBLISH_RETAIN        = 0x01;
+
+/**
+ * Variable-length "remaining length"; returns bytes written (1-4)
+ */
+inline size_t encodeRemainingLength(uint32_t len, uint8_t* out) {
+    size_t n = 0;
+    do {
+        uint8_t b = len % 128;
+        len /= 128;
+        if (len > 0) b |= 0x80;
+        out[n++] = b;
+    } while (len > 0 && n < 4);
+    return n;
+}
+
+inline size_t remainingLengthSize(uint32_t len) {
+    return (len < 128) ? 1 : (len < 16384) ? 2 : (len < 2097152) ? 3 : 4;
+}
+
+// ============== Encoders ==============
+
+namespace detail {
+
+inline uint8_t* putHeader(uint8_t* p, uint8_t type, uint32_t remaining) {
+    *p++ = type;
+    return p + encodeRemainingLength(remaining, p);
+}
+
+inline uint8_t* putString(uint8_t* p, const char* s, size_t len) {
+    *p++ = static_cast<uint8_t>(len >> 8);
+    *p++ = static_cast<uint8_t>(len);
+    memcpy(p, s, len);
+    return p + len;
+}
+
+inline size_t finish(const uint8_t* start, const uint8_t* end) {
+    return static_cast<size_t>(end - start);
+}
+
+}  // namespace detail
+
+/**
+ * CONNECT with a clean session and no will, user or password
+ */
+inline size_t encodeConnect(uint8_t* buf, size_t cap, const char* clientId, uint16_t keepAliveSec) {
+    size_t idLen = strlen(clientId);
+    if (idLen > 0xFFFF) return 0;
+
+    // "MQTT" name, level, flags, keep alive, client id
+    uint32_t remaining = (2 + 4) + 1 + 1 + 2 + (2 + idLen);
+    size_t total = 1 + remainingLengthSize(remaining) + remaining;
+    if (total > cap) return 0;
+
+    uint8_t* p = detail::putHeader(buf, CONNECT, remaining);
+    p = detail::putString(p, "MQTT", 4);
+    *p++ = PROTOCOL_LEVEL;
+    *p++ = CONNECT_CLEAN_SESSION;
+    *p++ = static_cast<uint8_t>(keepAliveSec >> 8);
+    *p++ = static_cast<uint8_t>(keepAliveSec);
+    p = detail::putString(p, clientId, idLen);
+    return detail::finish(buf, p);
+}
+
+/**
+ * QoS 0 PUBLISH (no packet identifier)
+ */
+inline size_t encodePublish(uint8_t* buf, size_t cap, const char* topic,
+                            const uint8_t* payload, size_t payloadLen, bool retain) {
+    size_t topicLen = strlen(topic);
+    if (topicLen == 0 || topicLen > 0xFFFF) return 0;
+
+    uint64_t remaining = 2 + topicLen + static_cast<uint64_t>(payloadLen);
+    if (remaining > REMAINING_MAX) return 0;
+    size_t total = 1 + remainingLengthSize(static_cast<uint32_t>(remaining)) + remaining;
+    if (total > cap) return 0;
+
+    uint8_t* p = detail::putHeader(buf, PUBLISH | (retain ? PUBLISH_RETAIN : 0),
+                                   static_cast<uint32_t>(remaining));
+    p = detail::putString(p, topic, topicLen);
+    memcpy(p, payload, payloadLen);
+    return detail::finish(buf, p + payloadLen);
+}
+
+inline size_t encodePingreq(uint8_t* buf, size_t cap) {
+    if (cap < 2) return 0;
+    buf[0] = PINGREQ;
+    buf[1] = 0;
+    return 2;
+}
+
+inline size_t encodeDisconnect(uint8_t* buf, size_t cap) {
+    if (cap < 2) return 0;
+    buf[0] = DISCONNECT;
+    buf[1] = 0;
+    return 2;
+}
+
+// ============== Reader ==============
+
+/**
+ * Incremental reader for broker packets
+ *
+ * Keeps the fixed header and the first HEAD_MAX bytes of the body, which
+ * is all CONNACK and PINGRESP carry; longer bodies are skipped.
+ */
+class PacketReader {
+public:
+    static constexpr size_t HEAD_MAX = 4;
+
+    void reset() { *this = PacketReader(); }
+
+    /**
+     * Feed one byte; returns true when a whole packet has been read
+     * (check malformed() before using it)
+     */
+    bool feed(uint8_t b) {
+        if (_complete) reset();
+
+        switch (_phase) {
+            case Phase::TYPE:
+                _type  = b;
+                _phase = Phase::LENGTH;
+                return false;
+
+            case Phase::LENGTH:
+                _remaining += static_cast<uint32_t>(b & 0x7F) * _multiplier;
+                _multiplier *= 128;
+                if (b & 0x80) {
+                    if (++_lengthBytes >= 4) {
+                        _malformed = true;
+                        return finish();
+                    }
+                    return false;
+                }
+                if (_remaining == 0) return finish();
+                _phase = Phase::BODY;
+                return false;
+
+            case Phase::BODY:
+                if (_read < HEAD_MAX) _head[_read] = b;
+                if (++_read >= _remaining) return finish();
+                return false;
+        }
+        return false;
+    }
+
+    uint8_t  type()      const { return _type & 0xF0; }
+    uint8_t  flags()     const { return _type & 0x0F; }
+    uint32_t length()    const { return _remaining; }
+    bool     malformed() const { return _malformed; }
+
+    /**
+     * Body byte i (i < HEAD_MAX), 0 if not received
+     */
+    uint8_t body(size_t i) const { return (i < HEAD_MAX && i < _read) ? _head[i] : 0; }
+
+    /**
+     * CONNACK return code (0 = accepted), or -1 for any other packet
+     */
+    int connackCode() const {
+        return (type() == CONNACK && _remaining == 2) ? _head[1] : -1;
+    }
+
+private:
+    enum class Phase : uint8_t { TYPE, LENGTH, BODY };
+
+    bool finish() {
+        _complete = true;
+        return true;
+    }
+
+    Phase    _phase       = Phase::TYPE;
+    uint8_t  _type        = 0;
+    uint32_t _remaining   = 0;
+    uint32_t _multiplier  = 1;
+    uint8_t  _lengthBytes = 0;
+    uint32_t _read        = 0;
+    uint8_t  _head[HEAD_MAX] = {};
+    bool     _complete    = false;
+    bool     _malformed   = false;
+};
+
+}  // namespace Mqtt
+
+#endif
@@ -0,0 +1,209 @@
+/**
+ * LED-Panel-ESP12F - MQTT Publisher Session
+ *
+ * QoS 0 publisher driven from loop(), fed from an EventOutbox.
+ *
+ * - handle() never waits: it reads what has arrived, writes at most
+ *   FLUSH_BUDGET packets and only when the TCP send window has room
+ * - The one blocking step, the TCP connect, is only attempted when the
+ *   caller says it may block (display at rest) and at most every
+ *   RETRY_INTERVAL
+ * - Messages queued while disconnected are sent in order after CONNACK;
+ *   an entry leaves the outbox only once its whole packet was written
+ *
+ * Templated on the client so it runs against WiFiClient on the ESP8266
+ * and against a broker stand-in in unit tests.
+ *
+ * Client must provide:
+ *   int    connect(const char* host, uint16_t port);
+ *   bool   connected();
+ *   int    available();
+ *   int    read(uint8_t* buf, size_t len);
+ *   int    availableForWrite();
+ *   size_t write(const uint8_t* buf, size_t len);
+ *   void   stop();
+ */
+
+#ifndef MQTT_SESSION_H
+#define MQTT_SESSION_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "mqtt_packet.h"
+#include "event_outbox.h"
+
+template <class Client, size_t OUTBOX, size_t PAYLOAD_MAX>
+class MqttSession {
+public:
+    typedef EventOutbox<OUTBOX, PAYLOAD_MAX> Outbox;
+
+    static constexpr uint32_t RETRY_INTERVAL  = 30000;
+    static constexpr uint32_t CONNACK_TIMEOUT = 5000;
+    static constexpr uint8_t  READ_BUDGET     = 32;
+    static constexpr uint8_t  FLUSH_BUDGET    = 2;
+    static constexpr size_t   TX_MAX          = PAYLOAD_MAX + 64;   // Header + topic
+
+    enum class Phase : uint8_t { DISCONNECTED, AWAIT_CONNACK, CONNECTED };
+
+    MqttSession(Client& client, const char* host, uint16_t port,
+                const char* clientId, uint16_t keepAliveSec)
+        : _client(client), _host(host), _port(port),
+          _clientId(clientId), _keepAliveSec(keepAliveSec) {}
+
+    Outbox& outbox() { return _outbox; }
+
+    /**
+     * Queue a message; sent by a later handle()
+     */
+    bool publish(const char* topic, const char* payload, bool retain = false) {
+        return _outbox.push(topic, payload, retain);
+    }
+
+    /**
+     * Advance the session; mayBlock allows a (re)connect attempt
+     */
+    void handle(uint32_t now, bool mayBlock) {
+        if (_phase == Phase::DISCONNECTED) {
+            if (mayBlock && (!_attempted || now - _lastAttempt >= RETRY_INTERVAL)) {
+                startConnect(now);
+            }
+            return;
+        }
+
+        if (!_client.connected()) {
+            drop();
+            return;
+        }
+
+        if (!readIncoming()) return;
+
+        if (_phase == Phase::AWAIT_CONNACK) {
+            if (now - _lastAttempt >= CONNACK_TIMEOUT) drop();
+            return;
+        }
+
+        flush(now);
+        keepAlive(now);
+    }
+
+    Phase    phase()       const { return _phase; }
+    bool     isConnected() const { return _phase == Phase::CONNECTED; }
+    uint32_t published()   const { return _published; }
+    uint32_t connects()    const { return _connects; }
+    uint32_t dropped()     const { return _outbox.dropped(); }
+    int      lastRefusal() const { return _lastRefusal; }
+
+private:
+    void startConnect(uint32_t now) {
+        _attempted   = true;
+        _lastAttempt = now;
+        _reader.reset();
+
+        if (!_client.connect(_host, _port)) return;
+
+        size_t len = Mqtt::encodeConnect(_tx, sizeof(_tx), _clientId, _keepAliveSec);
+        if (len == 0 || _client.write(_tx, len) != len) {
+            _client.stop();
+            return;
+        }
+        _lastTx = now;
+        _phase  = Phase::AWAIT_CONNACK;
+    }
+
+    /**
+     * Returns false if the session was dropped
+     */
+    bool readIncoming() {
+        for (uint8_t i = 0; i < READ_BUDGET && _client.available() > 0; i++) {
+            uint8_t b;
+            if (_client.read(&b, 1) != 1) break;
+            if (!_reader.feed(b)) continue;
+
+            if (_reader.malformed()) {
+                drop();
+                return false;
+            }
+            if (_reader.type() == Mqtt::CONNACK && _phase == Phase::AWAIT_CONNACK) {
+                int rc = _reader.connackCode();
+                if (rc != 0) {
+                    _lastRefusal = rc;
+                    drop();
+                    return false;
+                }
+                _phase = Phase::CONNECTED;
+                _connects++;
+            } else if (_reader.type() == Mqtt::PINGRESP) {
+                _pingPending = false;
+            }
+        }
+        return true;
+    }
+
+    void flush(uint32_t now) {
+        for (uint8_t i = 0; i < FLUSH_BUDGET && !_outbox.empty(); i++) {
+            const typename Outbox::Entry& e = _outbox.front();
+            size_t len = Mqtt::encodePublish(_tx, sizeof(_tx), e.topic,
+                                             reinterpret_cast<const uint8_t*>(e.payload),
+                                             e.length, e.retain);
+            if (len == 0) {
+                _outbox.pop();  // Cannot ever be sent (topic too long)
+                continue;
+            }
+            int room = _client.availableForWrite();
+            if (room < 0 || static_cast<size_t>(room) < len) return;  // Try next pass
+            if (_client.write(_tx, len) != len) {
+                drop();
+                return;
+            }
+            _outbox.pop();
+            _published++;
+            _lastTx = now;
+        }
+    }
+
+    void keepAlive(uint32_t now) {
+        if (_keepAliveSec == 0) return;
+        uint32_t period = static_cast<uint32_t>(_keepAliveSec) * 1000;
+
+        if (_pingPending && now - _pingSent >= period) {
+            drop();  // Broker stopped answering
+            return;
+        }
+        if (!_pingPending && now - _lastTx >= period / 2 && _client.availableForWrite() >= 2) {
+            size_t len = Mqtt::encodePingreq(_tx, sizeof(_tx));
+            if (_client.write(_tx, len) == len) {
+                _pingPending = true;
+                _pingSent    = now;
+                _lastTx      = now;
+            }
+        }
+    }
+
+    void drop() {
+        _client.stop();
+        _phase       = Phase::DISCONNECTED;
+        _pingPending = false;
+    }
+
+    Client&     _client;
+    const char* _host;
+    uint16_t    _port;
+    const char* _clientId;
+    uint16_t    _keepAliveSec;
+
+    Outbox             _outbox;
+    Mqtt::PacketReader _reader;
+    uint8_t            _tx[TX_MAX];
+
+    Phase    _phase       = Phase::DISCONNECTED;
+    bool     _attempted   = false;
+    uint32_t _lastAttempt = 0;
+    uint32_t _lastTx      = 0;
+    bool     _pingPending = false;
+    uint32_t _pingSent    = 0;
+    uint32_t _published   = 0;
+    uint32_t _connects    = 0;
+    int      _lastRefusal = 0;
+};
+
+#endif
@@ -0,0 +1,108 @@
+/**
+ * LED-Panel-ESP12F - Post-mortem Record
+ *
+ * Small CRC-protected record kept in RTC user memory, which survives
+ * watchdog, exception and software resets (not power loss).
+ *
+ * - Last active loop section, so a watchdog reset can be attributed
+ * - Uptime and heap figures at the last update
+ * - Boot counter across resets
+ * - Sequence number of the last accepted status push, so a restart does
+ *   not reopen the replay window (include/push_message.h)
+ *
+ * The firmware rewrites the record whenever the loop enters a new
+ * section; on boot the previous record is read back and reported.
+ */
+
+#ifndef POSTMORTEM_H
+#define POSTMORTEM_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "crc32.h"
+
+namespace PostMortem {
+
+constexpr uint32_t MAGIC   = 0x504D5254;  // "PMRT"
+constexpr uint8_t  VERSION = 2;
+
+constexpr uint8_t FLAG_PUSH_SEQ = 0x01;   // pushSeq holds an accepted push
+
+enum class Section : uint8_t {
+    BOOT = 0,
+    DISPLAY,
+    BUTTON,
+    WIFI_CHECK,
+    WIFI_RECONNECT,
+    PROBE,
+    IDLE,
+    RESTART,
+    MQTT,
+    CONFIG,
+    CONSOLE,
+    PUSH,
+    HTTP_SERVER,
+    BEACON,
+    EVENTS,
+    LOG,
+    COUNT
+};
+
+inline const char* sectionName(Section s) {
+    static const char* const NAMES[] = {
+        "boot", "display", "button", "wifi_check", "wifi_reconnect", "probe", "idle", "restart",
+        "mqtt", "config", "console", "push", "http_server", "beacon", "events", "log"
+    };
+    static_assert(sizeof(NAMES) / sizeof(NAMES[0]) == static_cast<size_t>(Section::COUNT),
+                  "one name per section");
+    uint8_t i = static_cast<uint8_t>(s);
+    return (i < static_cast<uint8_t>(Section::COUNT)) ? NAMES[i] : "unknown";
+}
+
+/**
+ * Names for rst_info.reason (ESP8266 SDK rst_reason)
+ */
+inline const char* resetReasonName(uint32_t reason) {
+    static const char* const NAMES[] = {
+        "power_on", "hw_watchdog", "exception", "soft_watchdog",
+        "soft_restart", "deep_sleep_wake", "external"
+    };
+    return (reason < sizeof(NAMES) / sizeof(NAMES[0])) ? NAMES[reason] : "unknown";
+}
+
+// Record layout is a whole number of 32-bit words (RTC memory granularity)
+struct Record {
+    uint32_t magic;
+    uint8_t  version;
+    uint8_t  section;        // Section
+    uint8_t  fragmentation;  // Percent
+    uint8_t  flags;          // FLAG_*
+    uint32_t bootCount;
+    uint32_t uptimeMs;
+    uint32_t freeHeap;
+    uint32_t maxBlock;
+    uint32_t pushSeq;
+    uint32_t crc;
+};
+
+static_assert(sizeof(Record) % 4 == 0, "RTC memory is word addressed");
+
+using Crc::crc32;
+
+inline uint32_t recordCrc(const Record& r) {
+    return crc32(reinterpret_cast<const uint8_t*>(&r), offsetof(Record, crc));
+}
+
+inline void seal(Record& r) {
+    r.magic   = MAGIC;
+    r.version = VERSION;
+    r.crc     = recordCrc(r);
+}
+
+inline bool isValid(const Record& r) {
+    return r.magic == MAGIC && r.version == VERSION && r.crc == recordCrc(r);
+}
+
+}  // namespace PostMortem
+
+#endif
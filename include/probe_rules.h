@@ -0,0 +1,374 @@
+/**
+ * LED-Panel-ESP12F - Response Classification Rules
+ *
+ * Decides whether a probe response means "up", beyond the default
+ * "any response below 500". Rules are written as one line, e.g.
+ *
+ *   status=200,204,300-399; header=X-Health; body~"healthy"; body!~error;
+ *   bytes=2048; latency<1500
+ *
+ *   status=LIST      Code or lo-hi range list; default is 100-499
+ *   header=NAME      Header must be present (any case)
+ *   body~TEXT        Body must contain TEXT within the first `bytes`
+ *   body!~TEXT       Body must not contain TEXT within the first `bytes`
+ *   json.PATH=VALUE  JSON field PATH (dotted, e.g. checks.db) must equal VALUE
+ *   json.PATH!=VALUE JSON field PATH must be present and differ from VALUE
+ *   bytes=N          Body bytes examined (default 1024)
+ *   latency<MS       Response must complete within MS
+ *
+ * TEXT may be quoted to include ';' or spaces. compile() turns the line
+ * into a fixed Table; an Evaluator then checks one response in a single
+ * pass as the probe streams it (HttpProbe inspector interface), without
+ * buffering the body, and stops asking for body bytes once every pattern
+ * is decided. All body patterns share one Aho-Corasick automaton
+ * (body_matcher.h), so each body byte costs one transition; JSON fields
+ * are picked out by a streaming parser (json_fields.h) in the same pass.
+ * JSON values are compared as text: strings unquoted, numbers and
+ * true/false/null as written.
+ */
+
+#ifndef PROBE_RULES_H
+#define PROBE_RULES_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "body_matcher.h"
+#include "json_fields.h"
+
+namespace ProbeRules {
+
+constexpr uint8_t  STATUS_MAX   = 8;
+constexpr uint8_t  HEADER_MAX   = 4;
+constexpr uint8_t  NAME_MAX     = 32;     // Header name, including NUL
+constexpr uint8_t  PATTERN_MAX  = 4;
+constexpr uint8_t  PATTERN_LEN  = 32;
+constexpr uint16_t BODY_DEFAULT = 1024;
+constexpr uint16_t BODY_STATES  = PATTERN_MAX * PATTERN_LEN + 1;
+
+enum class Error : uint8_t {
+    NONE = 0,
+    UNKNOWN_CLAUSE,
+    BAD_NUMBER,
+    TOO_MANY,
+    TOO_LONG,
+    COUNT
+};
+
+inline const char* errorName(Error e) {
+    static const char* const NAMES[] = {"none", "unknown_clause", "bad_number", "too_many", "too_long"};
+    uint8_t i = static_cast<uint8_t>(e);
+    return (i < static_cast<uint8_t>(Error::COUNT)) ? NAMES[i] : "unknown";
+}
+
+/**
+ * Why a response was judged down (OK = up)
+ */
+enum class Reason : uint8_t {
+    OK = 0,
+    NO_RESPONSE,    // Connection or protocol error
+    STATUS,
+    HEADER,
+    BODY,
+    LATENCY,
+    JSON,
+    COUNT
+};
+
+inline const char* reasonName(Reason r) {
+    static const char* const NAMES[] = {"ok", "no_response", "status", "header", "body", "latency", "json"};
+    uint8_t i = static_cast<uint8_t>(r);
+    return (i < static_cast<uint8_t>(Reason::COUNT)) ? NAMES[i] : "unknown";
+}
+
+struct Range {
+    uint16_t lo;
+    uint16_t hi;
+};
+
+struct Pattern {
+    uint8_t len;
+    bool    negate;
+};
+
+struct JsonRule {
+    char expect[JsonFields::VALUE_MAX];
+    bool negate;
+};
+
+struct Table {
+    Range    status[STATUS_MAX];
+    uint8_t  statusCount = 0;          // 0 = default (100-499)
+    char     headers[HEADER_MAX][NAME_MAX];
+    uint8_t  headerCount = 0;
+    Pattern  patterns[PATTERN_MAX];    // Pattern i is bit i of the matcher
+    uint8_t  patternCount = 0;
+    BodyMatcher::Automaton<PATTERN_MAX, BODY_STATES> matcher;
+    char     jsonPaths[JsonFields::FIELD_MAX][JsonFields::PATH_MAX];
+    JsonRule json[JsonFields::FIELD_MAX];
+    uint8_t  jsonCount = 0;
+    uint16_t bodyLimit    = BODY_DEFAULT;
+    uint32_t maxLatencyMs = 0;         // 0 = no limit
+};
+
+namespace detail {
+
+inline char lower(char c) {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+}
+
+inline bool equalsNoCase(const char* a, const char* b) {
+    for (; *a && *b; ++a, ++b) {
+        if (lower(*a) != lower(*b)) return false;
+    }
+    return *a == *b;
+}
+
+inline const char* skipSpace(const char* p) {
+    while (*p == ' ' || *p == '\t') p++;
+    return p;
+}
+
+inline bool parseNumber(const char*& p, uint32_t max, uint32_t& out) {
+    if (*p < '0' || *p > '9') return false;
+    uint32_t v = 0;
+    for (; *p >= '0' && *p <= '9'; ++p) {
+        v = v * 10 + (*p - '0');
+        if (v > max) return false;
+    }
+    out = v;
+    return true;
+}
+
+/**
+ * Copy a plain or "quoted" word up to ';' into out; advances p
+ */
+inline bool parseText(const char*& p, char* out, size_t cap, size_t& len) {
+    len = 0;
+    if (*p == '"') {
+        for (++p; *p && *p != '"'; ++p) {
+            if (len + 1 >= cap) return false;
+            out[len++] = *p;
+        }
+        if (*p != '"') return false;
+        ++p;
+    } else {
+        for (; *p && *p != ';'; ++p) {
+            if (len + 1 >= cap) return false;
+            out[len++] = *p;
+        }
+        while (len > 0 && (out[len - 1] == ' ' || out[len - 1] == '\t')) len--;
+    }
+    out[len] = '\0';
+    return len > 0;
+}
+
+}  // namespace detail
+
+/**
+ * Compile a rule line into table; on error, errorAt (if given) is set to
+ * the offset of the clause at fault and table is left as the default
+ */
+inline Error compile(const char* text, Table& table, size_t* errorAt = nullptr) {
+    using namespace detail;
+    table = Table();
+    if (!text) return Error::NONE;
+
+    const char* p = text;
+    Error err = Error::NONE;
+    while (*(p = skipSpace(p))) {
+        const char* clause = p;
+        uint32_t v;
+
+        if (strncmp(p, "status=", 7) == 0) {
+            p += 7;
+            for (;;) {
+                p = skipSpace(p);
+                uint32_t lo, hi;
+                if (!parseNumber(p, 999, lo)) {
+                    err = Error::BAD_NUMBER;
+                    break;
+                }
+                hi = lo;
+                if (*p == '-') {
+                    p++;
+                    if (!parseNumber(p, 999, hi) || hi < lo) {
+                        err = Error::BAD_NUMBER;
+                        break;
+                    }
+                }
+                if (table.statusCount == STATUS_MAX) {
+                    err = Error::TOO_MANY;
+                    break;
+                }
+                table.status[table.statusCount++] = {static_cast<uint16_t>(lo), static_cast<uint16_t>(hi)};
+                p = skipSpace(p);
+                if (*p != ',') break;
+                p++;
+            }
+        } else if (strncmp(p, "header=", 7) == 0) {
+            p += 7;
+            size_t len;
+            if (table.headerCount == HEADER_MAX) {
+                err = Error::TOO_MANY;
+            } else if (!parseText(p, table.headers[table.headerCount], NAME_MAX, len)) {
+                err = Error::TOO_LONG;
+            } else {
+                table.headerCount++;
+            }
+        } else if (strncmp(p, "body~", 5) == 0 || strncmp(p, "body!~", 6) == 0) {
+            bool negate = (p[4] == '!');
+            p += negate ? 6 : 5;
+            size_t len;
+            if (table.patternCount == PATTERN_MAX) {
+                err = Error::TOO_MANY;
+            } else {
+                Pattern& pat = table.patterns[table.patternCount];
+                char buf[PATTERN_LEN + 1];
+                if (!parseText(p, buf, sizeof(buf), len) || !table.matcher.add(buf, len)) {
+                    err = Error::TOO_LONG;
+                } else {
+                    pat.len    = static_cast<uint8_t>(len);
+                    pat.negate = negate;
+                    table.patternCount++;
+                }
+            }
+        } else if (strncmp(p, "json.", 5) == 0) {
+            p += 5;
+            size_t len = 0;
+            if (table.jsonCount == JsonFields::FIELD_MAX) {
+                err = Error::TOO_MANY;
+            } else {
+                char* path = table.jsonPaths[table.jsonCount];
+                JsonRule& rule = table.json[table.jsonCount];
+                for (; *p && *p != '=' && *p != '!' && *p != ';' && *p != ' '; ++p) {
+                    if (len + 1 >= JsonFields::PATH_MAX) break;
+                    path[len++] = *p;
+                }
+                path[len] = '\0';
+                rule.negate = (*p == '!');
+                if (rule.negate) p++;
+                if (len == 0 || *p != '=') {
+                    err = (len + 1 >= JsonFields::PATH_MAX) ? Error::TOO_LONG : Error::UNKNOWN_CLAUSE;
+                } else if (!parseText(++p, rule.expect, sizeof(rule.expect), len)) {
+                    err = Error::TOO_LONG;
+                } else {
+                    table.jsonCount++;
+                }
+            }
+        } else if (strncmp(p, "bytes=", 6) == 0) {
+            p += 6;
+            if (!parseNumber(p, 0xFFFF, v) || v == 0) err = Error::BAD_NUMBER;
+            else table.bodyLimit = static_cast<uint16_t>(v);
+        } else if (strncmp(p, "latency<", 8) == 0) {
+            p += 8;
+            if (!parseNumber(p, 600000, v) || v == 0) err = Error::BAD_NUMBER;
+            else table.maxLatencyMs = v;
+        } else {
+            err = Error::UNKNOWN_CLAUSE;
+        }
+
+        p = skipSpace(p);
+        if (err == Error::NONE && *p && *p != ';') err = Error::UNKNOWN_CLAUSE;
+        if (err != Error::NONE) {
+            if (errorAt) *errorAt = static_cast<size_t>(clause - text);
+            table = Table();
+            return err;
+        }
+        if (*p == ';') p++;
+    }
+    table.matcher.build();
+    return Error::NONE;
+}
+
+/**
+ * Judges one response against a Table as it streams past; doubles as the
+ * HttpProbe inspector (begin / header / wantBody / body)
+ */
+class Evaluator {
+public:
+    explicit Evaluator(const Table& table) : _t(table) { begin(); }
+
+    void begin() {
+        _headersSeen = 0;
+        _bodyBytes   = 0;
+        _scan        = BodyMatcher::Scan();
+        _json.begin(_t.jsonPaths, _t.jsonCount, _values);
+    }
+
+    void header(const char* name, const char* value) {
+        for (uint8_t i = 0; i < _t.headerCount; i++) {
+            if (detail::equalsNoCase(name, _t.headers[i])) _headersSeen |= 1 << i;
+        }
+    }
+
+    /**
+     * Only read the body if there is a body rule and the status passes
+     */
+    bool wantBody(int status) const {
+        return (_t.patternCount > 0 || _t.jsonCount > 0) && statusOk(status);
+    }
+
+    /**
+     * Scan payload bytes; false once nothing more is needed
+     */
+    bool body(const uint8_t* data, size_t len) {
+        size_t left = _t.bodyLimit - _bodyBytes;
+        if (len > left) len = left;
+        size_t scanned = _t.matcher.feed(_scan, data, len);
+        size_t parsed  = _json.feed(data, len);
+        _bodyBytes += static_cast<uint16_t>((scanned > parsed) ? scanned : parsed);
+        return !(_t.matcher.done(_scan) && _json.done()) && _bodyBytes < _t.bodyLimit;
+    }
+
+    /**
+     * Final decision once the probe is over (code < 0 = probe error)
+     */
+    Reason verdict(int code, uint32_t latencyMs) const {
+        if (code < 0) return Reason::NO_RESPONSE;
+
+        if (!statusOk(code)) return Reason::STATUS;
+
+        if (_headersSeen != static_cast<uint8_t>((1 << _t.headerCount) - 1)) return Reason::HEADER;
+
+        for (uint8_t i = 0; i < _t.patternCount; i++) {
+            bool found = _scan.found & (1 << i);
+            if (found == _t.patterns[i].negate) return Reason::BODY;
+        }
+
+        for (uint8_t i = 0; i < _t.jsonCount; i++) {
+            const JsonFields::Value& v = _values[i];
+            if (!v.found || v.equals(_t.json[i].expect) == _t.json[i].negate) return Reason::JSON;
+        }
+
+        if (_t.maxLatencyMs && latencyMs > _t.maxLatencyMs) return Reason::LATENCY;
+        return Reason::OK;
+    }
+
+    uint16_t bodyBytes() const { return _bodyBytes; }
+
+    /**
+     * JSON field i as captured from the last response (found = false if absent)
+     */
+    const JsonFields::Value& jsonValue(uint8_t i) const { return _values[i]; }
+
+private:
+    bool statusOk(int code) const {
+        if (_t.statusCount == 0) return code >= 100 && code < 500;
+        for (uint8_t i = 0; i < _t.statusCount; i++) {
+            if (code >= _t.status[i].lo && code <= _t.status[i].hi) return true;
+        }
+        return false;
+    }
+
+    const Table&       _t;
+    uint8_t            _headersSeen = 0;
+    uint16_t           _bodyBytes   = 0;
+    BodyMatcher::Scan  _scan;
+    JsonFields::Parser _json;
+    JsonFields::Value  _values[JsonFields::FIELD_MAX];
+};
+
+}  // namespace ProbeRules
+
+#endif
@@ -0,0 +1,109 @@
+/**
+ * LED-Panel-ESP12F - Probe Statistics
+ *
+ * Counters, failure classes, a latency histogram and a ring of recent
+ * latencies for site checks. Fixed size, no allocation.
+ */
+
+#ifndef PROBE_STATS_H
+#define PROBE_STATS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include "http_probe.h"
+
+enum class FailureClass : uint8_t {
+    CONNECT = 0,   // DNS, TCP or TLS connect failed
+    TIMEOUT,       // No response within HTTP_TIMEOUT
+    PROTOCOL,      // Not HTTP, or connection dropped mid-response
+    HTTP_5XX,      // Server answered with an error
+    OTHER,
+    COUNT
+};
+
+inline const char* failureClassName(FailureClass c) {
+    static const char* const NAMES[] = {"connect", "timeout", "protocol", "http_5xx", "other"};
+    uint8_t i = static_cast<uint8_t>(c);
+    return (i < static_cast<uint8_t>(FailureClass::COUNT)) ? NAMES[i] : "other";
+}
+
+inline FailureClass classifyFailure(int code) {
+    switch (code) {
+        case HttpProbe::ERR_CONNECTION_FAILED: return FailureClass::CONNECT;
+        case HttpProbe::ERR_READ_TIMEOUT:      return FailureClass::TIMEOUT;
+        case HttpProbe::ERR_NO_HTTP_SERVER:
+        case HttpProbe::ERR_CONNECTION_LOST:   return FailureClass::PROTOCOL;
+        default:
+            return (code >= 500) ? FailureClass::HTTP_5XX : FailureClass::OTHER;
+    }
+}
+
+// Latency histogram upper bounds in ms (last bucket is +Inf)
+constexpr uint32_t LATENCY_BUCKETS_MS[] = {100, 250, 500, 1000, 2500, 5000};
+constexpr size_t   LATENCY_BUCKET_COUNT = sizeof(LATENCY_BUCKETS_MS) / sizeof(LATENCY_BUCKETS_MS[0]);
+
+template <size_t N>
+class ProbeStats {
+public:
+    void record(int code, bool up, uint32_t latencyMs) {
+        _latency[_head] = latencyMs;
+        _head = (_head + 1) % N;
+        if (_count < N) _count++;
+
+        _checks++;
+        if (!up) {
+            _failures++;
+            _failuresByClass[static_cast<uint8_t>(classifyFailure(code))]++;
+        }
+        _lastCode    = code;
+        _lastLatency = latencyMs;
+
+        size_t b = 0;
+        while (b < LATENCY_BUCKET_COUNT && latencyMs > LATENCY_BUCKETS_MS[b]) b++;
+        _buckets[b]++;
+        _latencySumMs += latencyMs;
+    }
+
+    uint32_t checks()      const { return _checks; }
+    uint32_t failures()    const { return _failures; }
+    int      lastCode()    const { return _lastCode; }
+    uint32_t lastLatency() const { return _lastLatency; }
+    size_t   count()       const { return _count; }
+
+    uint32_t failures(FailureClass c) const {
+        return _failuresByClass[static_cast<uint8_t>(c)];
+    }
+
+    /**
+     * Cumulative count for bucket i (i == LATENCY_BUCKET_COUNT is +Inf)
+     */
+    uint32_t bucketCumulative(size_t i) const {
+        uint32_t total = 0;
+        for (size_t b = 0; b <= i && b <= LATENCY_BUCKET_COUNT; b++) total += _buckets[b];
+        return total;
+    }
+
+    uint64_t latencySumMs() const { return _latencySumMs; }
+
+    /**
+     * Latency i in chronological order (0 = oldest kept)
+     */
+    uint32_t latency(size_t i) const {
+        size_t start = (_count < N) ? 0 : _head;
+        return _latency[(start + i) % N];
+    }
+
+private:
+    uint32_t _latency[N] = {};
+    size_t   _head        = 0;
+    size_t   _count       = 0;
+    uint32_t _checks      = 0;
+    uint32_t _failures    = 0;
+    int      _lastCode    = 0;
+    uint32_t _lastLatency = 0;
+    uint32_t _failuresByClass[static_cast<uint8_t>(FailureClass::COUNT)] = {};
+    uint32_t _buckets[LATENCY_BUCKET_COUNT + 1] = {};
+    uint64_t _latencySumMs = 0;
+};
+
+#endif
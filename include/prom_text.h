@@ -0,0 +1,97 @@
+/**
+ * LED-Panel-ESP12F - Prometheus Text Writer
+ *
+ * Appends Prometheus text exposition format (0.0.4) to a fixed buffer.
+ *
+ * - No allocation; output is truncated cleanly if the buffer is full
+ *   (overflowed() reports it, length() never exceeds capacity - 1)
+ * - Integer values only; millisecond sums are printed as seconds
+ */
+
+#ifndef PROM_TEXT_H
+#define PROM_TEXT_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdarg.h>
+
+class PromText {
+public:
+    PromText(char* buf, size_t cap) : _buf(buf), _cap(cap) {
+        if (_cap) _buf[0] = '\0';
+    }
+
+    /**
+     * # HELP and # TYPE lines for a metric family
+     */
+    void family(const char* name, const char* type, const char* help) {
+        append("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+    }
+
+    void sample(const char* name, uint32_t value) {
+        append("%s %lu\n", name, static_cast<unsigned long>(value));
+    }
+
+    void sample(const char* name, int32_t value) {
+        append("%s %ld\n", name, static_cast<long>(value));
+    }
+
+    /**
+     * Sample with one label: name{label="value"} v
+     */
+    void sample(const char* name, const char* label, const char* labelValue, uint32_t value) {
+        append("%s{%s=\"%s\"} %lu\n", name, label, labelValue, static_cast<unsigned long>(value));
+    }
+
+    /**
+     * Milliseconds written as seconds with three decimals
+     */
+    void sampleSeconds(const char* name, uint64_t ms) {
+        append("%s %lu.%03u\n", name, static_cast<unsigned long>(ms / 1000),
+               static_cast<unsigned>(ms % 1000));
+    }
+
+    /**
+     * Histogram bucket; leMs == UINT32_MAX renders le="+Inf"
+     */
+    void bucket(const char* name, uint32_t leMs, uint32_t count) {
+        if (leMs == UINT32_MAX) {
+            append("%s_bucket{le=\"+Inf\"} %lu\n", name, static_cast<unsigned long>(count));
+        } else {
+            append("%s_bucket{le=\"%lu.%03u\"} %lu\n", name,
+                   static_cast<unsigned long>(leMs / 1000), static_cast<unsigned>(leMs % 1000),
+                   static_cast<unsigned long>(count));
+        }
+    }
+
+    size_t length()     const { return _len; }
+    bool   overflowed() const { return _overflow; }
+
+private:
+    void append(const char* fmt, ...) {
+        if (_overflow || _len + 1 >= _cap) {
+            _overflow = true;
+            return;
+        }
+        va_list args;
+        va_start(args, fmt);
+        int n = vsnprintf(_buf + _len, _cap - _len, fmt, args);
+        va_end(args);
+
+        if (n < 0 || static_cast<size_t>(n) >= _cap - _len) {
+            // Drop the partial line so the output stays well-formed
+            _buf[_len] = '\0';
+            _overflow = true;
+            return;
+        }
+        _len += n;
+    }
+
+    char*  _buf;
+    size_t _cap;
+    size_t _len      = 0;
+    bool   _overflow = false;
+};
+
+#endif
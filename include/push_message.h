@@ -0,0 +1,215 @@
+/**
+ * LED-Panel-ESP12F - Signed Status Push
+ *
+ * Status pushed by the monitoring system, over UDP or as an HTTP POST
+ * body. Both carry the same form-encoded text:
+ *
+ *   v=1&seq=1700000123&up=0&code=503&mac=3f2a9c0d11e84b76
+ *
+ * - mac is SipHash-2-4 of every byte before "&mac=", as 16 hex digits,
+ *   under the shared PUSH_KEY
+ * - seq must increase with every push (a Unix timestamp works); anything
+ *   not newer than the last accepted push is a replay. The firmware keeps
+ *   the last accepted seq in RTC memory and restore()s it after a reset;
+ *   only a power cut forgets it
+ * - code is optional; unknown fields are ignored but still signed
+ *
+ * Parsing works in place on the received bytes; nothing is allocated.
+ */
+
+#ifndef PUSH_MESSAGE_H
+#define PUSH_MESSAGE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "siphash.h"
+
+namespace Push {
+
+constexpr size_t  MESSAGE_MAX = 160;
+constexpr uint8_t VERSION     = 1;
+constexpr size_t  MAC_DIGITS  = 16;
+
+enum class Result : uint8_t {
+    OK = 0,
+    MALFORMED,
+    BAD_MAC,
+    REPLAY,
+    COUNT
+};
+
+inline const char* resultName(Result r) {
+    static const char* const NAMES[] = {"ok", "malformed", "bad_mac", "replay"};
+    uint8_t i = static_cast<uint8_t>(r);
+    return (i < static_cast<uint8_t>(Result::COUNT)) ? NAMES[i] : "unknown";
+}
+
+struct Status {
+    uint32_t seq;
+    bool     up;
+    int16_t  code;    // 0 if not given
+};
+
+namespace detail {
+
+inline int hexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    return -1;
+}
+
+/**
+ * Unsigned decimal in [p, end); false if empty, not a number or too big
+ */
+inline bool parseUnsigned(const char* p, const char* end, uint32_t& out) {
+    if (p == end) return false;
+    uint64_t v = 0;
+    for (; p < end; ++p) {
+        if (*p < '0' || *p > '9') return false;
+        v = v * 10 + (*p - '0');
+        if (v > UINT32_MAX) return false;
+    }
+    out = static_cast<uint32_t>(v);
+    return true;
+}
+
+inline bool keyIs(const char* key, const char* keyEnd, const char* name) {
+    size_t len = strlen(name);
+    return static_cast<size_t>(keyEnd - key) == len && memcmp(key, name, len) == 0;
+}
+
+}  // namespace detail
+
+/**
+ * Parse the "key=value&..." fields (the signed part only)
+ */
+inline bool parseFields(const char* text, size_t len, Status& s) {
+    bool haveVersion = false, haveSeq = false, haveUp = false;
+    s.code = 0;
+
+    const char* end = text + len;
+    const char* p   = text;
+    while (p < end) {
+        const char* amp = static_cast<const char*>(memchr(p, '&', end - p));
+        const char* fieldEnd = amp ? amp : end;
+        const char* eq = static_cast<const char*>(memchr(p, '=', fieldEnd - p));
+        if (!eq) return false;
+        const char* value = eq + 1;
+
+        uint32_t v = 0;
+        if (detail::keyIs(p, eq, "v")) {
+            if (!detail::parseUnsigned(value, fieldEnd, v) || v != VERSION) return false;
+            haveVersion = true;
+        } else if (detail::keyIs(p, eq, "seq")) {
+            if (!detail::parseUnsigned(value, fieldEnd, s.seq)) return false;
+            haveSeq = true;
+        } else if (detail::keyIs(p, eq, "up")) {
+            if (fieldEnd - value != 1 || (*value != '0' && *value != '1')) return false;
+            s.up   = (*value == '1');
+            haveUp = true;
+        } else if (detail::keyIs(p, eq, "code")) {
+            bool negative = (value < fieldEnd && *value == '-');
+            if (!detail::parseUnsigned(value + (negative ? 1 : 0), fieldEnd, v) || v > 32767) {
+                return false;
+            }
+            s.code = static_cast<int16_t>(negative ? -static_cast<int32_t>(v) : static_cast<int32_t>(v));
+        }
+        p = amp ? amp + 1 : end;
+    }
+    return haveVersion && haveSeq && haveUp;
+}
+
+/**
+ * Key from 32 hex digits; false if the text is not exactly that
+ */
+inline bool parseKey(const char* keyHex, uint8_t key[SipHash::KEY_SIZE]) {
+    if (strlen(keyHex) != 2 * SipHash::KEY_SIZE) return false;
+    for (size_t i = 0; i < SipHash::KEY_SIZE; i++) {
+        int hi = detail::hexValue(keyHex[2 * i]);
+        int lo = detail::hexValue(keyHex[2 * i + 1]);
+        if (hi < 0 || lo < 0) return false;
+        key[i] = static_cast<uint8_t>((hi << 4) | lo);
+    }
+    return true;
+}
+
+/**
+ * Checks MACs and sequence numbers for incoming pushes
+ */
+class Verifier {
+public:
+    /**
+     * Key as 32 hex digits; false (and every push rejected) if invalid
+     */
+    bool begin(const char* keyHex) {
+        _ready = parseKey(keyHex, _key);
+        return _ready;
+    }
+
+    Result verify(const char* msg, size_t len, Status& s) {
+        Result r = check(msg, len, s);
+        _counts[static_cast<uint8_t>(r)]++;
+        if (r == Result::OK) {
+            _lastSeq = s.seq;
+            _haveSeq = true;
+        }
+        return r;
+    }
+
+    /**
+     * Carry the last accepted seq over from before a restart
+     */
+    void restore(uint32_t lastSeq) {
+        _lastSeq = lastSeq;
+        _haveSeq = true;
+    }
+
+    uint32_t lastSeq() const { return _lastSeq; }
+    bool     haveSeq() const { return _haveSeq; }
+    uint32_t count(Result r) const { return _counts[static_cast<uint8_t>(r)]; }
+
+private:
+    Result check(const char* msg, size_t len, Status& s) const {
+        if (!_ready || len > MESSAGE_MAX) return Result::MALFORMED;
+
+        // Tolerate a trailing newline from curl or netcat
+        while (len > 0 && (msg[len - 1] == '\n' || msg[len - 1] == '\r')) len--;
+
+        static const char MAC_FIELD[] = "&mac=";
+        const size_t fieldLen = sizeof(MAC_FIELD) - 1;
+        if (len < fieldLen + MAC_DIGITS) return Result::MALFORMED;
+        size_t signedLen = len - fieldLen - MAC_DIGITS;
+        if (memcmp(msg + signedLen, MAC_FIELD, fieldLen) != 0) return Result::MALFORMED;
+
+        uint64_t given = 0;
+        const char* hex = msg + signedLen + fieldLen;
+        for (size_t i = 0; i < MAC_DIGITS; i++) {
+            int d = detail::hexValue(hex[i]);
+            if (d < 0) return Result::MALFORMED;
+            given = (given << 4) | static_cast<uint64_t>(d);
+        }
+
+        // Authenticate before looking at any field
+        uint64_t expected = SipHash::hash(_key, reinterpret_cast<const uint8_t*>(msg), signedLen);
+        uint64_t diff = given ^ expected;   // Compare without an early exit
+        uint8_t  acc  = 0;
+        for (int i = 0; i < 8; i++) acc |= static_cast<uint8_t>(diff >> (8 * i));
+        if (acc != 0) return Result::BAD_MAC;
+
+        if (!parseFields(msg, signedLen, s)) return Result::MALFORMED;
+        if (_haveSeq && s.seq <= _lastSeq) return Result::REPLAY;
+        return Result::OK;
+    }
+
+    uint8_t  _key[SipHash::KEY_SIZE] = {};
+    bool     _ready   = false;
+    bool     _haveSeq = false;
+    uint32_t _lastSeq = 0;
+    uint32_t _counts[static_cast<uint8_t>(Result::COUNT)] = {};
+};
+
+}  // namespace Push
+
+#endif
@@ -0,0 +1,181 @@
+/**
+ * LED-Panel-ESP12F - Redirect Shortcut Cache
+ *
+ * A site behind http->https or apex->www redirects costs a connection,
+ * often a full TLS handshake, per hop on every check. The cache remembers
+ * where each target's chain ended and later checks go there directly:
+ *
+ * - A chain from the configured URL that took at least one redirect and
+ *   ended in a 2xx/3xx answer is remembered: the final URL, the hops and
+ *   the time they took
+ * - Checks start at the final URL until the entry is revalidateMs old;
+ *   then one check walks the chain from the configured URL again, which
+ *   refreshes the entry, or drops it if the redirects are gone
+ * - If the direct request fails (error or status >= 400) the entry is
+ *   dropped and the same check walks the chain from the start, so a stale
+ *   shortcut never decides a check on its own
+ * - The result's redirectMs covers everything before the final request,
+ *   a failed direct attempt included, so callers can time the final
+ *   request alone and judge every check on the same footing
+ * - Counters: checks sent direct, chains walked, hops followed and
+ *   skipped, and time saved (what the skipped hops took when last walked)
+ *
+ * Targets are keyed by the CRC-32 of the configured URL; with N entries
+ * the least recently used one is replaced. Nothing is allocated.
+ *
+ *   RedirectCache::Cache<1> redirects(RedirectCache::REVALIDATE_MS);
+ *   HttpProbe::ProbeResult r = redirects.probe(url, arena, timeoutMs, env, rules);
+ */
+
+#ifndef REDIRECT_CACHE_H
+#define REDIRECT_CACHE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "crc32.h"
+#include "http_probe.h"
+
+namespace RedirectCache {
+
+constexpr uint32_t REVALIDATE_MS = 3600000;   // Walk the chain again hourly
+
+struct Stats {
+    uint32_t direct        = 0;   // Checks that started at a remembered URL
+    uint32_t chains        = 0;   // Checks that started at the configured URL
+    uint32_t revalidations = 0;   // Chains walked because an entry was due
+    uint32_t dropped       = 0;   // Entries given up: direct failure or chain gone
+    uint32_t hopsFollowed  = 0;
+    uint32_t hopsSkipped   = 0;
+    uint32_t savedMs       = 0;
+};
+
+inline uint32_t keyOf(const char* url) {
+    return Crc::crc32(reinterpret_cast<const uint8_t*>(url), strlen(url));
+}
+
+/**
+ * A response worth going back to directly
+ */
+inline bool answered(int code) {
+    return code >= 200 && code < 400;
+}
+
+template <uint8_t N>
+class Cache {
+public:
+    struct Entry {
+        bool           used      = false;
+        uint32_t       key       = 0;
+        HttpProbe::Url url;              // Where the chain ended
+        uint8_t        hops      = 0;
+        uint32_t       hopMs     = 0;    // What the hops took when last walked
+        uint32_t       learnedAt = 0;
+        uint32_t       usedAt    = 0;
+    };
+
+    explicit Cache(uint32_t revalidateMs = REVALIDATE_MS) : _revalidateMs(revalidateMs) {}
+
+    /**
+     * Probe urlText, starting at its remembered final URL when there is one
+     */
+    template <class Env, class Inspector>
+    HttpProbe::ProbeResult probe(const char* urlText, HttpProbe::ProbeArena& arena,
+                                 uint32_t timeoutMs, Env& env, Inspector& inspector) {
+        uint32_t key = keyOf(urlText);
+        uint32_t now = env.now();
+        Entry*   e   = find(key);
+        _lastDirect  = false;
+        uint32_t failedMs = 0;   // A direct attempt that did not answer
+
+        if (e && now - e->learnedAt < _revalidateMs) {
+            arena.url = e->url;
+            e->usedAt = now;
+            HttpProbe::ProbeResult r = HttpProbe::follow(arena, timeoutMs, env, inspector);
+            _stats.hopsFollowed += r.redirects;
+            if (answered(r.code)) {
+                _stats.direct++;
+                _stats.hopsSkipped += e->hops;
+                _stats.savedMs     += e->hopMs;
+                if (r.redirects > 0) {
+                    // The final URL has moved on; remember the new end
+                    e->url    = arena.url;
+                    e->hops  += r.redirects;
+                    e->hopMs += r.redirectMs;
+                }
+                _lastDirect = true;
+                return r;
+            }
+            failedMs = env.now() - now;
+            drop(*e);
+            e = nullptr;
+        } else if (e) {
+            _stats.revalidations++;
+        }
+
+        _stats.chains++;
+        HttpProbe::ProbeResult r = HttpProbe::probe(urlText, arena, timeoutMs, env, inspector);
+        _stats.hopsFollowed += r.redirects;
+        if (r.redirects > 0 && answered(r.code)) {
+            learn(e ? *e : slot(), key, arena.url, r, now);
+        } else if (e) {
+            drop(*e);
+        }
+        r.redirectMs += failedMs;
+        return r;
+    }
+
+    /**
+     * Remembered final URL for urlText, or nullptr
+     */
+    const Entry* entry(const char* urlText) const {
+        return const_cast<Cache*>(this)->find(keyOf(urlText));
+    }
+
+    bool         lastDirect()   const { return _lastDirect; }
+    const Stats& stats()        const { return _stats; }
+    uint32_t     revalidateMs() const { return _revalidateMs; }
+
+private:
+    Entry* find(uint32_t key) {
+        for (uint8_t i = 0; i < N; i++) {
+            if (_entries[i].used && _entries[i].key == key) return &_entries[i];
+        }
+        return nullptr;
+    }
+
+    // A free entry, else the least recently used
+    Entry& slot() {
+        Entry* oldest = &_entries[0];
+        for (uint8_t i = 0; i < N; i++) {
+            if (!_entries[i].used) return _entries[i];
+            if (_entries[i].usedAt - oldest->usedAt > 0x80000000u) oldest = &_entries[i];
+        }
+        return *oldest;
+    }
+
+    void learn(Entry& e, uint32_t key, const HttpProbe::Url& url,
+               const HttpProbe::ProbeResult& r, uint32_t now) {
+        e.used      = true;
+        e.key       = key;
+        e.url       = url;
+        e.hops      = r.redirects;
+        e.hopMs     = r.redirectMs;
+        e.learnedAt = now;
+        e.usedAt    = now;
+    }
+
+    void drop(Entry& e) {
+        e.used = false;
+        _stats.dropped++;
+    }
+
+    Entry    _entries[N];
+    uint32_t _revalidateMs;
+    Stats    _stats;
+    bool     _lastDirect = false;
+};
+
+}  // namespace RedirectCache
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * LED-Panel-ESP12F - HTTP Request Line Reader
+ *
+ * Incremental parser for "METHOD /path?query HTTP/1.x", fed one byte at
+ * a time as data arrives. Fixed buffers; overlong requests fail.
+ *
+ * Header lines after the request line are skipped until the blank line
+ * that ends the head; only Content-Length is picked out (for POST bodies).
+ */
+
+#ifndef REQUEST_LINE_H
+#define REQUEST_LINE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class RequestLine {
+public:
+    static constexpr size_t METHOD_MAX = 8;
+    static constexpr size_t TARGET_MAX = 96;
+    static constexpr size_t HEADER_MAX = 24;   // Enough for "Content-Length: 1234567"
+
+    enum class Phase : uint8_t { REQUEST_LINE, HEADERS, DONE, FAILED };
+
+    void reset() {
+        _phase     = Phase::REQUEST_LINE;
+        _len       = 0;
+        _lineLen   = 0;
+        _method[0] = '\0';
+        _path[0]   = '\0';
+        _query     = nullptr;
+        _contentLength = -1;
+    }
+
+    /**
+     * Feed one byte; returns false once parsing is finished or failed
+     */
+    bool feed(char c) {
+        if (_phase == Phase::DONE || _phase == Phase::FAILED) return false;
+
+        if (_phase == Phase::HEADERS) {
+            // Blank line ends the head; other lines are only kept far
+            // enough to spot Content-Length
+            if (c == '\n') {
+                if (_lineLen == 0) {
+                    _phase = Phase::DONE;
+                } else {
+                    _header[(_lineLen < HEADER_MAX) ? _lineLen : HEADER_MAX - 1] = '\0';
+                    onHeader();
+                }
+                _lineLen = 0;
+            } else if (c != '\r') {
+                if (_lineLen < HEADER_MAX - 1) _header[_lineLen] = c;
+                _lineLen++;
+            }
+            return _phase != Phase::DONE;
+        }
+
+        if (c == '\n') {
+            _line[_len] = '\0';
+            parse();
+            return _phase != Phase::FAILED;
+        }
+        if (c == '\r') return true;
+        if (_len >= sizeof(_line) - 1) {
+            _phase = Phase::FAILED;
+            return false;
+        }
+        _line[_len++] = c;
+        return true;
+    }
+
+    Phase       phase()  const { return _phase; }
+    bool        done()   const { return _phase == Phase::DONE; }
+    bool        failed() const { return _phase == Phase::FAILED; }
+    const char* method() const { return _method; }
+    const char* path()   const { return _path; }
+    const char* query()  const { return _query ? _query : ""; }
+    int32_t     contentLength() const { return _contentLength; }   // -1 if absent
+
+    bool isMethod(const char* m) const { return strcmp(_method, m) == 0; }
+    bool isPath(const char* p)   const { return strcmp(_path, p) == 0; }
+
+private:
+    void onHeader() {
+        static const char NAME[] = "content-length:";
+        for (size_t i = 0; i < sizeof(NAME) - 1; i++) {
+            char h = _header[i];
+            if (h >= 'A' && h <= 'Z') h += 'a' - 'A';
+            if (h != NAME[i]) return;
+        }
+        const char* v = _header + sizeof(NAME) - 1;
+        while (*v == ' ' || *v == '\t') v++;
+        int32_t len = 0;
+        for (; *v >= '0' && *v <= '9'; ++v) {
+            if (len > (INT32_MAX - 9) / 10) break;
+            len = len * 10 + (*v - '0');
+        }
+        _contentLength = len;
+    }
+
+    void parse() {
+        char* sp1 = strchr(_line, ' ');
+        char* sp2 = sp1 ? strchr(sp1 + 1, ' ') : nullptr;
+        size_t methodLen = sp1 ? static_cast<size_t>(sp1 - _line) : 0;
+        if (!sp2 || methodLen == 0 || methodLen >= METHOD_MAX || sp1[1] != '/' ||
+            strncmp(sp2 + 1, "HTTP/1.", 7) != 0) {
+            _phase = Phase::FAILED;
+            return;
+        }
+
+        memcpy(_method, _line, methodLen);
+        _method[methodLen] = '\0';
+
+        size_t targetLen = sp2 - (sp1 + 1);
+        if (targetLen >= TARGET_MAX) {
+            _phase = Phase::FAILED;
+            return;
+        }
+        memcpy(_path, sp1 + 1, targetLen);
+        _path[targetLen] = '\0';
+
+        char* q = strchr(_path, '?');
+        if (q) {
+            *q = '\0';
+            _query = q + 1;
+        }
+
+        _lineLen = 0;
+        _phase   = Phase::HEADERS;
+    }
+
+    Phase       _phase = Phase::REQUEST_LINE;
+    char        _line[METHOD_MAX + TARGET_MAX + 12];
+    size_t      _len     = 0;
+    size_t      _lineLen = 0;
+    char        _method[METHOD_MAX];
+    char        _path[TARGET_MAX];
+    const char* _query = nullptr;
+    char        _header[HEADER_MAX];
+    int32_t     _contentLength = -1;
+};
+
+#endif
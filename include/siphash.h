@@ -0,0 +1,73 @@
+/**
+ * LED-Panel-ESP12F - SipHash-2-4
+ *
+ * 64-bit keyed MAC (Aumasson and Bernstein) used to authenticate status
+ * pushes. Short inputs, 128-bit key, no allocation, no tables.
+ */
+
+#ifndef SIPHASH_H
+#define SIPHASH_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace SipHash {
+
+constexpr size_t KEY_SIZE = 16;
+
+namespace detail {
+
+inline uint64_t rotl(uint64_t x, int b) {
+    return (x << b) | (x >> (64 - b));
+}
+
+inline uint64_t load64(const uint8_t* p) {
+    uint64_t v = 0;
+    for (int i = 7; i >= 0; i--) v = (v << 8) | p[i];
+    return v;
+}
+
+inline void sipRound(uint64_t& v0, uint64_t& v1, uint64_t& v2, uint64_t& v3) {
+    v0 += v1; v1 = rotl(v1, 13); v1 ^= v0; v0 = rotl(v0, 32);
+    v2 += v3; v3 = rotl(v3, 16); v3 ^= v2;
+    v0 += v3; v3 = rotl(v3, 21); v3 ^= v0;
+    v2 += v1; v1 = rotl(v1, 17); v1 ^= v2; v2 = rotl(v2, 32);
+}
+
+}  // namespace detail
+
+inline uint64_t hash(const uint8_t key[KEY_SIZE], const uint8_t* data, size_t len) {
+    uint64_t k0 = detail::load64(key);
+    uint64_t k1 = detail::load64(key + 8);
+    uint64_t v0 = 0x736f6d6570736575ULL ^ k0;
+    uint64_t v1 = 0x646f72616e646f6dULL ^ k1;
+    uint64_t v2 = 0x6c7967656e657261ULL ^ k0;
+    uint64_t v3 = 0x7465646279746573ULL ^ k1;
+
+    size_t whole = len & ~static_cast<size_t>(7);
+    for (size_t i = 0; i < whole; i += 8) {
+        uint64_t m = detail::load64(data + i);
+        v3 ^= m;
+        detail::sipRound(v0, v1, v2, v3);
+        detail::sipRound(v0, v1, v2, v3);
+        v0 ^= m;
+    }
+
+    // Last block: remaining bytes plus the length in the top byte
+    uint64_t b = static_cast<uint64_t>(len) << 56;
+    for (size_t i = 0; i < (len & 7); i++) {
+        b |= static_cast<uint64_t>(data[whole + i]) << (8 * i);
+    }
+    v3 ^= b;
+    detail::sipRound(v0, v1, v2, v3);
+    detail::sipRound(v0, v1, v2, v3);
+    v0 ^= b;
+
+    v2 ^= 0xFF;
+    for (int i = 0; i < 4; i++) detail::sipRound(v0, v1, v2, v3);
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+}  // namespace SipHash
+
+#endif
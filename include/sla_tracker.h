@@ -0,0 +1,197 @@
+/**
+ * LED-Panel-ESP12F - Rolling SLA Windows
+ *
+ * Availability, incident count, MTTR and MTBF over the last hour, day and
+ * week, kept as bucketed time counters rather than individual samples.
+ *
+ * - Time between two check results is credited to the state the earlier
+ *   one reported (up or down); time while the status is unknown (no WiFi,
+ *   before the first check) is left out of the ratio
+ * - Each window is a ring of buckets of whole seconds; the current bucket
+ *   fills, then the oldest is dropped. A window covers its full span plus
+ *   the part of the current bucket filled so far.
+ * - Updates are constant time (a gap longer than the window only clears
+ *   it); reads are constant time from running sums
+ * - MTTR = downtime / incidents and MTBF = uptime / incidents within the
+ *   window, where an incident is an up -> down transition
+ *
+ * RAM: 67 buckets x 6 bytes plus sums, about 450 bytes in total.
+ */
+
+#ifndef SLA_TRACKER_H
+#define SLA_TRACKER_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+namespace Sla {
+
+enum class Window : uint8_t {
+    HOUR = 0,
+    DAY,
+    WEEK,
+    COUNT
+};
+
+inline const char* windowName(Window w) {
+    static const char* const NAMES[] = {"1h", "24h", "7d"};
+    uint8_t i = static_cast<uint8_t>(w);
+    return (i < static_cast<uint8_t>(Window::COUNT)) ? NAMES[i] : "?";
+}
+
+enum class State : uint8_t { UNKNOWN, UP, DOWN };
+
+struct Summary {
+    uint32_t upS       = 0;
+    uint32_t downS     = 0;
+    uint32_t incidents = 0;
+
+    uint32_t knownS() const { return upS + downS; }
+
+    /**
+     * Parts per million of known time the site was up; 1000000 if
+     * nothing is known yet
+     */
+    uint32_t availabilityPpm() const {
+        uint32_t known = knownS();
+        if (known == 0) return 1000000;
+        return static_cast<uint32_t>(static_cast<uint64_t>(upS) * 1000000 / known);
+    }
+
+    // 0 when there was no incident in the window
+    uint32_t mttrS() const { return incidents ? downS / incidents : 0; }
+    uint32_t mtbfS() const { return incidents ? upS / incidents : 0; }
+};
+
+/**
+ * SPAN_S of history in BUCKET_S buckets (both seconds, BUCKET_S <= 65535)
+ */
+template <uint32_t SPAN_S, uint32_t BUCKET_S>
+class Rolling {
+public:
+    static_assert(SPAN_S % BUCKET_S == 0, "span must be whole buckets");
+    static_assert(BUCKET_S <= 0xFFFF, "bucket counters are 16-bit");
+    static constexpr size_t BUCKETS = SPAN_S / BUCKET_S + 1;   // Full span plus the filling one
+
+    /**
+     * Credit seconds to state, moving to new buckets as they fill
+     */
+    void add(uint32_t seconds, State state) {
+        if (seconds > SPAN_S + BUCKET_S) {
+            seconds = SPAN_S + BUCKET_S;   // Anything older falls out anyway
+        }
+        while (seconds > 0) {
+            uint32_t room = BUCKET_S - _fill;
+            uint16_t n    = static_cast<uint16_t>(seconds < room ? seconds : room);
+            Bucket&  b    = _buckets[_head];
+            if (state == State::UP) {
+                b.upS += n;
+                _sum.upS += n;
+            } else if (state == State::DOWN) {
+                b.downS += n;
+                _sum.downS += n;
+            }
+            _fill   += n;
+            seconds -= n;
+            if (_fill == BUCKET_S) next();
+        }
+    }
+
+    void incident() {
+        _buckets[_head].incidents++;
+        _sum.incidents++;
+    }
+
+    const Summary& summary() const { return _sum; }
+
+private:
+    struct Bucket {
+        uint16_t upS       = 0;
+        uint16_t downS     = 0;
+        uint16_t incidents = 0;
+    };
+
+    void next() {
+        _head = (_head + 1) % BUCKETS;
+        Bucket& oldest = _buckets[_head];
+        _sum.upS       -= oldest.upS;
+        _sum.downS     -= oldest.downS;
+        _sum.incidents -= oldest.incidents;
+        oldest = Bucket();
+        _fill  = 0;
+    }
+
+    Bucket   _buckets[BUCKETS];
+    size_t   _head = 0;
+    uint32_t _fill = 0;       // Seconds in the current bucket
+    Summary  _sum;
+};
+
+class Tracker {
+public:
+    /**
+     * A check result (own, mirrored or pushed) at nowMs
+     */
+    void update(uint32_t nowMs, bool up) {
+        tick(nowMs);
+        if (!up && _wasUp) {
+            _hour.incident();
+            _day.incident();
+            _week.incident();
+        }
+        _state = up ? State::UP : State::DOWN;
+        _wasUp = up;
+    }
+
+    /**
+     * Status unknown from nowMs (e.g. WiFi lost) until the next update();
+     * an outage in progress is not counted again when it resumes
+     */
+    void pause(uint32_t nowMs) {
+        tick(nowMs);
+        _state = State::UNKNOWN;
+    }
+
+    /**
+     * Bring the windows up to nowMs; call before reading
+     */
+    void tick(uint32_t nowMs) {
+        if (!_started) {
+            _started = true;
+            _lastMs  = nowMs;
+            return;
+        }
+        uint32_t elapsed = nowMs - _lastMs + _carryMs;
+        _lastMs  = nowMs;
+        _carryMs = elapsed % 1000;
+        uint32_t seconds = elapsed / 1000;
+        if (seconds == 0) return;
+        _hour.add(seconds, _state);
+        _day.add(seconds, _state);
+        _week.add(seconds, _state);
+    }
+
+    const Summary& summary(Window w) const {
+        switch (w) {
+            case Window::HOUR: return _hour.summary();
+            case Window::DAY:  return _day.summary();
+            default:           return _week.summary();
+        }
+    }
+
+    State state() const { return _state; }
+
+private:
+    Rolling<3600, 300>     _hour;    // 5 min buckets
+    Rolling<86400, 3600>   _day;     // 1 h buckets
+    Rolling<604800, 21600> _week;    // 6 h buckets
+    State    _state   = State::UNKNOWN;
+    bool     _wasUp   = true;        // Last known state, kept across pause()
+    bool     _started = false;
+    uint32_t _lastMs  = 0;
+    uint32_t _carryMs = 0;
+};
+
+}  // namespace Sla
+
+#endif
@@ -0,0 +1,79 @@
+/**
+ * LED-Panel-ESP12F - Status HTTP Server
+ *
+ * Single-connection, non-blocking HTTP/1.0 server driven from loop().
+ *
+ * - One client at a time; others wait in the listen backlog
+ * - Each handle() call reads at most READ_BUDGET bytes and writes at most
+ *   one buffer, and only as much as the TCP send window accepts, so it
+ *   never blocks displayAnimate() or the probe schedule
+ * - Bodies are produced in parts by a route's render function into a
+ *   fixed buffer; no String, no Content-Length (connection close ends it)
+ * - Routes with a post function also accept POST bodies of up to
+ *   BODY_MAX bytes (Content-Length required), read into the same buffer
+ * - The request must arrive within REQUEST_TIMEOUT; while sending, the
+ *   connection is only dropped after REQUEST_TIMEOUT without progress,
+ *   so long bodies (/events) reach slow clients in full
+ */
+
+#ifndef STATUS_SERVER_H
+#define STATUS_SERVER_H
+
+#include <ESP8266WiFi.h>
+#include "request_line.h"
+
+class StatusServer {
+public:
+    static constexpr size_t   BUFFER_SIZE     = 512;   // About one TCP segment (MSS 536)
+    static constexpr size_t   READ_BUDGET     = 128;
+    static constexpr uint32_t REQUEST_TIMEOUT = 3000;
+    static constexpr size_t   BODY_MAX        = 256;
+
+    /**
+     * Render body part `part` into buf; return its length, 0 when done
+     */
+    typedef size_t (*RenderFn)(uint8_t part, char* buf, size_t cap);
+
+    /**
+     * Handle a POST body; return the HTTP status to answer with
+     */
+    typedef int (*PostFn)(const char* body, size_t len);
+
+    struct Route {
+        const char* path;
+        const char* contentType;
+        RenderFn    render;          // GET, or nullptr
+        PostFn      post;            // POST, or nullptr
+    };
+
+    StatusServer(uint16_t port, const Route* routes, uint8_t routeCount);
+
+    void begin();
+    void handle();
+
+    uint32_t requests() const { return _requests; }
+
+private:
+    enum class Phase : uint8_t { IDLE, READING, BODY, SENDING };
+
+    void startResponse();
+    void respond(int code, const char* type);
+    bool fillNextPart();
+    void close();
+
+    WiFiServer   _server;
+    WiFiClient   _client;
+    const Route* _routes;
+    uint8_t      _routeCount;
+    const Route* _route = nullptr;
+    RequestLine  _request;
+    Phase        _phase = Phase::IDLE;
+    uint8_t      _part  = 0;
+    uint32_t     _started  = 0;
+    uint32_t     _requests = 0;
+    char         _buf[BUFFER_SIZE];
+    size_t       _len  = 0;
+    size_t       _sent = 0;
+};
+
+#endif
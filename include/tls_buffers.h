@@ -0,0 +1,117 @@
+/**
+ * LED-Panel-ESP12F - Per-host TLS Buffer Sizes
+ *
+ * Small BearSSL I/O buffers only work with servers that honour max
+ * fragment length negotiation (MFLN); a server that ignores it sends
+ * full 16 KB records and the handshake fails. Redirect hops and the
+ * redirect cache's final URL often live on another host than the
+ * configured one (apex -> www, a CDN), so support is probed and
+ * remembered per host and port:
+ *
+ * - The first TLS connect to a host pays for one MFLN probe
+ * - Hosts that refuse MFLN, or could not be probed, get full buffers
+ * - allSmall() tells the heap guard whether every host in use takes the
+ *   small buffers, so it can reserve for the largest handshake
+ *
+ * Hosts are keyed by the CRC-32 of host and port; with N entries the
+ * least recently used one is replaced. Nothing is allocated.
+ *
+ *   TlsBuffers::Table<4> mfln;
+ *   bool small = mfln.small(url.host, url.port, [&] {
+ *       return tls.probeMaxFragmentLength(url.host, url.port, 512);
+ *   });
+ */
+
+#ifndef TLS_BUFFERS_H
+#define TLS_BUFFERS_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "crc32.h"
+
+namespace TlsBuffers {
+
+inline uint32_t keyOf(const char* host, uint16_t port) {
+    uint8_t portBytes[2] = {static_cast<uint8_t>(port >> 8), static_cast<uint8_t>(port)};
+    uint32_t crc = Crc::crc32(reinterpret_cast<const uint8_t*>(host), strlen(host));
+    return Crc::crc32(portBytes, sizeof(portBytes), crc);
+}
+
+template <uint8_t N>
+class Table {
+public:
+    /**
+     * True if host:port takes small buffers; probe() is called (and its
+     * answer kept) the first time the host is seen
+     */
+    template <class Probe>
+    bool small(const char* host, uint16_t port, Probe&& probe) {
+        uint32_t key = keyOf(host, port);
+        Entry*   e   = find(key);
+        if (!e) {
+            e        = &slot();
+            e->used  = true;
+            e->key   = key;
+            e->small = probe();
+            _probes++;
+        }
+        e->usedAt = ++_tick;
+        return e->small;
+    }
+
+    /**
+     * Every remembered host takes small buffers (false while none is known)
+     */
+    bool allSmall() const {
+        bool any = false;
+        for (uint8_t i = 0; i < N; i++) {
+            if (!_entries[i].used) continue;
+            if (!_entries[i].small) return false;
+            any = true;
+        }
+        return any;
+    }
+
+    uint32_t probes() const { return _probes; }
+
+    /**
+     * Forget every host (new target)
+     */
+    void clear() {
+        for (uint8_t i = 0; i < N; i++) _entries[i].used = false;
+    }
+
+private:
+    struct Entry {
+        bool     used   = false;
+        bool     small  = false;
+        uint32_t key    = 0;
+        uint32_t usedAt = 0;
+    };
+
+    Entry* find(uint32_t key) {
+        for (uint8_t i = 0; i < N; i++) {
+            if (_entries[i].used && _entries[i].key == key) return &_entries[i];
+        }
+        return nullptr;
+    }
+
+    // A free entry, else the least recently used
+    Entry& slot() {
+        Entry* oldest = &_entries[0];
+        for (uint8_t i = 0; i < N; i++) {
+            if (!_entries[i].used) return _entries[i];
+            if (_entries[i].usedAt - oldest->usedAt > 0x80000000u) oldest = &_entries[i];
+        }
+        return *oldest;
+    }
+
+    Entry    _entries[N];
+    uint32_t _tick   = 0;
+    uint32_t _probes = 0;
+};
+
+}  // namespace TlsBuffers
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * LED-Panel-ESP12F - Levelled Logging
+ *
+ * See include/log.h
+ */
+
+#include <Arduino.h>
+#include <stdarg.h>
+#include "log.h"
+#include "log_ring.h"
+
+#if LOG_LEVEL > LOG_LEVEL_NONE
+
+namespace Log {
+
+namespace {
+
+LogRing<BUFFER_SIZE> ring;
+uint32_t             reportedDrops = 0;
+
+}  // namespace
+
+void write(Level level, Category category, const char* fmt, ...) {
+    char line[LINE_MAX];
+    int n = snprintf_P(line, sizeof(line), PSTR("[%8u] %c %s: "),
+                       millis(), levelChar(level), categoryName(category));
+
+    va_list args;
+    va_start(args, fmt);
+    int m = vsnprintf_P(line + n, sizeof(line) - n, fmt, args);
+    va_end(args);
+
+    size_t len = n + ((m > 0) ? m : 0);
+    if (len > sizeof(line) - 2) len = sizeof(line) - 2;   // Cut short, keep the newline
+    line[len++] = '\n';
+
+    ring.push(line, len);
+    drain();   // Start sending now in case loop() is busy for a while
+}
+
+void drain() {
+    ring.drain(Serial, DRAIN_MAX);
+
+    // Say so once lines were lost, when there is room to say it
+    uint32_t drops = ring.dropped();
+    if (drops != reportedDrops && ring.free() >= LINE_MAX) {
+        char line[LINE_MAX];
+        int n = snprintf_P(line, sizeof(line), PSTR("[%8u] W boot: %u log lines dropped\n"),
+                           millis(), drops - reportedDrops);
+        reportedDrops = drops;
+        if (n > 0) ring.push(line, n);
+    }
+}
+
+uint32_t dropped() {
+    return ring.dropped();
+}
+
+}  // namespace Log
+
+#endif
@@ -13,15 +13,63 @@
  * - Power-efficient WiFi sleep between checks
  * - Visual feedback for mute state
  * - Watchdog timer for reliability
+ * - Static messages pre-rendered to column bitmaps at compile time
+ * - Bitmap frames pushed through the HSPI FIFO, one burst per row
+ * - Heap telemetry around each probe with controlled low-memory restart
+ * - Allocation-free probe: reused clients, fixed buffers, no String
+ * - Reset reason and last loop section kept in RTC memory across reboots
+ * - Non-blocking HTTP status endpoint (probe results, loop and heap metrics)
+ * - Prometheus /metrics exporter rendered in TCP-segment sized parts
+ * - MQTT status-change events and summaries with an offline outbox
+ * - UDP multicast status beacon; peers' results kept in a fleet table
+ * - Prober election: one board per target checks the site, the rest mirror it
+ * - Signed status pushes (UDP or HTTP POST); polling drops to a slow fallback
+ * - Runtime settings from a CRC-checked binary file on LittleFS, hot-reloaded
+ * - Non-blocking serial command console for inspection and tuning in place
+ * - Levelled logging, compiled out below LOG_LEVEL, queued to the UART
+ * - Binary event log in flash (resets, status changes, WiFi), batched and
+ *   spread over a ring of segment files
+ * - Rolling 1h/24h/7d availability, MTTR and MTBF from bucketed counters
+ * - DEGRADED ("SITE SLOW") state from fixed-point EWMA latency statistics
+ * - Per-target response rules (status set, headers, body text, JSON
+ *   fields, latency) checked in one streaming pass over the response
+ * - Check scheduling, WiFi recovery, alerts and mute kept free of hardware
+ *   (monitor.h) so the host simulation replays them on a virtual clock
+ * - Redirect chains walked once; checks go straight to where the chain
+ *   ended, with the chain revalidated periodically
  */
 
 #include <ESP8266WiFi.h>
-#include <ESP8266HTTPClient.h>
 #include <WiFiClientSecureBearSSL.h>
+#include <WiFiUdp.h>
 #include <MD_Parola.h>
 #include <MD_MAX72XX.h>
 #include <SPI.h>
+#include <LittleFS.h>
 #include "config.h"
+#include "bitmap_text.h"
+#include "max7219_bus.h"
+#include "heap_stats.h"
+#include "http_probe.h"
+#include "postmortem.h"
+#include "probe_stats.h"
+#include "status_server.h"
+#include "prom_text.h"
+#include "mqtt_session.h"
+#include "beacon.h"
+#include "fleet_table.h"
+#include "election.h"
+#include "push_message.h"
+#include "config_store.h"
+#include "console.h"
+#include "log.h"
+#include "event_log.h"
+#include "sla_tracker.h"
+#include "latency_ewma.h"
+#include "probe_rules.h"
+#include "monitor.h"
+#include "redirect_cache.h"
+#include "tls_buffers.h"
 
 // ============== Configuration ==============
 #define HARDWARE_TYPE   MD_MAX72XX::FC16_HW
@@ -30,73 +78,388 @@
 #define BUZZ_PIN        4
 #define MUTE_PIN        5
 
-// Timing constants (in milliseconds)
-constexpr uint32_t CHECK_INTERVAL     = 30000;   // Site check interval
+// Timing constants (in milliseconds); those marked * are defaults that
+// /config.bin can override at runtime
+constexpr uint32_t CHECK_INTERVAL     = 30000;   // * Site check interval
 constexpr uint32_t WIFI_TIMEOUT       = 15000;   // WiFi connection timeout
-constexpr uint32_t HTTP_TIMEOUT       = 5000;    // HTTP request timeout
+constexpr uint32_t HTTP_TIMEOUT       = 5000;    // * HTTP request timeout
 constexpr uint32_t DEBOUNCE_DELAY     = 200;     // Button debounce time
-constexpr uint32_t RECONNECT_INTERVAL = 60000;   // WiFi reconnect attempt interval
+constexpr uint32_t RECONNECT_INTERVAL = 60000;   // * WiFi reconnect attempt interval
 constexpr uint32_t PING_DISPLAY_TIME  = 500;     // How long to show "PING"
 
-// Display settings
-constexpr uint8_t  DISPLAY_INTENSITY  = 2;       // 0-15
-constexpr uint16_t SCROLL_SPEED       = 40;      // Lower = faster
+// Probe settings
+constexpr uint16_t TLS_BUFFER_SIZE    = 512;     // BearSSL I/O buffers when MFLN works
+constexpr uint16_t TLS_FULL_BUFFER    = 16384;   // BearSSL default receive buffer (MFLN refused)
+constexpr uint8_t  TLS_HOSTS          = 4;       // Hosts whose MFLN support is remembered
+#ifndef PROBE_RULES
+#define PROBE_RULES ""                           // * Response rules (include/probe_rules.h)
+#endif
+constexpr uint32_t REDIRECT_REVALIDATE = 3600000;  // Walk the redirect chain again after this
 
-// Debug mode (comment out to disable serial output)
-#define DEBUG_MODE
+// Heap telemetry
+constexpr size_t   HEAP_SAMPLES       = 32;      // Ring buffer depth (2 per check)
+constexpr uint32_t HEAP_LOW_STREAK    = 6;       // Low samples in a row before restart
+constexpr uint32_t HEAP_RESTART_GRACE = 6;       // More low samples (3 checks) before forcing it
+constexpr int32_t  HEAP_LEAK_TREND    = -64;     // Bytes lost per sample considered a leak
+constexpr uint32_t TLS_CONTEXT_BYTES  = 5104;    // BearSSL client context and its stack
 
-#ifdef DEBUG_MODE
-    #define DEBUG_PRINT(x)   Serial.print(x)
-    #define DEBUG_PRINTLN(x) Serial.println(x)
-#else
-    #define DEBUG_PRINT(x)
-    #define DEBUG_PRINTLN(x)
+// Largest free block a handshake needs: receive buffer, 512-byte send
+// buffer and context. Full-size until MFLN is known to work
+constexpr uint32_t tlsMinFreeBlock(uint32_t receiveBuffer) {
+    return receiveBuffer + TLS_BUFFER_SIZE + TLS_CONTEXT_BYTES;
+}
+constexpr uint32_t TLS_MIN_FREE_BLOCK = tlsMinFreeBlock(TLS_FULL_BUFFER);   // 22000
+
+// Status endpoint
+constexpr uint16_t STATUS_PORT        = 80;
+constexpr size_t   LATENCY_HISTORY    = 16;      // Recent probe latencies kept
+
+// Slow-site detection (see include/latency_ewma.h)
+constexpr uint16_t SLOW_SIGMA_ENTER   = 30;      // Tenths of a sigma above the mean
+constexpr uint16_t SLOW_SIGMA_EXIT    = 20;
+constexpr uint32_t SLOW_MIN_DELTA     = 200;     // ms above the mean, at least
+constexpr uint16_t SLOW_TONE_HZ       = 1000;    // Short low chirp per check while slow
+constexpr uint16_t SLOW_TONE_MS       = 120;
+
+// Post-mortem record location in RTC user memory (4-byte blocks)
+constexpr uint32_t RTC_POSTMORTEM_BLOCK = 0;
+
+// MQTT (enabled by defining MQTT_HOST in config.h)
+#ifndef MQTT_PORT
+#define MQTT_PORT  1883
 #endif
+#ifndef MQTT_TOPIC
+#define MQTT_TOPIC "ledpanel"
+#endif
+constexpr size_t   MQTT_OUTBOX          = 8;       // Events kept while offline
+constexpr size_t   MQTT_PAYLOAD_MAX     = 128;
+constexpr uint16_t MQTT_KEEPALIVE       = 60;      // Seconds
+constexpr uint32_t MQTT_CONNECT_TIMEOUT = 1000;    // TCP connect, only while display rests
+constexpr uint32_t SUMMARY_INTERVAL     = 300000;  // Periodic summary publish
+
+// Fleet beacon (administratively scoped multicast, LAN only)
+constexpr uint16_t BEACON_PORT        = 4210;
+constexpr uint8_t  BEACON_GROUP[4]    = {239, 255, 42, 10};
+constexpr size_t   FLEET_MAX          = 8;       // Peers remembered
+constexpr uint32_t FLEET_TIMEOUT_CHECKS = 3;      // Check intervals before a peer is dropped
+constexpr uint8_t  BEACON_RX_BUDGET   = 4;       // Packets read per loop pass
+constexpr uint32_t BEACON_HEARTBEAT   = 5000;    // Presence beacon interval
+constexpr uint32_t ELECTION_LEASE     = 3 * BEACON_HEARTBEAT;   // Silence before failover
+
+// Status pushes (enabled by defining PUSH_KEY in config.h)
+#ifndef PUSH_PORT
+#define PUSH_PORT 4211
+#endif
+constexpr uint32_t PUSH_FALLBACK_INTERVAL = 300000;  // Polling while pushes arrive
+constexpr uint32_t PUSH_SILENCE           = 120000;  // No push this long: poll normally
+constexpr uint8_t  PUSH_RX_BUDGET         = 2;       // Datagrams read per loop pass
+
+// Display settings
+constexpr uint8_t  DISPLAY_INTENSITY  = 2;       // * 0-15
+constexpr uint16_t SCROLL_SPEED       = 40;      // * Lower = faster
+
+// Runtime configuration file (see include/config_store.h)
+constexpr char     CONFIG_PATH[]      = "/config.bin";
+constexpr char     CONFIG_TMP_PATH[]  = "/config.tmp";  // Written first, then renamed
+constexpr uint32_t CONFIG_POLL        = 10000;   // Check the file for changes
 
-// ============== PROGMEM Strings ==============
-const char MSG_WIFI_CONNECTING[] PROGMEM = "WiFi...";
-const char MSG_WIFI_OK[]         PROGMEM = "WiFi OK";
-const char MSG_WIFI_ERROR[]      PROGMEM = "WiFi Err";
-const char MSG_WIFI_RECONNECT[]  PROGMEM = "Reconn...";
-const char MSG_PING[]            PROGMEM = "Pinging";
-const char MSG_MUTED[]           PROGMEM = "Muted";
-const char MSG_UNMUTED[]         PROGMEM = "Sound On";
+// Event log (see include/event_log.h): 8 x 4 KB segment files, ~1800 events kept
+constexpr uint8_t  EVENT_SEGMENTS       = 8;
+constexpr size_t   EVENT_SEGMENT_SIZE   = 4096;
+constexpr size_t   EVENT_BATCH          = 8;       // Events per flash write
+constexpr uint32_t EVENT_FLUSH_INTERVAL = 300000;  // Longest an event waits in RAM
+
+// Serial console
+constexpr uint32_t SERIAL_BAUD        = 115200;
+constexpr uint8_t  CONSOLE_RX_BUDGET  = 32;      // Bytes read per loop pass
+
+// Logging: set LOG_LEVEL in platformio.ini build_flags (see include/log.h)
+
+// ============== Pre-rendered Messages ==============
+// Column bitmaps generated at compile time and stored in flash
+BITMAP_TEXT(MSG_WIFI_CONNECTING, "WiFi...");
+BITMAP_TEXT(MSG_WIFI_OK,         "WiFi OK");
+BITMAP_TEXT(MSG_WIFI_ERROR,      "WiFi Err");
+BITMAP_TEXT(MSG_WIFI_RECONNECT,  "Reconn...");
+BITMAP_TEXT(MSG_PING,            "Pinging");
+BITMAP_TEXT(MSG_MUTED,           "Muted");
+BITMAP_TEXT(MSG_UNMUTED,         "Sound On");
 
 // Site status messages
-const char MSG_SITE_UP[]   PROGMEM = "SITE OK";
-const char MSG_SITE_DOWN[] PROGMEM = "SITE DOWN!";
+BITMAP_TEXT(MSG_SITE_UP,   "SITE OK");
+BITMAP_TEXT(MSG_SITE_DOWN, "SITE DOWN!");
+BITMAP_TEXT(MSG_SITE_SLOW, "SITE SLOW");
+
+constexpr uint16_t DISPLAY_COLUMNS = MAX_DEVICES * 8;
 
 // ============== Global State ==============
 MD_Parola display = MD_Parola(HARDWARE_TYPE, CS_PIN, MAX_DEVICES);
+Max7219Bus<MAX_DEVICES> panelBus(CS_PIN);
 
 // Volatile for ISR access
 volatile bool muteToggleRequest = false;
 
-// State variables
+// State variables (site, WiFi and mute state live in the monitor)
 struct State {
-    bool     isMuted          = false;
-    bool     siteIsUp         = true;
-    bool     wifiConnected    = false;
     bool     messageScrolling = false;
-    uint32_t lastCheckTime    = 0;
-    uint32_t lastReconnect    = 0;
-    uint32_t lastButtonPress  = 0;
+    bool     restartPending   = false;
+    bool     restartForced    = false;   // Do not wait for a quiet moment
+    bool     probeReady       = false;
+    uint32_t tlsMinBlock      = TLS_MIN_FREE_BLOCK;   // For the buffers in use
+    uint32_t lastSummary      = 0;
 } state;
 
-// Message buffer for PROGMEM strings
+// Monitor outputs: status messages on the panel, tones on the buzzer
+struct PanelIo {
+    void show(Screen screen);
+    void alarm(bool on);
+    void chirp();
+    void beep();
+} panelIo;
+
+Monitor<PanelIo> monitor(panelIo, {5000, DEBOUNCE_DELAY});   // First check 5s after boot
+
+HeapStats<HEAP_SAMPLES>       heapStats;
+ProbeStats<LATENCY_HISTORY>   probeStats;
+Sla::Tracker                  slaTracker;    // Rolling availability windows
+LatencyEwma                   latencyEwma({3, SLOW_SIGMA_ENTER, SLOW_SIGMA_EXIT, SLOW_MIN_DELTA, 8, 2, 3});
+
+// Loop timing (excluding the idle delay)
+struct LoopStats {
+    uint32_t lastUs = 0;
+    uint32_t maxUs  = 0;
+} loopStats;
+
+// Probe storage, allocated once and reused by every check
+BearSSL::WiFiClientSecure tlsClient;
+BearSSL::Session          tlsSession;    // Enables TLS session resumption
+WiFiClient                plainClient;
+HttpProbe::ProbeArena     probeArena;
+ProbeRules::Table         probeRules;    // Compiled from settings.rules
+ProbeRules::Reason        probeVerdict = ProbeRules::Reason::OK;
+RedirectCache::Cache<1>   redirectCache(REDIRECT_REVALIDATE);   // Where settings.siteUrl ends up
+TlsBuffers::Table<TLS_HOSTS> tlsHosts;   // MFLN support of each host the probe connects to
+
+void prepareTls(const HttpProbe::Url& url);
+
+struct ProbeEnv {
+    uint32_t now() { return millis(); }
+    void idle() { delay(1); }
+    WiFiClient& clientFor(const HttpProbe::Url& url) {
+        if (!url.https) return plainClient;
+        prepareTls(url);
+        return tlsClient;
+    }
+} probeEnv;
+
+// Post-mortem: live record mirrored to RTC memory, and what the last boot found
+PostMortem::Record pmRecord;
+
+struct BootReport {
+    uint32_t           reason    = 0;
+    uint32_t           exccause  = 0;
+    uint32_t           epc1      = 0;
+    uint32_t           excvaddr  = 0;
+    bool               hasRecord = false;
+    PostMortem::Record previous  = {};
+} bootReport;
+
+// Message buffer for runtime text rendered by MD_Parola
 char msgBuffer[32];
 
+// Bitmap animation (replaces MD_Parola while a pre-rendered message is shown)
+enum class BitmapPhase : uint8_t { IDLE, SCROLL_IN, PAUSE, SCROLL_OUT };
+
+struct BitmapAnim {
+    BitmapText::View bmp       = {nullptr, 0};
+    BitmapPhase      phase     = BitmapPhase::IDLE;
+    int16_t          x         = 0;      // Display column of bitmap column 0
+    int16_t          restX     = 0;      // Resting position after scroll-in
+    uint16_t         pause     = 0;      // Pause at rest (0 = until replaced)
+    bool             scrollOut = false;
+    uint32_t         lastStep  = 0;
+} bitmapAnim;
+
+#ifdef MQTT_HOST
+// MQTT publisher; outbox holds events raised while WiFi or the broker is down
+WiFiClient mqttClient;
+char       mqttClientId[24];
+MqttSession<WiFiClient, MQTT_OUTBOX, MQTT_PAYLOAD_MAX> mqtt(mqttClient, MQTT_HOST, MQTT_PORT,
+                                                            mqttClientId, MQTT_KEEPALIVE);
+#endif
+
+// Fleet beacon: own identity and the latest result heard from each peer
+WiFiUDP               beaconUdp;
+FleetTable<FLEET_MAX> fleet;
+
+struct BeaconState {
+    uint32_t boardId    = 0;
+    uint32_t targetId   = 0;
+    uint32_t seq        = 0;
+    bool     listening  = false;
+    uint32_t received   = 0;
+    uint32_t rejected   = 0;
+    uint32_t lastSent   = 0;
+    uint32_t mirrored   = 0;      // Results taken from the elected prober
+    uint32_t mirroredAt = 0;      // Local time of the last mirrored check
+    bool     keyed      = false;  // Fleet key set (beacons are authenticated with it)
+    uint8_t  key[SipHash::KEY_SIZE] = {};
+} beaconState;
+
+Election election;
+
+// Status pushes from the monitoring system
+WiFiUDP        pushUdp;
+Push::Verifier pushVerifier;
+
+struct PushState {
+    bool     enabled   = false;
+    bool     listening = false;
+    uint32_t accepted  = 0;
+    uint32_t lastAt    = 0;
+} pushState;
+
+// Runtime configuration: current settings, and the file they came from.
+// Strings in settings point into the active buffer; a reload fills the
+// other one, so the previous settings stay readable while changes apply.
+ConfigStore::Values settings;
+ConfigStore::Config config;
+uint8_t             configBuf[2][ConfigStore::RECORD_MAX];
+
+struct ConfigState {
+    bool               mounted     = false;
+    uint8_t            active      = 0;
+    uint32_t           lastPoll    = 0;
+    uint32_t           loads       = 0;
+    uint32_t           rejected    = 0;
+    uint32_t           rejectedCrc = 0;     // Not retried until the file changes
+    ConfigStore::Error lastError   = ConfigStore::Error::NONE;
+} configState;
+
+// Serial command console
+Console::LineBuffer consoleLine;
+
+// Event log: one LittleFS file per segment, /events0.bin .. /events7.bin
+struct EventFiles {
+    static void path(uint8_t seg, char* out) {
+        snprintf_P(out, 16, PSTR("/events%u.bin"), seg);
+    }
+    size_t size(uint8_t seg) {
+        char p[16];
+        path(seg, p);
+        File f = LittleFS.open(p, "r");
+        return f ? f.size() : 0;
+    }
+    size_t read(uint8_t seg, size_t offset, uint8_t* buf, size_t len) {
+        char p[16];
+        path(seg, p);
+        File f = LittleFS.open(p, "r");
+        if (!f || !f.seek(offset)) return 0;
+        return f.read(buf, len);
+    }
+    bool append(uint8_t seg, const uint8_t* buf, size_t len) {
+        char p[16];
+        path(seg, p);
+        File f = LittleFS.open(p, "a");
+        return f && f.write(buf, len) == len;
+    }
+    bool erase(uint8_t seg) {
+        char p[16];
+        path(seg, p);
+        return !LittleFS.exists(p) || LittleFS.remove(p);
+    }
+} eventFiles;
+
+EventLog<EventFiles, EVENT_SEGMENTS, EVENT_SEGMENT_SIZE, EVENT_BATCH> eventLog(eventFiles);
+
+struct EventState {
+    bool     enabled   = false;     // LittleFS mounted
+    uint32_t lastFlush = 0;
+} eventState;
+
 // ============== Function Declarations ==============
 void setupDisplay();
 void setupWiFi();
 void setupPins();
 bool connectWiFi();
 bool checkSiteStatus();
+void setupProbeClients();
+void compileRules();
 void handleMuteToggle();
 void updateDisplay(const char* msg, bool fromProgmem = true);
-void showStatus(bool isUp);
+void showBitmap(BitmapText::View bmp, bool scrollIn, uint16_t pause, bool scrollOut);
+bool animateBitmap();
+void drawBitmapFrame();
+void showText(const char* text);
 void playAlertTone(bool enable);
+void playSlowChirp();
 void checkWiFiConnection();
+void sampleHeap(const char* when);
+void restartIfQuiet();
+void setupPostMortem();
+void markSection(PostMortem::Section section);
+void savePostMortem();
+size_t renderStatus(uint8_t part, char* buf, size_t cap);
+size_t renderMetrics(uint8_t part, char* buf, size_t cap);
+void setupMqtt();
+void handleMqtt();
+void publishStatusChange(bool isUp, int code, uint32_t latencyMs);
+void publishSummary();
+void setupBeacon();
+void handleBeacons();
+void sendBeacon();
+void mirrorLeaderResult(uint32_t now);
+void applyCheckResult(bool isUp, int code, uint32_t latencyMs);
+void setupPush();
+void handlePushUdp();
+int handlePushPost(const char* body, size_t len);
+Push::Result acceptPush(const char* msg, size_t len);
+uint32_t checkInterval(uint32_t now);
+ConfigStore::Values defaultSettings();
+void setupConfig();
+void handleConfig();
+bool loadConfig();
+void applyConfigChanges(const ConfigStore::Values& prev);
+bool saveConfig();
+void setMuted(bool muted);
+void handleConsole();
+bool cmdHelp(uint8_t argc, char** argv);
+bool cmdStatus(uint8_t argc, char** argv);
+bool cmdHist(uint8_t argc, char** argv);
+bool cmdSla(uint8_t argc, char** argv);
+bool cmdCheck(uint8_t argc, char** argv);
+bool cmdInterval(uint8_t argc, char** argv);
+bool cmdIntensity(uint8_t argc, char** argv);
+bool cmdMute(uint8_t argc, char** argv);
+bool cmdSave(uint8_t argc, char** argv);
+void setupEvents();
+void logEvent(Event::Type type, int code, uint32_t value, uint16_t extra = 0);
+void handleEvents();
+size_t renderEvents(uint8_t part, char* buf, size_t cap);
+
+// ============== Status Server ==============
+const StatusServer::Route STATUS_ROUTES[] = {
+    {"/",        "application/json",          renderStatus,  nullptr},
+    {"/status",  "application/json",          renderStatus,  nullptr},
+    {"/metrics", "text/plain; version=0.0.4", renderMetrics, nullptr},
+    {"/push",    "text/plain",                nullptr,       handlePushPost},
+    {"/events",  "application/octet-stream",  renderEvents,  nullptr},
+};
+StatusServer statusServer(STATUS_PORT, STATUS_ROUTES, sizeof(STATUS_ROUTES) / sizeof(STATUS_ROUTES[0]));
+
+// ============== Serial Console ==============
+const Console::Command CONSOLE_COMMANDS[] = {
+    {"help",      "",         0, 0, cmdHelp},
+    {"status",    "",         0, 0, cmdStatus},
+    {"hist",      "",         0, 0, cmdHist},
+    {"sla",       "",         0, 0, cmdSla},
+    {"check",     "",         0, 0, cmdCheck},
+    {"interval",  "[ms]",     0, 1, cmdInterval},
+    {"intensity", "[0-15]",   0, 1, cmdIntensity},
+    {"mute",      "[on|off]", 0, 1, cmdMute},
+    {"save",      "",         0, 0, cmdSave},
+};
+constexpr size_t CONSOLE_COMMAND_COUNT = sizeof(CONSOLE_COMMANDS) / sizeof(CONSOLE_COMMANDS[0]);
 
 // ============== ISR ==============
 void IRAM_ATTR onMuteButtonPress() {
@@ -105,71 +468,119 @@ void IRAM_ATTR onMuteButtonPress() {
 
 // ============== Setup ==============
 void setup() {
-#ifdef DEBUG_MODE
-    Serial.begin(115200);
+    Serial.begin(SERIAL_BAUD);  // Console and log output
     delay(100);
-    DEBUG_PRINTLN(F("\n\n=== LED-Panel-ESP12F ==="));
-    DEBUG_PRINTLN(F("Optimized Firmware v2.0"));
-#endif
+    LOG_INFO(BOOT, "=== LED-Panel-ESP12F === Optimized Firmware v2.0");
+
+    setupPostMortem();
+    setupConfig();
+    setupEvents();
 
     setupPins();
     setupDisplay();
     setupWiFi();
+    statusServer.begin();
+    setupMqtt();
+    setupBeacon();
+    setupPush();
     
-    // Initial site check after boot
-    state.lastCheckTime = millis() - CHECK_INTERVAL + 5000; // Check 5s after boot
+    // Initial site check shortly after boot
+    monitor.begin(millis(), settings.checkIntervalMs, WiFi.status() == WL_CONNECTED);
     
-    DEBUG_PRINTLN(F("Setup complete"));
+    LOG_INFO(BOOT, "Setup complete");
 }
 
 // ============== Main Loop ==============
 void loop() {
+    uint32_t loopStart = micros();
+    
     // Handle display animations
-    if (display.displayAnimate()) {
+    markSection(PostMortem::Section::DISPLAY);
+    bool animDone = (bitmapAnim.phase != BitmapPhase::IDLE) ? animateBitmap()
+                                                            : display.displayAnimate();
+    if (animDone) {
         if (state.messageScrolling) {
             state.messageScrolling = false;
+            bitmapAnim.phase = BitmapPhase::IDLE;
             display.displayClear();
         }
     }
     
     // Handle mute button (with debounce)
     if (muteToggleRequest) {
+        markSection(PostMortem::Section::BUTTON);
         handleMuteToggle();
     }
     
     // Check WiFi connection periodically
+    markSection(PostMortem::Section::WIFI_CHECK);
     checkWiFiConnection();
     
-    // Periodic site check
+    // Pick up an edited /config.bin
+    markSection(PostMortem::Section::CONFIG);
+    handleConfig();
+    
+    // Console commands (bounded work per pass)
+    markSection(PostMortem::Section::CONSOLE);
+    handleConsole();
+    
+    // Pushed status first: it is what makes alerts immediate
+    markSection(PostMortem::Section::PUSH);
+    handlePushUdp();
+    
+    // Periodic site check, by the elected prober (or alone without a beacon)
     uint32_t now = millis();
-    if (state.wifiConnected && (now - state.lastCheckTime >= CHECK_INTERVAL)) {
-        state.lastCheckTime = now;
+    if (monitor.checkDue(now, checkInterval(now), election.shouldProbe(beaconState.listening))) {
+        markSection(PostMortem::Section::PROBE);
         
         // Show PING indicator
-        updateDisplay(MSG_PING);
-        display.displayText(msgBuffer, PA_CENTER, 0, PING_DISPLAY_TIME, PA_PRINT, PA_NO_EFFECT);
-        display.displayAnimate();
+        showBitmap(BitmapText::view(MSG_PING), false, PING_DISPLAY_TIME, false);
         delay(PING_DISPLAY_TIME);
         
         // Check site
-        DEBUG_PRINT(F("Checking site... "));
+        sampleHeap("pre");
         bool isUp = checkSiteStatus();
-        DEBUG_PRINTLN(isUp ? F("UP") : F("DOWN"));
+        LOG_INFO(PROBE, "Site %s", isUp ? "UP" : "DOWN");
+        sampleHeap("post");
+        LOG_DEBUG(UI, "Frame us (last/max): %u/%u", panelBus.lastFrameUs(), panelBus.maxFrameUs());
         
-        // Update state and display
-        state.siteIsUp = isUp;
-        
-        showStatus(isUp);
-        
-        // Alert on status change or if down
-        if (!isUp) {
-            playAlertTone(!state.isMuted);
-        } else {
-            playAlertTone(false);
-        }
+        applyCheckResult(isUp, probeStats.lastCode(), probeStats.lastLatency());
+        sendBeacon();  // Share the result now rather than at the next heartbeat
+    }
+    
+    // Serve status requests (bounded work per pass)
+    if (monitor.wifiConnected()) {
+        markSection(PostMortem::Section::HTTP_SERVER);
+        statusServer.handle();
+    }
+    
+    // Peer beacons (bounded work per pass)
+    markSection(PostMortem::Section::BEACON);
+    handleBeacons();
+    
+    // Publish queued events (bounded work per pass)
+    markSection(PostMortem::Section::MQTT);
+    handleMqtt();
+    
+    // Low-memory restart, only once nothing is being shown or sounded
+    if (state.restartPending) {
+        restartIfQuiet();
     }
     
+    // Write batched events once they have waited long enough
+    markSection(PostMortem::Section::EVENTS);
+    handleEvents();
+    
+    // Queued log lines, as far as the UART has room
+    markSection(PostMortem::Section::LOG);
+    Log::drain();
+    
     // Small delay to prevent tight loop
+    markSection(PostMortem::Section::IDLE);
+    loopStats.lastUs = micros() - loopStart;
+    if (loopStats.lastUs > loopStats.maxUs) {
+        loopStats.maxUs = loopStats.lastUs;
+    }
     delay(10);
 }
 
@@ -182,16 +593,16 @@ void setupPins() {
     
     attachInterrupt(digitalPinToInterrupt(MUTE_PIN), onMuteButtonPress, FALLING);
     
-    DEBUG_PRINTLN(F("Pins configured"));
+    LOG_DEBUG(BOOT, "Pins configured");
 }
 
 void setupDisplay() {
     display.begin();
-    display.setIntensity(DISPLAY_INTENSITY);
+    display.setIntensity(settings.intensity);
     display.displayClear();
     display.setTextAlignment(PA_CENTER);
     
-    DEBUG_PRINTLN(F("Display initialized"));
+    LOG_DEBUG(BOOT, "Display initialized");
 }
 
 void setupWiFi() {
@@ -199,30 +610,28 @@ void setupWiFi() {
     WiFi.setAutoReconnect(true);
     WiFi.persistent(false);  // Don't save to flash (reduces wear)
     
-    updateDisplay(MSG_WIFI_CONNECTING);
-    display.displayText(msgBuffer, PA_CENTER, SCROLL_SPEED, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+    showBitmap(BitmapText::view(MSG_WIFI_CONNECTING), true, 0, true);
     
-    state.wifiConnected = connectWiFi();
+    bool connected = connectWiFi();
     
-    if (state.wifiConnected) {
-        updateDisplay(MSG_WIFI_OK);
-        DEBUG_PRINT(F("Connected! IP: "));
-        DEBUG_PRINTLN(WiFi.localIP());
+    // Show result briefly
+    if (connected) {
+        showBitmap(BitmapText::view(MSG_WIFI_OK), true, 2000, false);
+        [[maybe_unused]] IPAddress ip = WiFi.localIP();
+        LOG_INFO(WIFI, "Connected, IP %u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
     } else {
-        updateDisplay(MSG_WIFI_ERROR);
+        showBitmap(BitmapText::view(MSG_WIFI_ERROR), true, 2000, false);
         playAlertTone(true);
         delay(1000);
         playAlertTone(false);
-        DEBUG_PRINTLN(F("WiFi connection failed"));
+        LOG_ERROR(WIFI, "Connection failed");
     }
     
-    // Show message briefly
-    display.displayText(msgBuffer, PA_CENTER, SCROLL_SPEED, 2000, PA_SCROLL_LEFT, PA_NO_EFFECT);
     state.messageScrolling = true;
 }
 
 bool connectWiFi() {
-    WiFi.begin(SECRET_SSID, SECRET_PASS);
+    WiFi.begin(settings.ssid, settings.pass);
     
     uint32_t startTime = millis();
     while (WiFi.status() != WL_CONNECTED) {
@@ -232,109 +641,1215 @@ bool connectWiFi() {
         delay(100);
         
         // Keep display animating during connection
-        display.displayAnimate();
+        animateBitmap();
     }
     
     return true;
 }
 
 void checkWiFiConnection() {
-    bool connected = (WiFi.status() == WL_CONNECTED);
-    
-    if (!connected && state.wifiConnected) {
-        // Lost connection
-        DEBUG_PRINTLN(F("WiFi disconnected!"));
-        state.wifiConnected = false;
-        playAlertTone(!state.isMuted);
-    }
+    uint32_t now = millis();
     
-    // Attempt reconnect periodically
-    if (!connected) {
-        uint32_t now = millis();
-        if (now - state.lastReconnect >= RECONNECT_INTERVAL) {
-            state.lastReconnect = now;
-            DEBUG_PRINTLN(F("Attempting WiFi reconnect..."));
+    switch (monitor.wifi(now, WiFi.status() == WL_CONNECTED, settings.reconnectMs)) {
+        case Monitor<PanelIo>::WifiEvent::LOST:
+            LOG_WARN(WIFI, "Disconnected");
+            logEvent(Event::Type::WIFI_DOWN, 0, 0);
+            slaTracker.pause(now);   // Site status unknown until checks resume
+            break;
+            
+        case Monitor<PanelIo>::WifiEvent::RESTORED:
+            // Came back without our help (auto-reconnect or new credentials)
+            LOG_INFO(WIFI, "Connected");
+            logEvent(Event::Type::WIFI_UP, 0, monitor.reconnects());
+            break;
             
-            updateDisplay(MSG_WIFI_RECONNECT);
-            display.displayText(msgBuffer, PA_CENTER, SCROLL_SPEED, 0, PA_SCROLL_LEFT, PA_NO_EFFECT);
+        case Monitor<PanelIo>::WifiEvent::RECONNECT:
+            markSection(PostMortem::Section::WIFI_RECONNECT);
+            LOG_INFO(WIFI, "Attempting reconnect");
             
             WiFi.reconnect();
             delay(5000);  // Give it time
             
             if (WiFi.status() == WL_CONNECTED) {
-                state.wifiConnected = true;
-                playAlertTone(false);
-                DEBUG_PRINTLN(F("Reconnected!"));
+                monitor.reconnected();
+                logEvent(Event::Type::WIFI_UP, 0, monitor.reconnects());
+                LOG_INFO(WIFI, "Reconnected");
             }
-        }
+            break;
+            
+        case Monitor<PanelIo>::WifiEvent::NONE:
+            break;
     }
 }
 
 bool checkSiteStatus() {
-    // Use BearSSL for secure connection
-    std::unique_ptr<BearSSL::WiFiClientSecure> client(new BearSSL::WiFiClientSecure);
-    client->setInsecure();  // Skip certificate verification
+    if (!state.probeReady) {
+        setupProbeClients();
+    }
     
-    HTTPClient http;
-    http.setTimeout(HTTP_TIMEOUT);
-    http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+    // The rules see the response as it streams in; the body is only read
+    // as far as a body pattern needs. A known redirect chain is skipped.
+    ProbeRules::Evaluator rules(probeRules);
+    uint32_t start = millis();
+    HttpProbe::ProbeResult result = redirectCache.probe(settings.siteUrl, probeArena, settings.httpTimeoutMs, probeEnv, rules);
+    uint32_t total = millis() - start;
+    int httpCode = result.code;
     
-    if (!http.begin(*client, SITE_URL)) {
-        DEBUG_PRINTLN(F("HTTP begin failed"));
-        return false;
+    // Only the final request is judged and recorded: redirect hops (walked
+    // on the first and the hourly check) would make those checks look slow
+    uint32_t latency = total - result.redirectMs;
+    
+    LOG_INFO(PROBE, "HTTP code %d, %u redirects%s, %u ms (%u ms total), %u body bytes",
+             httpCode, result.redirects, redirectCache.lastDirect() ? " (direct)" : "",
+             latency, total, rules.bodyBytes());
+    
+    // Without rules: any response below 500 is "up" (negative = connection error)
+    probeVerdict = rules.verdict(httpCode, latency);
+    bool isUp = (probeVerdict == ProbeRules::Reason::OK);
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+    for (uint8_t i = 0; i < probeRules.jsonCount; i++) {
+        const JsonFields::Value& v = rules.jsonValue(i);
+        LOG_DEBUG(PROBE, "json %s = %s", probeRules.jsonPaths[i], v.found ? v.text : "(missing)");
     }
+#endif
     
-    // Add headers for better compatibility
-    http.addHeader("User-Agent", "ESP8266-Monitor/2.0");
-    http.addHeader("Connection", "close");
+    probeStats.record(httpCode, isUp, latency);
+    if (!isUp) {
+        LOG_INFO(PROBE, "Down: %s", ProbeRules::reasonName(probeVerdict));
+        logEvent(Event::Type::PROBE_FAIL, httpCode, latency);
+    }
+    return isUp;
+}
+
+/**
+ * One-time TLS client setup, done on the first check once WiFi is up
+ * (and again for a new target, which forgets every host's MFLN support)
+ */
+void setupProbeClients() {
+    tlsClient.setInsecure();  // Skip certificate verification
+    tlsClient.setTimeout(settings.httpTimeoutMs);
+    tlsClient.setSession(&tlsSession);
+    plainClient.setTimeout(settings.httpTimeoutMs);
     
-    int httpCode = http.GET();
-    http.end();
+    tlsHosts.clear();
+    state.tlsMinBlock = TLS_MIN_FREE_BLOCK;
+    state.probeReady  = true;
+}
+
+/**
+ * Buffer sizes for the next TLS connect
+ *
+ * Small I/O buffers are only safe if the server honours max fragment
+ * length negotiation, so each host is probed on its first connect.
+ * Redirect hops and the cached final URL may be on other hosts than
+ * the configured one.
+ */
+void prepareTls(const HttpProbe::Url& url) {
+    uint32_t probes = tlsHosts.probes();
+    bool small = tlsHosts.small(url.host, url.port, [&] {
+        return tlsClient.probeMaxFragmentLength(url.host, url.port, TLS_BUFFER_SIZE);
+    });
+    if (tlsHosts.probes() != probes) {
+        LOG_INFO(PROBE, "TLS %s: %s buffers", url.host, small ? "small (MFLN)" : "full");
+    }
+    tlsClient.setBufferSizes(small ? TLS_BUFFER_SIZE : TLS_FULL_BUFFER, TLS_BUFFER_SIZE);
     
-    DEBUG_PRINT(F("HTTP code: "));
-    DEBUG_PRINTLN(httpCode);
+    // The heap guard reserves for the largest handshake in use
+    state.tlsMinBlock = tlsHosts.allSmall() ? tlsMinFreeBlock(TLS_BUFFER_SIZE) : TLS_MIN_FREE_BLOCK;
+}
+
+/**
+ * Compile settings.rules into probeRules; a bad rule line is reported
+ * and the default rules apply instead
+ */
+void compileRules() {
+    size_t at = 0;
+    ProbeRules::Error error = ProbeRules::compile(settings.rules, probeRules, &at);
+    if (error != ProbeRules::Error::NONE) {
+        LOG_WARN(PROBE, "Rules rejected at %u: %s", static_cast<unsigned>(at), ProbeRules::errorName(error));
+    }
+}
+
+/**
+ * Record a heap sample and flag a restart when TLS can no longer fit
+ */
+void sampleHeap(const char* when) {
+    HeapSample sample;
+    sample.freeHeap      = ESP.getFreeHeap();
+    sample.maxBlock      = ESP.getMaxFreeBlockSize();
+    sample.fragmentation = ESP.getHeapFragmentation();
+    heapStats.record(sample, state.tlsMinBlock);
+    
+    pmRecord.freeHeap      = sample.freeHeap;
+    pmRecord.maxBlock      = sample.maxBlock;
+    pmRecord.fragmentation = sample.fragmentation;
+    savePostMortem();
+    
+    LOG_DEBUG(HEAP, "%s: free=%u block=%u frag=%u%%",
+              when, sample.freeHeap, sample.maxBlock, sample.fragmentation);
+    
+    if (sample.maxBlock < state.tlsMinBlock) {
+        LOG_WARN(HEAP, "Largest block %u below TLS requirement %u", sample.maxBlock, state.tlsMinBlock);
+    }
     
-    // Consider 2xx and 3xx as "up"
-    // 4xx client errors might still mean server is responding
-    // 5xx server errors = down
-    if (httpCode < 0) {
-        return false;  // Connection error
+    if (heapStats.count() == HEAP_SAMPLES && heapStats.freeHeapTrend() <= HEAP_LEAK_TREND) {
+        LOG_WARN(HEAP, "Shrinking by %d bytes/sample", static_cast<int>(-heapStats.freeHeapTrend()));
     }
     
-    return (httpCode < 500);
+    HeapRestart need = heapStats.restartNeed(HEAP_LOW_STREAK, HEAP_RESTART_GRACE);
+    if (!state.restartPending && need != HeapRestart::NONE) {
+        LOG_ERROR(HEAP, "Exhausted, restart scheduled");
+        state.restartPending = true;
+    }
+    if (!state.restartForced && need == HeapRestart::NOW) {
+        LOG_ERROR(HEAP, "Still exhausted, restarting without waiting");
+        state.restartForced = true;
+    }
 }
 
-void handleMuteToggle() {
+/**
+ * Restart in a quiet period: site up, no alert sounding and no message
+ * on screen, so a restart never cuts off an outage alert. A forced
+ * restart does not wait: checks fail on a starved heap, so the site may
+ * read as down until the restart
+ */
+void restartIfQuiet() {
+    if (!state.restartForced && (!monitor.siteUp() || state.messageScrolling)) {
+        return;
+    }
+    
+    LOG_WARN(HEAP, "Restarting to recover heap");
+    markSection(PostMortem::Section::RESTART);
+    noTone(BUZZ_PIN);
+    display.displayClear();
+    eventLog.flush();
+    delay(100);
+    ESP.restart();
+}
+
+/**
+ * Report why the last reset happened and what the firmware was doing
+ */
+void setupPostMortem() {
+    const rst_info* info = ESP.getResetInfoPtr();
+    bootReport.reason   = info->reason;
+    bootReport.exccause = info->exccause;
+    bootReport.epc1     = info->epc1;
+    bootReport.excvaddr = info->excvaddr;
+    
+    PostMortem::Record previous;
+    ESP.rtcUserMemoryRead(RTC_POSTMORTEM_BLOCK, reinterpret_cast<uint32_t*>(&previous), sizeof(previous));
+    bootReport.hasRecord = PostMortem::isValid(previous);
+    if (bootReport.hasRecord) {
+        bootReport.previous = previous;
+    }
+    
+    // Anything but a power-on is worth seeing in production (LOG_LEVEL_WARN)
+    if (bootReport.reason == REASON_DEFAULT_RST) {
+        LOG_INFO(BOOT, "Reset reason: %s", PostMortem::resetReasonName(bootReport.reason));
+    } else {
+        LOG_WARN(BOOT, "Reset reason: %s", PostMortem::resetReasonName(bootReport.reason));
+    }
+    if (bootReport.reason == REASON_EXCEPTION_RST) {
+        LOG_ERROR(BOOT, "Exception %u epc1=0x%08x excvaddr=0x%08x",
+                  bootReport.exccause, bootReport.epc1, bootReport.excvaddr);
+    }
+    if (bootReport.hasRecord) {
+        LOG_WARN(BOOT, "Previous run: section=%s uptime=%ums heap=%u block=%u",
+                 PostMortem::sectionName(static_cast<PostMortem::Section>(previous.section)),
+                 previous.uptimeMs, previous.freeHeap, previous.maxBlock);
+    }
+    
+    // Start a fresh record for this run (RTC memory is random after power-on)
+    pmRecord = PostMortem::Record();
+    pmRecord.bootCount = bootReport.hasRecord ? previous.bootCount + 1 : 1;
+    pmRecord.section   = static_cast<uint8_t>(PostMortem::Section::BOOT);
+    if (bootReport.hasRecord && (previous.flags & PostMortem::FLAG_PUSH_SEQ)) {
+        pmRecord.flags   = PostMortem::FLAG_PUSH_SEQ;  // Pushes seen before the reset stay replays
+        pmRecord.pushSeq = previous.pushSeq;
+    }
+    savePostMortem();
+}
+
+/**
+ * Note the loop section being entered; cheap enough to call every pass
+ */
+void markSection(PostMortem::Section section) {
+    uint8_t s = static_cast<uint8_t>(section);
+    if (pmRecord.section == s) {
+        return;
+    }
+    pmRecord.section  = s;
+    pmRecord.uptimeMs = millis();
+    savePostMortem();
+}
+
+void savePostMortem() {
+    PostMortem::seal(pmRecord);
+    ESP.rtcUserMemoryWrite(RTC_POSTMORTEM_BLOCK, reinterpret_cast<uint32_t*>(&pmRecord), sizeof(pmRecord));
+}
+
+/**
+ * Status JSON, rendered one part per call into the server's buffer
+ */
+size_t renderStatus(uint8_t part, char* buf, size_t cap) {
+    int n = 0;
+    
+    switch (part) {
+        case 0:
+            n = snprintf_P(buf, cap,
+                PSTR("{\"site\":{\"url\":\"%s\",\"up\":%s,\"slow\":%s,\"last_code\":%d,"
+                     "\"verdict\":\"%s\",\"checks\":%u,\"failures\":%u},"
+                     "\"wifi\":{\"connected\":%s,\"rssi\":%d},\"muted\":%s,"),
+                settings.siteUrl, monitor.siteUp() ? "true" : "false",
+                monitor.siteSlow() ? "true" : "false", probeStats.lastCode(),
+                ProbeRules::reasonName(probeVerdict), probeStats.checks(), probeStats.failures(),
+                monitor.wifiConnected() ? "true" : "false", static_cast<int>(WiFi.RSSI()),
+                monitor.muted() ? "true" : "false");
+            break;
+            
+        case 1: {
+            n = snprintf_P(buf, cap, PSTR("\"latency_ms\":["));
+            for (size_t i = 0; i < probeStats.count() && n > 0 && static_cast<size_t>(n) < cap; i++) {
+                n += snprintf_P(buf + n, cap - n, PSTR("%s%u"), i ? "," : "", probeStats.latency(i));
+            }
+            if (n > 0 && static_cast<size_t>(n) < cap) {
+                n += snprintf_P(buf + n, cap - n, PSTR("],"));
+            }
+            break;
+        }
+            
+        case 2:
+            n = snprintf_P(buf, cap,
+                PSTR("\"loop\":{\"last_us\":%u,\"max_us\":%u,\"frame_us\":%u},"
+                     "\"heap\":{\"free\":%u,\"max_block\":%u,\"frag\":%u,"
+                     "\"min_block\":%u,\"trend\":%d},"),
+                loopStats.lastUs, loopStats.maxUs, panelBus.maxFrameUs(),
+                ESP.getFreeHeap(), ESP.getMaxFreeBlockSize(), ESP.getHeapFragmentation(),
+                heapStats.minBlockEver(), static_cast<int>(heapStats.freeHeapTrend()));
+            break;
+            
+        case 3:
+            n = snprintf_P(buf, cap,
+                PSTR("\"boot\":{\"reason\":\"%s\",\"count\":%u,\"prev_section\":\"%s\","
+                     "\"prev_uptime_ms\":%u},\"uptime_ms\":%u,"
+                     "\"election\":{\"role\":\"%s\",\"term\":%u,\"leader\":\"%06x\"},"
+                     "\"config\":{\"source\":\"%s\",\"crc\":\"%08x\",\"loads\":%u,"
+                     "\"rejected\":%u,\"last_error\":\"%s\"},"),
+                PostMortem::resetReasonName(bootReport.reason), pmRecord.bootCount,
+                bootReport.hasRecord ? PostMortem::sectionName(
+                    static_cast<PostMortem::Section>(bootReport.previous.section)) : "none",
+                bootReport.previous.uptimeMs, millis(),
+                Election::roleName(election.role()), election.term(), election.leaderId(),
+                config.valid() ? "file" : "default", config.crc(), configState.loads,
+                configState.rejected, ConfigStore::errorName(configState.lastError));
+            break;
+            
+        case 4: {
+            const RedirectCache::Cache<1>::Entry* e = redirectCache.entry(settings.siteUrl);
+            char finalUrl[HttpProbe::HOST_MAX + HttpProbe::PATH_MAX + 16] = "";
+            if (e) HttpProbe::formatUrl(e->url, finalUrl, sizeof(finalUrl));
+            const RedirectCache::Stats& rs = redirectCache.stats();
+            n = snprintf_P(buf, cap,
+                PSTR("\"redirect\":{\"final\":\"%s\",\"hops\":%u,\"direct\":%u,\"chains\":%u,"
+                     "\"revalidations\":%u,\"hops_followed\":%u,\"hops_skipped\":%u,"
+                     "\"saved_ms\":%u},\"fleet\":["),
+                finalUrl, e ? e->hops : 0, rs.direct, rs.chains, rs.revalidations,
+                rs.hopsFollowed, rs.hopsSkipped, rs.savedMs);
+            break;
+        }
+            
+        default: {
+            // One part per peer, then close the document
+            size_t peer = part - 5;
+            if (peer < fleet.count()) {
+                const FleetTable<FLEET_MAX>::Entry& e = fleet.at(peer);
+                n = snprintf_P(buf, cap,
+                    PSTR("%s{\"board\":\"%06x\",\"same_target\":%s,\"up\":%s,\"code\":%d,"
+                         "\"latency_ms\":%u,\"age_ms\":%u}"),
+                    peer ? "," : "", e.status.boardId,
+                    (e.status.targetId == beaconState.targetId) ? "true" : "false",
+                    e.status.up() ? "true" : "false", e.status.httpCode, e.status.latencyMs,
+                    e.status.ageMs + (millis() - e.heardAt));
+            } else if (peer == fleet.count()) {
+                n = snprintf_P(buf, cap, PSTR("]}\n"));
+            } else {
+                return 0;
+            }
+            break;
+        }
+    }
+    
+    if (n < 0) return 0;
+    return (static_cast<size_t>(n) < cap) ? n : cap - 1;
+}
+
+/**
+ * Prometheus exposition, one metric group per part so each part fits
+ * the server buffer (about one TCP segment)
+ */
+size_t renderMetrics(uint8_t part, char* buf, size_t cap) {
+    PromText out(buf, cap);
+    
+    switch (part) {
+        case 0:
+            out.family("ledpanel_checks_total", "counter", "Site checks performed");
+            out.sample("ledpanel_checks_total", probeStats.checks());
+            out.family("ledpanel_site_up", "gauge", "1 if the last check found the site up");
+            out.sample("ledpanel_site_up", static_cast<uint32_t>(monitor.siteUp()));
+            out.family("ledpanel_last_http_code", "gauge", "HTTP code of the last check (negative = error)");
+            out.sample("ledpanel_last_http_code", static_cast<int32_t>(probeStats.lastCode()));
+            break;
+            
+        case 1:
+            out.family("ledpanel_check_failures_total", "counter", "Failed site checks by class");
+            for (uint8_t c = 0; c < static_cast<uint8_t>(FailureClass::COUNT); c++) {
+                FailureClass fc = static_cast<FailureClass>(c);
+                out.sample("ledpanel_check_failures_total", "class", failureClassName(fc),
+                           probeStats.failures(fc));
+            }
+            break;
+            
+        case 2:
+        case 3: {
+            // Histogram split over two parts to stay within the buffer
+            if (part == 2) {
+                out.family("ledpanel_check_latency_seconds", "histogram", "Site check latency");
+            }
+            size_t first = (part == 2) ? 0 : LATENCY_BUCKET_COUNT / 2;
+            size_t last  = (part == 2) ? LATENCY_BUCKET_COUNT / 2 : LATENCY_BUCKET_COUNT + 1;
+            for (size_t b = first; b < last; b++) {
+                uint32_t le = (b < LATENCY_BUCKET_COUNT) ? LATENCY_BUCKETS_MS[b] : UINT32_MAX;
+                out.bucket("ledpanel_check_latency_seconds", le, probeStats.bucketCumulative(b));
+            }
+            if (part == 3) {
+                out.sampleSeconds("ledpanel_check_latency_seconds_sum", probeStats.latencySumMs());
+                out.sample("ledpanel_check_latency_seconds_count", probeStats.checks());
+            }
+            break;
+        }
+            
+        case 4:
+            out.family("ledpanel_wifi_reconnects_total", "counter", "Successful WiFi reconnects");
+            out.sample("ledpanel_wifi_reconnects_total", monitor.reconnects());
+            out.family("ledpanel_wifi_rssi_dbm", "gauge", "WiFi signal strength");
+            out.sample("ledpanel_wifi_rssi_dbm", static_cast<int32_t>(WiFi.RSSI()));
+            out.family("ledpanel_boot_count", "gauge", "Boots since power-on");
+            out.sample("ledpanel_boot_count", pmRecord.bootCount);
+            break;
+            
+        case 5:
+            out.family("ledpanel_heap_free_bytes", "gauge", "Free heap");
+            out.sample("ledpanel_heap_free_bytes", ESP.getFreeHeap());
+            out.family("ledpanel_heap_max_block_bytes", "gauge", "Largest free heap block");
+            out.sample("ledpanel_heap_max_block_bytes", ESP.getMaxFreeBlockSize());
+            break;
+            
+        case 6:
+            out.family("ledpanel_heap_fragmentation_percent", "gauge", "Heap fragmentation");
+            out.sample("ledpanel_heap_fragmentation_percent", static_cast<uint32_t>(ESP.getHeapFragmentation()));
+            out.family("ledpanel_loop_max_microseconds", "gauge", "Longest loop pass since boot");
+            out.sample("ledpanel_loop_max_microseconds", loopStats.maxUs);
+            break;
+            
+        case 7:
+            out.family("ledpanel_fleet_peers", "gauge", "Peer boards heard recently");
+            out.sample("ledpanel_fleet_peers", static_cast<uint32_t>(fleet.count()));
+            out.family("ledpanel_election_leader", "gauge", "1 if this board probes the site");
+            out.sample("ledpanel_election_leader", static_cast<uint32_t>(election.isLeader() ? 1 : 0));
+            out.family("ledpanel_mirrored_results_total", "counter", "Check results taken from the prober");
+            out.sample("ledpanel_mirrored_results_total", beaconState.mirrored);
+            break;
+            
+        case 8:
+            out.family("ledpanel_push_total", "counter", "Status pushes received, by result");
+            for (uint8_t r = 0; r < static_cast<uint8_t>(Push::Result::COUNT); r++) {
+                Push::Result result = static_cast<Push::Result>(r);
+                out.sample("ledpanel_push_total", "result", Push::resultName(result),
+                           pushVerifier.count(result));
+            }
+            break;
+            
+        case 9:
+            out.family("ledpanel_event_flash_writes_total", "counter", "Event log batches written to flash");
+            out.sample("ledpanel_event_flash_writes_total", eventLog.writes());
+            out.family("ledpanel_event_dropped_total", "counter", "Events lost to flash write errors");
+            out.sample("ledpanel_event_dropped_total", eventLog.dropped());
+            break;
+            
+        case 10:
+        case 11: {
+            // Two families per part to stay within the buffer
+            slaTracker.tick(millis());
+            static const char* const NAMES[] = {
+                "ledpanel_availability_ppm", "ledpanel_incidents",
+                "ledpanel_mttr_seconds",     "ledpanel_mtbf_seconds"
+            };
+            static const char* const HELP[] = {
+                "Share of known time the site was up, in ppm",
+                "Up to down transitions",
+                "Mean time to repair (0 = no incident)",
+                "Mean time between failures (0 = no incident)"
+            };
+            for (uint8_t f = (part - 10) * 2; f < (part - 10) * 2 + 2; f++) {
+                out.family(NAMES[f], "gauge", HELP[f]);
+                for (uint8_t w = 0; w < static_cast<uint8_t>(Sla::Window::COUNT); w++) {
+                    const Sla::Summary& s = slaTracker.summary(static_cast<Sla::Window>(w));
+                    uint32_t values[] = {s.availabilityPpm(), s.incidents, s.mttrS(), s.mtbfS()};
+                    out.sample(NAMES[f], "window", Sla::windowName(static_cast<Sla::Window>(w)), values[f]);
+                }
+            }
+            break;
+        }
+            
+        case 12:
+            out.family("ledpanel_site_degraded", "gauge", "1 if the site is up but slow");
+            out.sample("ledpanel_site_degraded", static_cast<uint32_t>(monitor.siteSlow() ? 1 : 0));
+            out.family("ledpanel_latency_mean_ms", "gauge", "Smoothed probe latency (EWMA)");
+            out.sample("ledpanel_latency_mean_ms", latencyEwma.meanMs());
+            out.family("ledpanel_latency_sigma_ms", "gauge", "Smoothed probe latency deviation");
+            out.sample("ledpanel_latency_sigma_ms", latencyEwma.sigmaMs());
+            break;
+            
+        case 13: {
+            const RedirectCache::Stats& rs = redirectCache.stats();
+            out.family("ledpanel_redirect_checks_total", "counter", "Checks by start: cached final URL or configured URL");
+            out.sample("ledpanel_redirect_checks_total", "start", "direct", rs.direct);
+            out.sample("ledpanel_redirect_checks_total", "start", "chain", rs.chains);
+            out.family("ledpanel_redirect_saved_seconds_total", "counter", "Redirect hop time skipped by direct checks");
+            out.sampleSeconds("ledpanel_redirect_saved_seconds_total", rs.savedMs);
+            break;
+        }
+            
+        case 14: {
+            const RedirectCache::Stats& rs = redirectCache.stats();
+            out.family("ledpanel_redirect_hops_total", "counter", "Redirect hops followed and skipped");
+            out.sample("ledpanel_redirect_hops_total", "kind", "followed", rs.hopsFollowed);
+            out.sample("ledpanel_redirect_hops_total", "kind", "skipped", rs.hopsSkipped);
+            out.family("ledpanel_redirect_revalidations_total", "counter", "Redirect chains walked again to revalidate");
+            out.sample("ledpanel_redirect_revalidations_total", rs.revalidations);
+            break;
+        }
+            
+#ifdef MQTT_HOST
+        case 15:
+            out.family("ledpanel_mqtt_published_total", "counter", "MQTT messages published");
+            out.sample("ledpanel_mqtt_published_total", mqtt.published());
+            out.family("ledpanel_mqtt_outbox_dropped_total", "counter", "Events dropped from a full outbox");
+            out.sample("ledpanel_mqtt_outbox_dropped_total", mqtt.dropped());
+            out.family("ledpanel_mqtt_connected", "gauge", "1 if the MQTT session is up");
+            out.sample("ledpanel_mqtt_connected", static_cast<uint32_t>(mqtt.isConnected() ? 1 : 0));
+            break;
+#endif
+            
+        default:
+            return 0;
+    }
+    
+    return out.length();
+}
+
+/**
+ * MQTT client id from the chip id, so several panels can share a broker
+ */
+void setupMqtt() {
+#ifdef MQTT_HOST
+    snprintf_P(mqttClientId, sizeof(mqttClientId), PSTR("ledpanel-%06x"), ESP.getChipId());
+    mqttClient.setTimeout(MQTT_CONNECT_TIMEOUT);
+    LOG_INFO(MQTT, "Client id %s", mqttClientId);
+#endif
+}
+
+/**
+ * Drive the MQTT session and queue the periodic summary
+ *
+ * A reconnect can block for up to MQTT_CONNECT_TIMEOUT, so it is only
+ * allowed while a message rests on the panel and nothing is scrolling.
+ */
+void handleMqtt() {
+#ifdef MQTT_HOST
     uint32_t now = millis();
+    if (monitor.statusKnown() && now - state.lastSummary >= SUMMARY_INTERVAL) {
+        state.lastSummary = now;
+        publishSummary();
+    }
     
-    // Debounce
-    if (now - state.lastButtonPress < DEBOUNCE_DELAY) {
-        muteToggleRequest = false;
+    bool displayAtRest = (bitmapAnim.phase == BitmapPhase::PAUSE) ||
+                         (bitmapAnim.phase == BitmapPhase::IDLE && !state.messageScrolling);
+    mqtt.handle(now, monitor.wifiConnected() && displayAtRest);
+#endif
+}
+
+/**
+ * Retained, so a new subscriber sees the current state immediately
+ */
+void publishStatusChange(bool isUp, int code, uint32_t latencyMs) {
+#ifdef MQTT_HOST
+    char payload[MQTT_PAYLOAD_MAX];
+    snprintf_P(payload, sizeof(payload),
+        PSTR("{\"up\":%s,\"code\":%d,\"latency_ms\":%u,\"uptime_ms\":%u}"),
+        isUp ? "true" : "false", code, latencyMs, millis());
+    mqtt.publish(MQTT_TOPIC "/status", payload, true);
+#else
+    (void)isUp;
+    (void)code;
+    (void)latencyMs;
+#endif
+}
+
+void publishSummary() {
+#ifdef MQTT_HOST
+    char payload[MQTT_PAYLOAD_MAX];
+    snprintf_P(payload, sizeof(payload),
+        PSTR("{\"up\":%s,\"checks\":%u,\"failures\":%u,\"rssi\":%d,"
+             "\"free_heap\":%u,\"uptime_ms\":%u}"),
+        monitor.siteUp() ? "true" : "false", probeStats.checks(), probeStats.failures(),
+        static_cast<int>(WiFi.RSSI()), ESP.getFreeHeap(), millis());
+    mqtt.publish(MQTT_TOPIC "/summary", payload);
+#endif
+}
+
+/**
+ * Board and target ids and fleet key for the beacon; without PUSH_KEY
+ * the board stays out of the group and probes alone
+ */
+void setupBeacon() {
+    beaconState.boardId  = ESP.getChipId();
+    beaconState.targetId = Beacon::targetId(settings.siteUrl);
+#ifdef PUSH_KEY
+    beaconState.keyed = Push::parseKey(PUSH_KEY, beaconState.key);
+#endif
+    if (!beaconState.keyed) {
+        LOG_WARN(FLEET, "No valid PUSH_KEY; fleet beacon off, probing alone");
+    }
+}
+
+/**
+ * Join the beacon group once WiFi is up and read any pending beacons
+ */
+void handleBeacons() {
+    if (!beaconState.keyed || !monitor.wifiConnected()) {
+        if (beaconState.listening) {
+            beaconUdp.stop();
+            beaconState.listening = false;
+        }
         return;
     }
     
-    state.lastButtonPress = now;
-    muteToggleRequest = false;
+    uint32_t now = millis();
+    IPAddress group(BEACON_GROUP[0], BEACON_GROUP[1], BEACON_GROUP[2], BEACON_GROUP[3]);
+    if (!beaconState.listening) {
+        beaconState.listening = beaconUdp.beginMulticast(WiFi.localIP(), group, BEACON_PORT);
+        if (!beaconState.listening) return;
+        // Listen for a lease before claiming anything (also after WiFi loss)
+        election.begin(beaconState.boardId, beaconState.targetId, ELECTION_LEASE, now);
+    }
     
-    // Toggle mute state
-    state.isMuted = !state.isMuted;
+    uint8_t packet[Beacon::SIZE];
+    for (uint8_t i = 0; i < BEACON_RX_BUDGET; i++) {
+        int size = beaconUdp.parsePacket();
+        if (size <= 0) break;
+        
+        Beacon::Status status;
+        int got = (static_cast<size_t>(size) == sizeof(packet)) ? beaconUdp.read(packet, sizeof(packet)) : 0;
+        if (got <= 0 || !Beacon::decode(packet, got, beaconState.key, status)) {
+            beaconState.rejected++;
+            continue;  // Remainder is discarded by the next parsePacket()
+        }
+        if (status.boardId == beaconState.boardId) continue;  // Own multicast loopback
+        
+        beaconState.received++;
+        fleet.update(status, now);
+    }
     
-    DEBUG_PRINT(F("Mute toggled: "));
-    DEBUG_PRINTLN(state.isMuted ? F("ON") : F("OFF"));
+    fleet.expire(now, FLEET_TIMEOUT_CHECKS * settings.checkIntervalMs);
     
-    // Stop any playing tone
-    if (state.isMuted) {
-        noTone(BUZZ_PIN);
-        updateDisplay(MSG_MUTED);
+    if (election.update(fleet, now)) {
+        LOG_INFO(FLEET, "Election: %s", Election::roleName(election.role()));
+        if (election.isLeader()) {
+            monitor.checkSoon(now, settings.checkIntervalMs);  // Take over with a fresh check
+        }
+    }
+    
+    if (!election.isLeader()) {
+        mirrorLeaderResult(now);
+    }
+    
+    if (now - beaconState.lastSent >= BEACON_HEARTBEAT) {
+        sendBeacon();
+    }
+}
+
+/**
+ * Take the prober's latest check as our own, once per check
+ *
+ * The prober repeats its last result in every heartbeat; a result counts
+ * as new when its check time (heard time minus age) has moved on.
+ */
+void mirrorLeaderResult(uint32_t now) {
+    const FleetTable<FLEET_MAX>::Entry* e = fleet.find(election.leaderId());
+    if (!e || !e->status.valid() || e->status.targetId != beaconState.targetId) return;
+    
+    uint32_t checkedAt = e->heardAt - e->status.ageMs;
+    if (beaconState.mirrored > 0 &&
+        static_cast<int32_t>(checkedAt - beaconState.mirroredAt) < static_cast<int32_t>(BEACON_HEARTBEAT)) {
+        return;  // Same check, repeated
+    }
+    beaconState.mirroredAt = checkedAt;
+    beaconState.mirrored++;
+    monitor.checked(now);
+    
+    LOG_INFO(FLEET, "Mirrored result: %s", e->status.up() ? "UP" : "DOWN");
+    applyCheckResult(e->status.up(), e->status.httpCode, e->status.latencyMs);
+}
+
+/**
+ * Multicast our presence, and our latest check if we are the prober
+ */
+void sendBeacon() {
+    if (!beaconState.listening) return;
+    
+    uint32_t now = millis();
+    beaconState.lastSent = now;
+    
+    Beacon::Status status = {};
+    status.boardId   = beaconState.boardId;
+    status.targetId  = beaconState.targetId;
+    status.seq       = ++beaconState.seq;
+    status.term      = election.term();
+    if (election.isLeader()) {
+        status.flags = Beacon::FLAG_PROBER;
+        if (probeStats.checks() > 0) {
+            status.flags    |= Beacon::FLAG_VALID | (monitor.siteUp() ? Beacon::FLAG_UP : 0);
+            status.httpCode  = static_cast<int16_t>(probeStats.lastCode());
+            status.latencyMs = probeStats.lastLatency();
+            status.ageMs     = now - monitor.lastCheck();
+        }
+    }
+    
+    uint8_t packet[Beacon::SIZE];
+    Beacon::encode(status, beaconState.key, packet);
+    
+    IPAddress group(BEACON_GROUP[0], BEACON_GROUP[1], BEACON_GROUP[2], BEACON_GROUP[3]);
+    if (beaconUdp.beginPacketMulticast(group, BEACON_PORT, WiFi.localIP())) {
+        beaconUdp.write(packet, sizeof(packet));
+        beaconUdp.endPacket();
+    }
+}
+
+/**
+ * Update state, display, alert and MQTT from a check result (our own or
+ * the prober's)
+ */
+void applyCheckResult(bool isUp, int code, uint32_t latencyMs) {
+    // Latency only means something for a response; pushes carry none
+    bool slow = monitor.siteSlow();
+    if (isUp && latencyMs > 0) {
+        slow = latencyEwma.add(latencyMs);
+    }
+    
+    // Shows the result and sounds the alarm if down, a short chirp while slow
+    Monitor<PanelIo>::Change change = monitor.result(isUp, slow);
+    
+    slaTracker.update(millis(), isUp);
+    if (change.status) {
+        publishStatusChange(isUp, code, latencyMs);
+        logEvent(isUp ? Event::Type::SITE_UP : Event::Type::SITE_DOWN, code, latencyMs);
+    }
+    if (change.slow) {
+        LOG_WARN(PROBE, "Site %s: %u ms, mean %u sigma %u", monitor.siteSlow() ? "slow" : "back to normal",
+                 latencyMs, latencyEwma.meanMs(), latencyEwma.sigmaMs());
+        logEvent(monitor.siteSlow() ? Event::Type::SITE_SLOW : Event::Type::SITE_UP, code, latencyMs);
+    }
+}
+
+/**
+ * Push key and UDP listener; without PUSH_KEY every push is refused
+ */
+void setupPush() {
+#ifdef PUSH_KEY
+    pushState.enabled = pushVerifier.begin(PUSH_KEY);
+    if (!pushState.enabled) {
+        LOG_ERROR(PUSH, "PUSH_KEY must be 32 hex digits; pushes disabled");
+    }
+    if (pmRecord.flags & PostMortem::FLAG_PUSH_SEQ) {
+        pushVerifier.restore(pmRecord.pushSeq);
+    }
+#endif
+}
+
+/**
+ * Read pending push datagrams (bounded per pass)
+ */
+void handlePushUdp() {
+    if (!pushState.enabled) return;
+    
+    if (!monitor.wifiConnected()) {
+        if (pushState.listening) {
+            pushUdp.stop();
+            pushState.listening = false;
+        }
+        return;
+    }
+    if (!pushState.listening) {
+        pushState.listening = pushUdp.begin(PUSH_PORT);
+        if (!pushState.listening) return;
+    }
+    
+    char msg[Push::MESSAGE_MAX];
+    for (uint8_t i = 0; i < PUSH_RX_BUDGET; i++) {
+        int size = pushUdp.parsePacket();
+        if (size <= 0) break;
+        if (static_cast<size_t>(size) > sizeof(msg)) continue;  // Oversized, discarded
+        int got = pushUdp.read(reinterpret_cast<uint8_t*>(msg), sizeof(msg));
+        if (got > 0) acceptPush(msg, got);
+    }
+}
+
+/**
+ * POST /push: same message as the UDP datagram
+ */
+int handlePushPost(const char* body, size_t len) {
+    if (!pushState.enabled) return 404;
+    
+    switch (acceptPush(body, len)) {
+        case Push::Result::OK:      return 204;
+        case Push::Result::BAD_MAC: return 401;
+        case Push::Result::REPLAY:  return 409;
+        default:                    return 400;
+    }
+}
+
+/**
+ * Verify a push and act on it at once; repeats of the current state only
+ * refresh the push heartbeat
+ */
+Push::Result acceptPush(const char* msg, size_t len) {
+    Push::Status push;
+    Push::Result result = pushVerifier.verify(msg, len, push);
+    
+    LOG_INFO(PUSH, "Push: %s", Push::resultName(result));
+    if (result != Push::Result::OK) return result;
+    
+    pushState.accepted++;
+    pushState.lastAt = millis();
+    pmRecord.pushSeq = push.seq;  // Survives the next reset in RTC memory
+    pmRecord.flags  |= PostMortem::FLAG_PUSH_SEQ;
+    savePostMortem();
+    if (!monitor.statusKnown() || push.up != monitor.siteUp()) {
+        applyCheckResult(push.up, push.code, 0);
+    }
+    return result;
+}
+
+/**
+ * Normal polling, or a slow fallback while pushes keep arriving
+ */
+uint32_t checkInterval(uint32_t now) {
+    bool pushesFlowing = pushState.accepted > 0 && (now - pushState.lastAt < PUSH_SILENCE);
+    return pushesFlowing ? PUSH_FALLBACK_INTERVAL : settings.checkIntervalMs;
+}
+
+/**
+ * Compiled-in settings from config.h and the constants above
+ */
+ConfigStore::Values defaultSettings() {
+    ConfigStore::Values v;
+    v.checkIntervalMs = CHECK_INTERVAL;
+    v.httpTimeoutMs   = HTTP_TIMEOUT;
+    v.reconnectMs     = RECONNECT_INTERVAL;
+    v.intensity       = DISPLAY_INTENSITY;
+    v.scrollSpeed     = SCROLL_SPEED;
+    v.ssid            = SECRET_SSID;
+    v.pass            = SECRET_PASS;
+    v.siteUrl         = SITE_URL;
+    v.rules           = PROBE_RULES;
+    return v;
+}
+
+/**
+ * Mount LittleFS and apply /config.bin over the defaults, before
+ * anything reads the settings
+ */
+void setupConfig() {
+    settings = defaultSettings();
+
+    configState.mounted = LittleFS.begin();
+    if (!configState.mounted) {
+        LOG_WARN(CONFIG, "LittleFS mount failed; using compiled-in config");
     } else {
-        updateDisplay(MSG_UNMUTED);
-        // Brief confirmation beep
-        tone(BUZZ_PIN, 1000, 100);
+        loadConfig();
+        configState.lastPoll = millis();
+    }
+    compileRules();
+}
+
+/**
+ * Poll /config.bin and apply whatever changed, without a restart
+ */
+void handleConfig() {
+    uint32_t now = millis();
+    if (!configState.mounted || now - configState.lastPoll < CONFIG_POLL) return;
+    configState.lastPoll = now;
+
+    ConfigStore::Values prev = settings;
+    if (loadConfig()) {
+        applyConfigChanges(prev);
+    }
+}
+
+/**
+ * Read /config.bin into the spare buffer and switch to it if valid
+ *
+ * Only the header is read while the stored CRC matches the active (or
+ * last rejected) record, so polling an unchanged file is cheap. A bad
+ * record is reported and ignored; the current settings stay in force.
+ * Returns true if the settings were replaced.
+ */
+bool loadConfig() {
+    File f = LittleFS.open(CONFIG_PATH, "r");
+    if (!f) {
+        if (!config.valid()) return false;
+        LOG_INFO(CONFIG, "Removed; using compiled-in config");
+        config   = ConfigStore::Config();
+        settings = defaultSettings();
+        return true;
+    }
+
+    uint8_t* buf = configBuf[configState.active ^ 1];
+    size_t   len = f.read(buf, ConfigStore::PEEK_SIZE);
+    if (len == ConfigStore::PEEK_SIZE) {
+        uint32_t crc = ConfigStore::storedCrc(buf);
+        if ((config.valid() && crc == config.crc()) ||
+            (configState.rejected > 0 && crc == configState.rejectedCrc)) {
+            f.close();
+            return false;
+        }
+        if (f.size() <= ConfigStore::RECORD_MAX) {
+            len += f.read(buf + len, f.size() - len);
+        }
     }
+    size_t size = f.size();
+    f.close();
+
+    ConfigStore::Config next;
+    ConfigStore::Error  error = (size > ConfigStore::RECORD_MAX) ? ConfigStore::Error::BAD_LENGTH
+                                                                 : next.parse(buf, len);
+    if (error != ConfigStore::Error::NONE) {
+        configState.rejected++;
+        configState.rejectedCrc = (len >= ConfigStore::PEEK_SIZE) ? ConfigStore::storedCrc(buf) : 0;
+        configState.lastError   = error;
+        LOG_WARN(CONFIG, "Rejected: %s", ConfigStore::errorName(error));
+        return false;
+    }
+
+    ConfigStore::Values values = defaultSettings();
+    next.applyTo(values);
+    settings = values;
+    config   = next;
+    configState.active ^= 1;
+    configState.loads++;
+
+    LOG_INFO(CONFIG, "Loaded, crc %08x", config.crc());
+    return true;
+}
+
+/**
+ * Act on settings that are cached elsewhere; the rest are read where
+ * they are used and take effect on their own
+ */
+void applyConfigChanges(const ConfigStore::Values& prev) {
+    uint32_t now = millis();
+
+    if (settings.intensity != prev.intensity) {
+        display.setIntensity(settings.intensity);
+    }
+    if (settings.httpTimeoutMs != prev.httpTimeoutMs) {
+        state.probeReady = false;  // Client timeouts are set up once
+    }
+
+    if (strcmp(settings.siteUrl, prev.siteUrl) != 0) {
+        LOG_INFO(CONFIG, "New target %s", settings.siteUrl);
+        state.probeReady     = false;  // MFLN support is per server
+        monitor.checkSoon(now, settings.checkIntervalMs);
+        beaconState.targetId = Beacon::targetId(settings.siteUrl);
+        if (beaconState.listening) {
+            // Other boards may already probe this target
+            election.begin(beaconState.boardId, beaconState.targetId, ELECTION_LEASE, now);
+        }
+    }
+
+    if (strcmp(settings.rules, prev.rules) != 0) {
+        compileRules();
+    }
+
+    if (strcmp(settings.ssid, prev.ssid) != 0 || strcmp(settings.pass, prev.pass) != 0) {
+        LOG_INFO(CONFIG, "New WiFi credentials, reconnecting");
+        monitor.rejoin(now);
+        WiFi.begin(settings.ssid, settings.pass);
+    }
+}
+
+/**
+ * Write the current settings to /config.bin, storing only what differs
+ * from the compiled-in defaults (so a later reflash can still change the
+ * rest). Written to a temporary file first: a power cut leaves either
+ * the old or the new record, never half of one.
+ */
+bool saveConfig() {
+    if (!configState.mounted) return false;
     
-    // Show mute status briefly
-    display.displayText(msgBuffer, PA_CENTER, SCROLL_SPEED, 1500, PA_SCROLL_LEFT, PA_NO_EFFECT);
-    state.messageScrolling = true;
+    ConfigStore::Values d = defaultSettings();
+    ConfigStore::Values v = {};
+    if (settings.checkIntervalMs != d.checkIntervalMs) v.checkIntervalMs = settings.checkIntervalMs;
+    if (settings.httpTimeoutMs != d.httpTimeoutMs)     v.httpTimeoutMs   = settings.httpTimeoutMs;
+    if (settings.reconnectMs != d.reconnectMs)         v.reconnectMs     = settings.reconnectMs;
+    if (settings.intensity != d.intensity)             v.intensity       = settings.intensity;
+    if (settings.scrollSpeed != d.scrollSpeed)         v.scrollSpeed     = settings.scrollSpeed;
+    if (strcmp(settings.ssid, d.ssid) != 0)            v.ssid            = settings.ssid;
+    if (strcmp(settings.pass, d.pass) != 0)            v.pass            = settings.pass;
+    if (strcmp(settings.siteUrl, d.siteUrl) != 0)      v.siteUrl         = settings.siteUrl;
+    if (strcmp(settings.rules, d.rules) != 0)          v.rules           = settings.rules;
+    
+    // The spare buffer is free until the next poll, which reads this record back
+    uint8_t* buf = configBuf[configState.active ^ 1];
+    size_t   len = ConfigStore::build(v, buf, ConfigStore::RECORD_MAX);
+    if (len == 0) return false;
+    
+    File f = LittleFS.open(CONFIG_TMP_PATH, "w");
+    if (!f) return false;
+    bool written = (f.write(buf, len) == len);
+    f.close();
+    return written && LittleFS.rename(CONFIG_TMP_PATH, CONFIG_PATH);
+}
+
+/**
+ * Open the event log (needs LittleFS) and record why this boot happened;
+ * written at once so a crash loop still leaves one record per boot
+ */
+void setupEvents() {
+    if (!configState.mounted) return;
+    eventLog.begin();
+    eventState.enabled = true;
+
+    uint16_t section = bootReport.hasRecord ? bootReport.previous.section : 0xFFFF;
+    logEvent(Event::Type::RESET, static_cast<int>(bootReport.exccause), bootReport.reason, section);
+    eventLog.flush();
+    eventState.lastFlush = millis();
+}
+
+void logEvent(Event::Type type, int code, uint32_t value, uint16_t extra) {
+    if (!eventState.enabled) return;
+    Event::Record r;
+    r.type     = type;
+    r.code     = static_cast<int16_t>(code);
+    r.boot     = static_cast<uint16_t>(pmRecord.bootCount);
+    r.extra    = extra;
+    r.uptimeMs = millis();
+    r.value    = value;
+    eventLog.append(r);
+}
+
+/**
+ * Flush events that have waited EVENT_FLUSH_INTERVAL; full batches are
+ * written by append() itself
+ */
+void handleEvents() {
+    uint32_t now = millis();
+    if (!eventState.enabled || now - eventState.lastFlush < EVENT_FLUSH_INTERVAL) return;
+    eventState.lastFlush = now;
+
+    if (eventLog.pending() > 0 && !eventLog.flush()) {
+        LOG_WARN(EVENT, "Event log write failed, %u events queued",
+                 static_cast<unsigned>(eventLog.pending()));
+    }
+}
+
+/**
+ * Raw event records, oldest first, one buffer's worth per part
+ * (decode with tools/eventlog.py)
+ */
+size_t renderEvents(uint8_t part, char* buf, size_t cap) {
+    if (!eventState.enabled) return 0;
+    size_t per = cap / Event::RECORD_SIZE;
+    return eventLog.read(part * per, reinterpret_cast<uint8_t*>(buf), per) * Event::RECORD_SIZE;
+}
+
+/**
+ * Read pending console input (bounded per pass) and run complete lines
+ *
+ * Replies are short and only follow a typed command, so they go straight
+ * to Serial.
+ */
+void handleConsole() {
+    for (uint8_t i = 0; i < CONSOLE_RX_BUDGET && Serial.available() > 0; i++) {
+        if (!consoleLine.feed(static_cast<char>(Serial.read()))) continue;
+        
+        const Console::Command* cmd = nullptr;
+        switch (Console::dispatch(CONSOLE_COMMANDS, CONSOLE_COMMAND_COUNT, consoleLine.line(), &cmd)) {
+            case Console::Result::OK:
+            case Console::Result::EMPTY:
+                break;
+            case Console::Result::UNKNOWN:
+                Serial.println(F("Unknown command (try help)"));
+                break;
+            default:
+                Serial.printf_P(PSTR("Usage: %s %s\n"), cmd->name, cmd->usage);
+                break;
+        }
+        Serial.print(F("> "));
+    }
+}
+
+bool cmdHelp(uint8_t argc, char** argv) {
+    for (size_t i = 0; i < CONSOLE_COMMAND_COUNT; i++) {
+        Serial.printf_P(PSTR("  %s %s\n"), CONSOLE_COMMANDS[i].name, CONSOLE_COMMANDS[i].usage);
+    }
+    return true;
+}
+
+bool cmdStatus(uint8_t argc, char** argv) {
+    uint32_t now = millis();
+    Serial.printf_P(PSTR("site %s: %s code=%d latency=%ums checks=%u failures=%u\n"),
+                    settings.siteUrl,
+                    monitor.statusKnown() ? (monitor.siteUp() ? (monitor.siteSlow() ? "SLOW" : "UP") : "DOWN") : "unknown",
+                    probeStats.lastCode(), probeStats.lastLatency(), probeStats.checks(),
+                    probeStats.failures());
+    const RedirectCache::Cache<1>::Entry* redirect = redirectCache.entry(settings.siteUrl);
+    char finalUrl[HttpProbe::HOST_MAX + HttpProbe::PATH_MAX + 16] = "none";
+    if (redirect) HttpProbe::formatUrl(redirect->url, finalUrl, sizeof(finalUrl));
+    Serial.printf_P(PSTR("redirect %s hops=%u direct=%u chains=%u skipped=%u saved=%ums\n"),
+                    finalUrl, redirect ? redirect->hops : 0, redirectCache.stats().direct,
+                    redirectCache.stats().chains, redirectCache.stats().hopsSkipped,
+                    redirectCache.stats().savedMs);
+    Serial.printf_P(PSTR("wifi %s rssi=%d reconnects=%u\n"),
+                    monitor.wifiConnected() ? "connected" : "down", static_cast<int>(WiFi.RSSI()),
+                    monitor.reconnects());
+    Serial.printf_P(PSTR("role %s term=%u leader=%06x peers=%u pushes=%u\n"),
+                    Election::roleName(election.role()), election.term(), election.leaderId(),
+                    static_cast<unsigned>(fleet.count()), pushState.accepted);
+    Serial.printf_P(PSTR("interval=%ums (last %ums ago) timeout=%ums intensity=%u speed=%u muted=%s\n"),
+                    checkInterval(now), now - monitor.lastCheck(), settings.httpTimeoutMs,
+                    settings.intensity, settings.scrollSpeed, monitor.muted() ? "yes" : "no");
+    Serial.printf_P(PSTR("heap free=%u block=%u frag=%u%% loop max=%uus uptime=%ums config=%s\n"),
+                    ESP.getFreeHeap(), ESP.getMaxFreeBlockSize(), ESP.getHeapFragmentation(),
+                    loopStats.maxUs, now, config.valid() ? "file" : "default");
+    return true;
+}
+
+bool cmdHist(uint8_t argc, char** argv) {
+    uint32_t below = 0;
+    for (size_t b = 0; b <= LATENCY_BUCKET_COUNT; b++) {
+        uint32_t cumulative = probeStats.bucketCumulative(b);
+        if (b < LATENCY_BUCKET_COUNT) {
+            Serial.printf_P(PSTR("  <=%5ums %u\n"), LATENCY_BUCKETS_MS[b], cumulative - below);
+        } else {
+            Serial.printf_P(PSTR("   >%5ums %u\n"), LATENCY_BUCKETS_MS[b - 1], cumulative - below);
+        }
+        below = cumulative;
+    }
+    
+    Serial.print(F("failures"));
+    for (uint8_t c = 0; c < static_cast<uint8_t>(FailureClass::COUNT); c++) {
+        FailureClass fc = static_cast<FailureClass>(c);
+        Serial.printf_P(PSTR(" %s=%u"), failureClassName(fc), probeStats.failures(fc));
+    }
+    Serial.print(F("\nrecent ms"));
+    for (size_t i = 0; i < probeStats.count(); i++) {
+        Serial.printf_P(PSTR(" %u"), probeStats.latency(i));
+    }
+    Serial.println();
+    return true;
+}
+
+/**
+ * Print availability, incidents, MTTR and MTBF per window, and scroll
+ * the day and week availability across the panel
+ */
+bool cmdSla(uint8_t argc, char** argv) {
+    slaTracker.tick(millis());
+    for (uint8_t w = 0; w < static_cast<uint8_t>(Sla::Window::COUNT); w++) {
+        const Sla::Summary& s = slaTracker.summary(static_cast<Sla::Window>(w));
+        uint32_t ppm = s.availabilityPpm();
+        Serial.printf_P(PSTR("%3s %3u.%04u%% known=%us incidents=%u mttr=%us mtbf=%us\n"),
+                        Sla::windowName(static_cast<Sla::Window>(w)), ppm / 10000, ppm % 10000,
+                        s.knownS(), s.incidents, s.mttrS(), s.mtbfS());
+    }
+
+    uint32_t day  = slaTracker.summary(Sla::Window::DAY).availabilityPpm();
+    uint32_t week = slaTracker.summary(Sla::Window::WEEK).availabilityPpm();
+    char text[sizeof(msgBuffer)];
+    snprintf_P(text, sizeof(text), PSTR("24h %u.%02u%% 7d %u.%02u%%"),
+               day / 10000, day / 100 % 100, week / 10000, week / 100 % 100);
+    showText(text);
+    return true;
+}
+
+bool cmdCheck(uint8_t argc, char** argv) {
+    if (!monitor.wifiConnected()) {
+        Serial.println(F("WiFi is down"));
+    } else if (!election.shouldProbe(beaconState.listening)) {
+        Serial.printf_P(PSTR("Board %06x probes this site\n"), election.leaderId());
+    } else {
+        uint32_t now = millis();
+        monitor.checkSoon(now, checkInterval(now));  // Due on this loop pass
+        Serial.println(F("Checking"));
+    }
+    return true;
+}
+
+bool cmdInterval(uint8_t argc, char** argv) {
+    if (argc > 1) {
+        uint32_t ms;
+        if (!Console::parseUint(argv[1], ms) || ms < ConfigStore::CHECK_MIN) return false;
+        settings.checkIntervalMs = ms;
+    }
+    Serial.printf_P(PSTR("interval=%ums\n"), settings.checkIntervalMs);
+    return true;
+}
+
+bool cmdIntensity(uint8_t argc, char** argv) {
+    if (argc > 1) {
+        uint32_t level;
+        if (!Console::parseUint(argv[1], level) || level > 15) return false;
+        settings.intensity = static_cast<uint8_t>(level);
+        display.setIntensity(settings.intensity);
+    }
+    Serial.printf_P(PSTR("intensity=%u\n"), settings.intensity);
+    return true;
+}
+
+bool cmdMute(uint8_t argc, char** argv) {
+    bool muted = !monitor.muted();
+    if (argc > 1) {
+        if (strcmp(argv[1], "on") == 0)       muted = true;
+        else if (strcmp(argv[1], "off") == 0) muted = false;
+        else return false;
+    }
+    if (muted != monitor.muted()) {
+        setMuted(muted);
+    }
+    Serial.printf_P(PSTR("muted=%s\n"), monitor.muted() ? "yes" : "no");
+    return true;
+}
+
+bool cmdSave(uint8_t argc, char** argv) {
+    Serial.println(saveConfig() ? F("Saved to /config.bin") : F("Save failed"));
+    return true;
+}
+
+void handleMuteToggle() {
+    muteToggleRequest = false;
+    
+    // Debounced toggle
+    if (monitor.button(millis())) {
+        LOG_INFO(UI, "Mute %s", monitor.muted() ? "on" : "off");
+    }
+}
+
+void setMuted(bool muted) {
+    monitor.setMuted(muted);
+    LOG_INFO(UI, "Mute %s", muted ? "on" : "off");
 }
 
 void updateDisplay(const char* msg, bool fromProgmem) {
@@ -346,14 +1861,139 @@ void updateDisplay(const char* msg, bool fromProgmem) {
     }
 }
 
-void showStatus(bool isUp) {
-    if (isUp) {
-        updateDisplay(MSG_SITE_UP);
-    } else {
-        updateDisplay(MSG_SITE_DOWN);
+/**
+ * Start showing a pre-rendered message, bypassing MD_Parola
+ *
+ * Mirrors the Parola effects used here: optional scroll-in from the right,
+ * a pause at the centered position, and optional scroll-out to the left.
+ * Messages wider than the panel rest with their tail visible.
+ */
+void showBitmap(BitmapText::View bmp, bool scrollIn, uint16_t pause, bool scrollOut) {
+    int16_t width = bmp.width;
+    
+    bitmapAnim.bmp       = bmp;
+    bitmapAnim.restX     = (width <= DISPLAY_COLUMNS) ? (DISPLAY_COLUMNS - width) / 2
+                                                      : DISPLAY_COLUMNS - width;
+    bitmapAnim.x         = scrollIn ? DISPLAY_COLUMNS : bitmapAnim.restX;
+    bitmapAnim.pause     = pause;
+    bitmapAnim.scrollOut = scrollOut;
+    bitmapAnim.phase     = scrollIn ? BitmapPhase::SCROLL_IN : BitmapPhase::PAUSE;
+    bitmapAnim.lastStep  = millis();
+    
+    display.displayClear();
+    drawBitmapFrame();
+}
+
+/**
+ * Advance the bitmap animation; returns true once it has finished
+ */
+bool animateBitmap() {
+    if (bitmapAnim.phase == BitmapPhase::IDLE) {
+        return true;
+    }
+    
+    uint32_t now = millis();
+    
+    switch (bitmapAnim.phase) {
+        case BitmapPhase::SCROLL_IN:
+            if (now - bitmapAnim.lastStep < settings.scrollSpeed) return false;
+            bitmapAnim.lastStep = now;
+            if (--bitmapAnim.x <= bitmapAnim.restX) {
+                bitmapAnim.x = bitmapAnim.restX;
+                bitmapAnim.phase = BitmapPhase::PAUSE;
+            }
+            break;
+            
+        case BitmapPhase::PAUSE:
+            // A zero pause holds until the next message replaces this one,
+            // unless a scroll-out follows immediately
+            if (bitmapAnim.pause == 0 && !bitmapAnim.scrollOut) return true;
+            if (now - bitmapAnim.lastStep < bitmapAnim.pause) return false;
+            bitmapAnim.lastStep = now;
+            if (!bitmapAnim.scrollOut) {
+                bitmapAnim.phase = BitmapPhase::IDLE;
+                return true;
+            }
+            bitmapAnim.phase = BitmapPhase::SCROLL_OUT;
+            return false;
+            
+        case BitmapPhase::SCROLL_OUT:
+            if (now - bitmapAnim.lastStep < settings.scrollSpeed) return false;
+            bitmapAnim.lastStep = now;
+            if (--bitmapAnim.x <= -static_cast<int16_t>(bitmapAnim.bmp.width)) {
+                bitmapAnim.phase = BitmapPhase::IDLE;
+                return true;
+            }
+            break;
+            
+        default:
+            return true;
+    }
+    
+    drawBitmapFrame();
+    return false;
+}
+
+/**
+ * Copy the visible window of the bitmap straight to the panel
+ */
+void drawBitmapFrame() {
+    uint8_t frame[DISPLAY_COLUMNS];
+    
+    for (int16_t col = 0; col < DISPLAY_COLUMNS; col++) {
+        int16_t src = col - bitmapAnim.x;
+        frame[col] = (src >= 0 && src < bitmapAnim.bmp.width)
+                   ? pgm_read_byte(&bitmapAnim.bmp.cols[src]) : 0;
+    }
+    
+    panelBus.writeFrame(frame);
+}
+
+void PanelIo::show(Screen screen) {
+    switch (screen) {
+        case Screen::SITE_UP:
+            showBitmap(BitmapText::view(MSG_SITE_UP), true, 0, true);
+            break;
+        case Screen::SITE_DOWN:
+            showBitmap(BitmapText::view(MSG_SITE_DOWN), true, 0, true);
+            break;
+        case Screen::SITE_SLOW:
+            showBitmap(BitmapText::view(MSG_SITE_SLOW), true, 0, true);
+            break;
+        case Screen::MUTED:
+            showBitmap(BitmapText::view(MSG_MUTED), true, 1500, false);
+            break;
+        case Screen::UNMUTED:
+            showBitmap(BitmapText::view(MSG_UNMUTED), true, 1500, false);
+            break;
+        case Screen::WIFI_RECONNECT:
+            // Stays up while WiFi.reconnect() blocks; no scroll to wait for
+            showBitmap(BitmapText::view(MSG_WIFI_RECONNECT), true, 0, false);
+            return;
     }
     
-    display.displayText(msgBuffer, PA_CENTER, SCROLL_SPEED, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
+    state.messageScrolling = true;
+}
+
+void PanelIo::alarm(bool on) {
+    playAlertTone(on);
+}
+
+void PanelIo::chirp() {
+    playSlowChirp();
+}
+
+void PanelIo::beep() {
+    tone(BUZZ_PIN, 1000, 100);   // Brief unmute confirmation
+}
+
+/**
+ * Scroll runtime text once across the panel with MD_Parola
+ */
+void showText(const char* text) {
+    updateDisplay(text, false);
+    bitmapAnim.phase = BitmapPhase::IDLE;
+    display.displayText(msgBuffer, PA_LEFT, settings.scrollSpeed, 0, PA_SCROLL_LEFT, PA_SCROLL_LEFT);
     state.messageScrolling = true;
 }
 
@@ -363,4 +2003,11 @@ void playAlertTone(bool enable) {
     } else {
         noTone(BUZZ_PIN);
     }
+}
+
+/**
+ * Softer than the outage alarm: one short, lower tone that stops by itself
+ */
+void playSlowChirp() {
+    tone(BUZZ_PIN, SLOW_TONE_HZ, SLOW_TONE_MS);
 }
\ No newline at end of file
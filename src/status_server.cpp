@@ -0,0 +1,165 @@
+/**
+ * LED-Panel-ESP12F - Status HTTP Server
+ *
+ * See include/status_server.h
+ */
+
+#include "status_server.h"
+
+StatusServer::StatusServer(uint16_t port, const Route* routes, uint8_t routeCount)
+    : _server(port), _routes(routes), _routeCount(routeCount) {}
+
+void StatusServer::begin() {
+    _server.begin();
+    _server.setNoDelay(true);
+}
+
+void StatusServer::handle() {
+    uint32_t now = millis();
+
+    switch (_phase) {
+        case Phase::IDLE: {
+            WiFiClient incoming = _server.accept();
+            if (!incoming) return;
+            _client = incoming;
+            _client.setNoDelay(true);
+            _request.reset();
+            _started = now;
+            _phase   = Phase::READING;
+            return;
+        }
+
+        case Phase::READING: {
+            size_t budget = READ_BUDGET;
+            while (budget-- > 0 && _client.available() > 0) {
+                if (!_request.feed(static_cast<char>(_client.read()))) break;
+            }
+            if (_request.done() || _request.failed()) {
+                startResponse();
+            } else if (!_client.connected() || now - _started >= REQUEST_TIMEOUT) {
+                close();
+            }
+            return;
+        }
+
+        case Phase::BODY: {
+            size_t want = static_cast<size_t>(_request.contentLength());
+            size_t budget = READ_BUDGET;
+            while (budget-- > 0 && _len < want && _client.available() > 0) {
+                int c = _client.read();
+                if (c < 0) break;
+                _buf[_len++] = static_cast<char>(c);
+            }
+            if (_len >= want) {
+                respond(_route->post(_buf, _len), "text/plain");
+            } else if (!_client.connected() || now - _started >= REQUEST_TIMEOUT) {
+                close();
+            }
+            return;
+        }
+
+        case Phase::SENDING: {
+            if (!_client.connected() || now - _started >= REQUEST_TIMEOUT) {
+                close();
+                return;
+            }
+            if (_sent >= _len && !fillNextPart()) {
+                close();
+                return;
+            }
+
+            // Only write what the TCP window takes right now
+            size_t room = _client.availableForWrite();
+            size_t n    = _len - _sent;
+            if (n > room) n = room;
+            if (n > 0) {
+                size_t written = _client.write(reinterpret_cast<const uint8_t*>(_buf + _sent), n);
+                _sent += written;
+                if (written > 0) _started = now;  // Idle timeout: a long body may take many windows
+            }
+            return;
+        }
+    }
+}
+
+void StatusServer::startResponse() {
+    _requests++;
+    _route = nullptr;
+    _part  = 0;
+    _sent  = 0;
+
+    if (!_request.done()) {
+        respond(400, "text/plain");
+        return;
+    }
+
+    for (uint8_t i = 0; i < _routeCount; i++) {
+        if (_request.isPath(_routes[i].path)) {
+            _route = &_routes[i];
+            break;
+        }
+    }
+    if (!_route) {
+        respond(404, "text/plain");
+        return;
+    }
+
+    if (_request.isMethod("GET") && _route->render) {
+        respond(200, _route->contentType);
+    } else if (_request.isMethod("POST") && _route->post) {
+        int32_t length = _request.contentLength();
+        if (length < 0) {
+            respond(411, "text/plain");
+        } else if (static_cast<size_t>(length) > BODY_MAX) {
+            respond(413, "text/plain");
+        } else {
+            _len   = 0;
+            _phase = Phase::BODY;
+        }
+    } else {
+        respond(405, "text/plain");
+    }
+}
+
+/**
+ * Queue the response head; 200 streams the route's parts after it, any
+ * other code carries its reason phrase as the body
+ */
+void StatusServer::respond(int code, const char* type) {
+    const char* reason;
+    switch (code) {
+        case 200: reason = "OK";                     break;
+        case 204: reason = "No Content";             break;
+        case 400: reason = "Bad Request";            break;
+        case 401: reason = "Unauthorized";           break;
+        case 404: reason = "Not Found";              break;
+        case 405: reason = "Method Not Allowed";     break;
+        case 409: reason = "Conflict";               break;
+        case 411: reason = "Length Required";        break;
+        case 413: reason = "Payload Too Large";      break;
+        default:  reason = "Internal Server Error";  code = 500; break;
+    }
+
+    bool streamBody = (code == 200 && _route && _route->render && _request.isMethod("GET"));
+    int n = snprintf_P(_buf, sizeof(_buf),
+                       PSTR("HTTP/1.0 %d %s\r\nContent-Type: %s\r\nCache-Control: no-store\r\n"
+                            "Connection: close\r\n\r\n%s"),
+                       code, reason, type, (streamBody || code == 204) ? "" : reason);
+    _len     = (n > 0) ? static_cast<size_t>(n) : 0;
+    _sent    = 0;
+    _started = millis();
+    if (!streamBody) _route = nullptr;
+    _phase   = Phase::SENDING;
+}
+
+bool StatusServer::fillNextPart() {
+    if (!_route) return false;
+    _len  = _route->render(_part++, _buf, sizeof(_buf));
+    _sent = 0;
+    return _len > 0;
+}
+
+void StatusServer::close() {
+    _client.stop();
+    _phase = Phase::IDLE;
+}
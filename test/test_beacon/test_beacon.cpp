@@ -0,0 +1,233 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_beacon.cpp
+ *
+ * Tests for the fleet status beacon and peer table
+ * (include/beacon.h, include/fleet_table.h)
+ *
+ * Run with: pio test -e native -f test_beacon
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "beacon.h"
+#include "fleet_table.h"
+
+static const uint8_t KEY[SipHash::KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f};
+
+static Beacon::Status make(uint32_t board, uint32_t seq, bool up = true) {
+    Beacon::Status s = {};
+    s.boardId   = board;
+    s.targetId  = Beacon::targetId("https://example.com/");
+    s.seq       = seq;
+    s.flags     = Beacon::FLAG_VALID | (up ? Beacon::FLAG_UP : 0);
+    s.httpCode  = up ? 200 : -11;
+    s.latencyMs = 321;
+    s.ageMs     = 0;
+    return s;
+}
+
+// ============== Tests: Packet ==============
+
+void test_roundtrip(void) {
+    Beacon::Status in = make(0xABCDEF, 42, false);
+    in.term  = 7;
+    in.ageMs = 1500;
+    uint8_t packet[Beacon::SIZE];
+    Beacon::encode(in, KEY, packet);
+
+    Beacon::Status out;
+    TEST_ASSERT_TRUE(Beacon::decode(packet, sizeof(packet), KEY, out));
+    TEST_ASSERT_EQUAL_HEX32(0xABCDEF, out.boardId);
+    TEST_ASSERT_EQUAL_HEX32(in.targetId, out.targetId);
+    TEST_ASSERT_EQUAL_UINT32(42, out.seq);
+    TEST_ASSERT_FALSE(out.up());
+    TEST_ASSERT_TRUE(out.valid());
+    TEST_ASSERT_EQUAL_INT(-11, out.httpCode);
+    TEST_ASSERT_EQUAL_UINT16(7, out.term);
+    TEST_ASSERT_EQUAL_UINT32(321, out.latencyMs);
+    TEST_ASSERT_EQUAL_UINT32(1500, out.ageMs);
+}
+
+void test_wire_layout_is_little_endian(void) {
+    Beacon::Status in = make(0x11223344, 0x01020304);
+    uint8_t packet[Beacon::SIZE];
+    Beacon::encode(in, KEY, packet);
+    static const uint8_t header[] = {'L', 'P', Beacon::VERSION,
+                                     Beacon::FLAG_VALID | Beacon::FLAG_UP,
+                                     0x44, 0x33, 0x22, 0x11};
+    TEST_ASSERT_EQUAL_MEMORY(header, packet, sizeof(header));
+    TEST_ASSERT_EQUAL_HEX8(0x04, packet[12]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, packet[15]);
+}
+
+void test_rejects_corruption(void) {
+    uint8_t packet[Beacon::SIZE];
+    Beacon::encode(make(1, 1), KEY, packet);
+    Beacon::Status out;
+
+    packet[20] ^= 0x01;
+    TEST_ASSERT_FALSE(Beacon::decode(packet, sizeof(packet), KEY, out));
+}
+
+void test_rejects_wrong_size_and_version(void) {
+    uint8_t packet[Beacon::SIZE + 1];
+    Beacon::encode(make(1, 1), KEY, packet);
+    Beacon::Status out;
+
+    TEST_ASSERT_FALSE(Beacon::decode(packet, Beacon::SIZE - 1, KEY, out));
+    TEST_ASSERT_FALSE(Beacon::decode(packet, Beacon::SIZE + 1, KEY, out));
+    packet[2] = Beacon::VERSION + 1;
+    TEST_ASSERT_FALSE(Beacon::decode(packet, Beacon::SIZE, KEY, out));
+}
+
+void test_rejects_forged_prober_claim(void) {
+    // A LAN host without the key claims to be the prober with the site up
+    Beacon::Status forged = make(0x00000001, 1);
+    forged.flags |= Beacon::FLAG_PROBER;
+    forged.term   = 0xFFFF;
+    uint8_t packet[Beacon::SIZE];
+    static const uint8_t guess[SipHash::KEY_SIZE] = {};
+    Beacon::encode(forged, guess, packet);
+    Beacon::Status out;
+    TEST_ASSERT_FALSE(Beacon::decode(packet, sizeof(packet), KEY, out));
+
+    // Flipping flags on a genuine packet breaks its tag too
+    Beacon::encode(make(2, 1, false), KEY, packet);
+    packet[3] |= Beacon::FLAG_PROBER | Beacon::FLAG_UP;
+    TEST_ASSERT_FALSE(Beacon::decode(packet, sizeof(packet), KEY, out));
+}
+
+void test_tag_is_siphash_of_the_header(void) {
+    uint8_t packet[Beacon::SIZE];
+    Beacon::encode(make(1, 1), KEY, packet);
+    uint64_t expected = SipHash::hash(KEY, packet, 28);
+    for (int i = 0; i < 8; i++) {
+        TEST_ASSERT_EQUAL_HEX8(static_cast<uint8_t>(expected >> (8 * i)), packet[28 + i]);
+    }
+}
+
+void test_target_id_is_fnv1a(void) {
+    TEST_ASSERT_EQUAL_HEX32(0x811C9DC5, Beacon::targetId(""));
+    TEST_ASSERT_EQUAL_HEX32(0xE40C292C, Beacon::targetId("a"));
+    TEST_ASSERT_NOT_EQUAL(Beacon::targetId("https://a/"), Beacon::targetId("https://b/"));
+}
+
+void test_seq_comparison_wraps(void) {
+    TEST_ASSERT_TRUE(Beacon::seqNewer(2, 1));
+    TEST_ASSERT_FALSE(Beacon::seqNewer(1, 1));
+    TEST_ASSERT_TRUE(Beacon::seqNewer(0, 0xFFFFFFFF));
+}
+
+// ============== Tests: Fleet Table ==============
+
+void test_table_ignores_stale_and_duplicates(void) {
+    FleetTable<4> table;
+    TEST_ASSERT_TRUE(table.update(make(1, 10), 0));
+    TEST_ASSERT_FALSE(table.update(make(1, 10), 5));
+    TEST_ASSERT_FALSE(table.update(make(1, 9), 5));
+    TEST_ASSERT_TRUE(table.update(make(1, 11), 5));
+    TEST_ASSERT_EQUAL(1, table.count());
+    TEST_ASSERT_EQUAL_UINT32(2, table.stale());
+}
+
+void test_table_accepts_seq_reset_after_reboot(void) {
+    FleetTable<4> table;
+    table.update(make(1, 500), 0);
+    TEST_ASSERT_TRUE(table.update(make(1, 1), 100));
+    TEST_ASSERT_EQUAL_UINT32(1, table.at(0).status.seq);
+}
+
+void test_table_evicts_stalest_when_full(void) {
+    FleetTable<2> table;
+    table.update(make(1, 1), 0);
+    table.update(make(2, 1), 100);
+    table.update(make(3, 1), 200);
+    TEST_ASSERT_EQUAL(2, table.count());
+    TEST_ASSERT_NULL(table.find(1));
+    TEST_ASSERT_NOT_NULL(table.find(3));
+    TEST_ASSERT_EQUAL_UINT32(1, table.evicted());
+}
+
+void test_table_expires_silent_boards(void) {
+    FleetTable<4> table;
+    table.update(make(1, 1), 0);
+    table.update(make(2, 1), 5000);
+    table.expire(9000, 6000);
+    TEST_ASSERT_EQUAL(1, table.count());
+    TEST_ASSERT_EQUAL_UINT32(2, table.at(0).status.boardId);
+}
+
+void test_freshest_result_for_target(void) {
+    FleetTable<4> table;
+    Beacon::Status old = make(1, 1, false);
+    old.ageMs = 4000;
+    Beacon::Status other = make(3, 1);
+    other.targetId = Beacon::targetId("https://other/");
+    table.update(old, 1000);
+    table.update(make(2, 1), 1000);
+    table.update(other, 1000);
+
+    const FleetTable<4>::Entry* e = table.freshestFor(make(0, 0).targetId, 2000, 10000);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_UINT32(2, e->status.boardId);
+
+    // Age counts time since it was heard
+    TEST_ASSERT_NULL(table.freshestFor(make(0, 0).targetId, 20000, 10000));
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    // Nothing to set up
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Packet
+    RUN_TEST(test_roundtrip);
+    RUN_TEST(test_wire_layout_is_little_endian);
+    RUN_TEST(test_rejects_corruption);
+    RUN_TEST(test_rejects_wrong_size_and_version);
+    RUN_TEST(test_rejects_forged_prober_claim);
+    RUN_TEST(test_tag_is_siphash_of_the_header);
+    RUN_TEST(test_target_id_is_fnv1a);
+    RUN_TEST(test_seq_comparison_wraps);
+
+    // Fleet table
+    RUN_TEST(test_table_ignores_stale_and_duplicates);
+    RUN_TEST(test_table_accepts_seq_reset_after_reboot);
+    RUN_TEST(test_table_evicts_stalest_when_full);
+    RUN_TEST(test_table_expires_silent_boards);
+    RUN_TEST(test_freshest_result_for_target);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,384 @@
+/**
+ * Benchmarks for LED-Panel-ESP12F
+ * Test File: test_benchmark.cpp
+ *
+ * Times the hot paths of a check and of the display (include/bench.h):
+ *
+ * - probe.*    status line and headers, rules over a streamed JSON body,
+ *              a whole in-memory exchange
+ * - display.*  text rendering, scroll frame assembly, MAX7219 packing
+ * - loop.*     a loop() pass with nothing due, console command dispatch
+ * - mem.*      static footprint of the probe and rules; on the board also
+ *              the stack high-water mark and lowest free heap seen
+ * - tls.*      on the board only, with BENCH_WIFI_SSID, BENCH_WIFI_PASS
+ *              and BENCH_TLS_HOST defined: full and resumed handshakes
+ *
+ * Each result is printed as a JSON line; with BENCH_OUT defined (the
+ * native_bench environment) the lines also go to that file. Compare two
+ * runs with tools/benchcmp.py. The assertions only check that each path
+ * still does its job; the numbers are reported, not asserted.
+ *
+ * Run with: pio test -e native_bench   (or -e esp12e_bench on the board)
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "bench.h"
+#include "bench_clock.h"
+#include "http_probe.h"
+#include "probe_rules.h"
+#include "bitmap_text.h"
+#include "max7219_frame.h"
+#include "monitor.h"
+#include "console.h"
+
+#if defined(ARDUINO) && defined(BENCH_TLS_HOST)
+#include <ESP8266WiFi.h>
+#include <WiFiClientSecureBearSSL.h>
+#endif
+
+using namespace HttpProbe;
+
+#ifdef ARDUINO
+static const char     TARGET[] = "esp8266";
+static const uint32_t MIN_US   = 50000;
+#else
+static const char     TARGET[] = "native";
+static const uint32_t MIN_US   = 20000;
+#endif
+
+constexpr uint8_t  DEVICES = 4;                 // As in src/main.cpp
+constexpr uint16_t COLUMNS = DEVICES * 8;
+
+static volatile uint32_t sink;                  // Keeps results alive
+
+// ============== Clock and Reporting ==============
+
+static Bench::Clock benchClock;
+
+static FILE* out = nullptr;
+#ifdef ARDUINO
+static uint32_t heapFreeMin = 0xFFFFFFFF;
+#endif
+
+static void report(const Bench::Result& r) {
+    char line[Bench::LINE_SIZE];
+    TEST_ASSERT_TRUE(Bench::format(r, TARGET, line, sizeof(line)) > 0);
+    TEST_MESSAGE(line);
+    if (out) fprintf(out, "%s\n", line);
+#ifdef ARDUINO
+    uint32_t heap = ESP.getFreeHeap();
+    if (heap < heapFreeMin) heapFreeMin = heap;
+#endif
+}
+
+// ============== In-memory Server ==============
+
+static const char HEALTH_JSON[] =
+    "{\"status\":\"ok\",\"version\":\"1.4.2\",\"checks\":{\"db\":{\"status\":\"up\",\"latency_ms\":12},"
+    "\"cache\":\"up\"},\"nodes\":[{\"ok\":true},{\"ok\":true}],\"uptime\":86400}";
+
+static char response[512];
+static size_t responseLen;
+
+static void buildResponse() {
+    responseLen = snprintf(response, sizeof(response),
+                           "HTTP/1.1 200 OK\r\nServer: nginx\r\nDate: Fri, 16 Oct 2026 09:00:00 GMT\r\n"
+                           "Content-Type: application/json\r\nX-Health: 1\r\nCache-Control: no-store\r\n"
+                           "Content-Length: %u\r\n\r\n%s",
+                           static_cast<unsigned>(strlen(HEALTH_JSON)), HEALTH_JSON);
+}
+
+struct MemClient {
+    size_t pos = 0;
+    bool connect(const char*, uint16_t) { pos = 0; return true; }
+    size_t write(const uint8_t*, size_t len) { return len; }
+    int available() { return static_cast<int>(responseLen - pos); }
+    int read(uint8_t* buf, size_t len) {
+        size_t n = (len < responseLen - pos) ? len : responseLen - pos;
+        memcpy(buf, response + pos, n);
+        pos += n;
+        return static_cast<int>(n);
+    }
+    bool connected() { return pos < responseLen; }
+    void stop() {}
+};
+
+struct MemEnv {
+    MemClient client;
+    uint32_t now() { return 0; }
+    void idle() {}
+    MemClient& clientFor(const Url&) { return client; }
+};
+
+static ProbeArena        arena;
+static MemEnv            env;
+static ProbeRules::Table rules;
+
+static const char RULES[] = "status=200-299; header=X-Health; body!~error; json.status=ok; json.checks.db.status=up";
+
+// ============== Benchmarks: Probe ==============
+
+void test_bench_status_line_and_headers(void) {
+    ResponseParser& parser = arena.parser;
+    Bench::Result r = Bench::measure("probe.status_headers", benchClock, MIN_US, [&] {
+        parser.reset();
+        parser.feed(reinterpret_cast<const uint8_t*>(response), responseLen);
+        sink = parser.statusCode();
+    });
+    TEST_ASSERT_TRUE(parser.headersDone());
+    TEST_ASSERT_EQUAL_INT(200, parser.statusCode());
+    report(r);
+}
+
+void test_bench_rules_over_body(void) {
+    TEST_ASSERT_EQUAL(ProbeRules::Error::NONE, ProbeRules::compile(RULES, rules));
+    const uint8_t* body = reinterpret_cast<const uint8_t*>(HEALTH_JSON);
+    size_t len = strlen(HEALTH_JSON);
+
+    ProbeRules::Reason verdict = ProbeRules::Reason::OK;
+    Bench::Result r = Bench::measure("probe.rules_body", benchClock, MIN_US, [&] {
+        ProbeRules::Evaluator eval(rules);
+        eval.header("X-Health", "1");
+        if (eval.wantBody(200)) {
+            for (size_t i = 0; i < len; i += RX_CHUNK) {
+                if (!eval.body(body + i, (len - i < RX_CHUNK) ? len - i : RX_CHUNK)) break;
+            }
+        }
+        verdict = eval.verdict(200, 120);
+        sink = static_cast<uint32_t>(verdict);
+    });
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, verdict);
+    report(r);
+}
+
+void test_bench_fetch_in_memory(void) {
+    TEST_ASSERT_EQUAL(ProbeRules::Error::NONE, ProbeRules::compile(RULES, rules));
+
+    ProbeResult result = {0, 0, 0};
+    bool up = false;
+    Bench::Result r = Bench::measure("probe.fetch", benchClock, MIN_US, [&] {
+        ProbeRules::Evaluator eval(rules);
+        result = probe("https://status.example.com/health", arena, 10000, env, eval);
+        up = eval.verdict(result.code, 120) == ProbeRules::Reason::OK;
+        sink = up;
+    });
+    TEST_ASSERT_EQUAL_INT(200, result.code);
+    TEST_ASSERT_TRUE(up);
+    report(r);
+}
+
+// ============== Benchmarks: Display ==============
+
+void test_bench_render_text(void) {
+    // A runtime copy, so the compiler cannot fold the rendering away
+    static char text[] = "SITE DOWN!";
+    constexpr size_t W = BitmapText::textWidth("SITE DOWN!");
+    BitmapText::Bitmap<W> bmp{};
+    Bench::Result r = Bench::measure("display.render_text", benchClock, MIN_US, [&] {
+        bmp = BitmapText::render<W>(text);
+        sink = bmp.cols[W / 2];
+    });
+    TEST_ASSERT_TRUE(bmp.cols[0] != 0);
+    report(r);
+}
+
+void test_bench_scroll_frame(void) {
+    BITMAP_TEXT(MSG, "SITE DOWN!");
+    const BitmapText::View bmp = BitmapText::view(MSG);
+    uint8_t frame[COLUMNS];
+    uint8_t packed[Max7219Frame::frameBytes(DEVICES)];
+    int16_t x = COLUMNS;
+
+    // drawBitmapFrame() and the packing half of Max7219Bus::writeFrame()
+    Bench::Result r = Bench::measure("display.scroll_frame", benchClock, MIN_US, [&] {
+        for (int16_t col = 0; col < COLUMNS; col++) {
+            int16_t src = col - x;
+            frame[col] = (src >= 0 && src < bmp.width) ? bmp.cols[src] : 0;
+        }
+        Max7219Frame::packFrame(frame, DEVICES, packed);
+        if (--x < -static_cast<int16_t>(bmp.width)) x = COLUMNS;
+        sink = packed[1];
+    });
+    report(r);
+}
+
+void test_bench_pack_frame(void) {
+    uint8_t frame[COLUMNS];
+    uint8_t packed[Max7219Frame::frameBytes(DEVICES)];
+    for (uint16_t i = 0; i < COLUMNS; i++) frame[i] = static_cast<uint8_t>(i * 37);
+
+    Bench::Result r = Bench::measure("display.pack_frame", benchClock, MIN_US, [&] {
+        Max7219Frame::packFrame(frame, DEVICES, packed);
+        frame[0]++;
+        sink = packed[3];
+    });
+    TEST_ASSERT_EQUAL_UINT8(Max7219Frame::OP_DIGIT0, packed[0]);
+    report(r);
+}
+
+// ============== Benchmarks: Loop ==============
+
+struct NullIo {
+    void show(Screen) {}
+    void alarm(bool) {}
+    void chirp() {}
+    void beep() {}
+};
+
+void test_bench_idle_loop_pass(void) {
+    NullIo io;
+    Monitor<NullIo> monitor(io);
+    uint32_t now = 1000;
+    monitor.begin(now, 60000, true);
+    monitor.checked(now);
+
+    uint32_t due = 0;
+    Bench::Result r = Bench::measure("loop.idle_pass", benchClock, MIN_US, [&] {
+        now++;
+        monitor.wifi(now, true, 30000);
+        due += monitor.checkDue(now, 60000, true);
+        sink = due;
+    });
+    report(r);
+}
+
+static bool cmdNoop(uint8_t argc, char** argv) {
+    sink = argc + static_cast<uint32_t>(argv[argc - 1][0]);
+    return true;
+}
+
+static const Console::Command COMMANDS[] = {
+    {"help",      "",          0, 0, cmdNoop},
+    {"status",    "",          0, 0, cmdNoop},
+    {"hist",      "",          0, 0, cmdNoop},
+    {"sla",       "",          0, 0, cmdNoop},
+    {"check",     "",          0, 0, cmdNoop},
+    {"interval",  "<s>",       1, 1, cmdNoop},
+    {"intensity", "<0-15>",    1, 1, cmdNoop},
+    {"log",       "[level]",   0, 1, cmdNoop},
+};
+
+void test_bench_console_dispatch(void) {
+    char line[Console::LINE_MAX];
+    Console::Result result = Console::Result::EMPTY;
+    Bench::Result r = Bench::measure("loop.console_dispatch", benchClock, MIN_US, [&] {
+        strcpy(line, "intensity 7");   // dispatch() splits the line in place
+        result = Console::dispatch(COMMANDS, sizeof(COMMANDS) / sizeof(COMMANDS[0]), line);
+    });
+    TEST_ASSERT_EQUAL(Console::Result::OK, result);
+    report(r);
+}
+
+// ============== Benchmarks: TLS (board only) ==============
+
+#if defined(ARDUINO) && defined(BENCH_TLS_HOST)
+constexpr uint8_t TLS_ROUNDS = 4;
+
+void test_bench_tls_handshake_and_resume(void) {
+    WiFi.mode(WIFI_STA);
+    WiFi.begin(BENCH_WIFI_SSID, BENCH_WIFI_PASS);
+    for (uint32_t start = millis(); WiFi.status() != WL_CONNECTED; delay(100)) {
+        if (millis() - start > 20000) TEST_FAIL_MESSAGE("WiFi did not connect");
+    }
+
+    BearSSL::WiFiClientSecure client;
+    client.setInsecure();
+    uint32_t fullUs = 0, resumeUs = 0;
+    for (uint8_t i = 0; i < TLS_ROUNDS; i++) {
+        BearSSL::Session session;   // Empty: the first connect is a full handshake
+        client.setSession(&session);
+
+        uint32_t start = Bench::nowUs();
+        TEST_ASSERT_TRUE(client.connect(BENCH_TLS_HOST, 443));
+        fullUs += Bench::nowUs() - start;
+        client.stop();
+
+        start = Bench::nowUs();
+        TEST_ASSERT_TRUE(client.connect(BENCH_TLS_HOST, 443));
+        resumeUs += Bench::nowUs() - start;
+        client.stop();
+    }
+    report(Bench::value("tls.handshake", fullUs / TLS_ROUNDS, "us"));
+    report(Bench::value("tls.resume", resumeUs / TLS_ROUNDS, "us"));
+    WiFi.disconnect(true);
+}
+#endif
+
+// ============== Benchmarks: Memory ==============
+
+void test_bench_memory(void) {
+    report(Bench::value("mem.probe_arena", sizeof(ProbeArena), "bytes"));
+    report(Bench::value("mem.rules_table", sizeof(ProbeRules::Table), "bytes"));
+    report(Bench::value("mem.rules_evaluator", sizeof(ProbeRules::Evaluator), "bytes"));
+    report(Bench::value("mem.monitor", sizeof(Monitor<NullIo>), "bytes"));
+#ifdef ARDUINO
+    report(Bench::value("mem.stack_unused", ESP.getFreeContStack(), "bytes"));   // Never touched since boot
+    report(Bench::value("mem.heap_free_min", heapFreeMin, "bytes"));
+#endif
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    buildResponse();
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+#ifdef BENCH_OUT
+    out = fopen(BENCH_OUT, "w");
+#endif
+
+    UNITY_BEGIN();
+
+    // Probe
+    RUN_TEST(test_bench_status_line_and_headers);
+    RUN_TEST(test_bench_rules_over_body);
+    RUN_TEST(test_bench_fetch_in_memory);
+
+    // Display
+    RUN_TEST(test_bench_render_text);
+    RUN_TEST(test_bench_scroll_frame);
+    RUN_TEST(test_bench_pack_frame);
+
+    // Loop
+    RUN_TEST(test_bench_idle_loop_pass);
+    RUN_TEST(test_bench_console_dispatch);
+
+#if defined(ARDUINO) && defined(BENCH_TLS_HOST)
+    RUN_TEST(test_bench_tls_handshake_and_resume);
+#endif
+
+    // Memory (last, so the heap low-water mark covers every run)
+    RUN_TEST(test_bench_memory);
+
+    int failures = UNITY_END();
+    if (out) fclose(out);
+    return failures;
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,139 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_bitmap_text.cpp
+ * 
+ * Tests for compile-time message rendering (include/bitmap_text.h)
+ * 
+ * Run with: pio test -e native -f test_bitmap_text
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include "bitmap_text.h"
+
+using namespace BitmapText;
+
+BITMAP_TEXT(BMP_SITE_UP,   "SITE OK");
+BITMAP_TEXT(BMP_SITE_DOWN, "SITE DOWN!");
+BITMAP_TEXT(BMP_SINGLE,    "I");
+
+// Widths are compile-time constants
+static_assert(textWidth("I") == 3, "Trimmed 'I' is three columns");
+static_assert(sizeof(BMP_SITE_UP.cols) == textWidth("SITE OK"), "Table sized by textWidth");
+
+// ============== Tests: Glyph Metrics ==============
+
+void test_char_width_trims_blank_columns(void) {
+    TEST_ASSERT_EQUAL_UINT8(3, charWidth('I'));
+    TEST_ASSERT_EQUAL_UINT8(1, charWidth('!'));
+}
+
+void test_char_width_full_glyph(void) {
+    TEST_ASSERT_EQUAL_UINT8(5, charWidth('W'));
+    TEST_ASSERT_EQUAL_UINT8(5, charWidth('0'));
+}
+
+void test_space_has_fixed_width(void) {
+    TEST_ASSERT_EQUAL_UINT8(SPACE_WIDTH, charWidth(' '));
+}
+
+void test_unknown_char_uses_fallback(void) {
+    TEST_ASSERT_EQUAL_UINT8(charWidth(UNKNOWN_CHAR), charWidth('\x01'));
+}
+
+// ============== Tests: Text Width ==============
+
+void test_text_width_empty(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, textWidth(""));
+}
+
+void test_text_width_includes_spacing(void) {
+    // "II" = 3 + 1 + 3
+    TEST_ASSERT_EQUAL_UINT32(7, textWidth("II"));
+}
+
+void test_text_width_site_ok(void) {
+    // S5 I3 T5 E5 ' '2 O5 K5 + 6 gaps
+    TEST_ASSERT_EQUAL_UINT32(36, textWidth("SITE OK"));
+}
+
+// ============== Tests: Rendering ==============
+
+void test_render_single_glyph(void) {
+    const uint8_t expected[] = {0x41, 0x7F, 0x41};
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(expected, BMP_SINGLE.cols, 3);
+}
+
+void test_render_gap_columns_are_blank(void) {
+    // Column after 'S' (5 wide) is the inter-glyph gap
+    TEST_ASSERT_EQUAL_HEX8(0x00, BMP_SITE_UP.cols[5]);
+}
+
+void test_render_glyph_columns_match_font(void) {
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(glyphFor('S').cols, BMP_SITE_UP.cols, 5);
+}
+
+void test_render_last_column(void) {
+    // '!' is a single lit column at the end
+    TEST_ASSERT_EQUAL_HEX8(0x5F, BMP_SITE_DOWN.cols[sizeof(BMP_SITE_DOWN.cols) - 1]);
+}
+
+void test_view_reports_width(void) {
+    View v = view(BMP_SITE_DOWN);
+    TEST_ASSERT_EQUAL_UINT16(textWidth("SITE DOWN!"), v.width);
+    TEST_ASSERT_TRUE(v.cols == BMP_SITE_DOWN.cols);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    // Nothing to set up
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+    
+    // Glyph metrics
+    RUN_TEST(test_char_width_trims_blank_columns);
+    RUN_TEST(test_char_width_full_glyph);
+    RUN_TEST(test_space_has_fixed_width);
+    RUN_TEST(test_unknown_char_uses_fallback);
+    
+    // Text width
+    RUN_TEST(test_text_width_empty);
+    RUN_TEST(test_text_width_includes_spacing);
+    RUN_TEST(test_text_width_site_ok);
+    
+    // Rendering
+    RUN_TEST(test_render_single_glyph);
+    RUN_TEST(test_render_gap_columns_are_blank);
+    RUN_TEST(test_render_glyph_columns_match_font);
+    RUN_TEST(test_render_last_column);
+    RUN_TEST(test_view_reports_width);
+    
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
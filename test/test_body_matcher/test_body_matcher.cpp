@@ -0,0 +1,249 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_body_matcher.cpp
+ *
+ * Tests for the streaming Aho-Corasick matcher (include/body_matcher.h)
+ *
+ * The fuzz test splits random bodies at random chunk boundaries and
+ * checks every scan against a whole-buffer reference search. The
+ * benchmark reports scan time per KB of body (host or board clock).
+ *
+ * Run with: pio test -e native -f test_body_matcher
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "body_matcher.h"
+#include "bench_clock.h"
+
+using BodyMatcher::Scan;
+typedef BodyMatcher::Automaton<4, 129> Matcher;
+
+static Matcher matcher;
+
+// ============== Helpers ==============
+
+static void compile(const char* const* patterns, uint8_t count) {
+    matcher.clear();
+    for (uint8_t i = 0; i < count; i++) {
+        TEST_ASSERT_TRUE(matcher.add(patterns[i], strlen(patterns[i])));
+    }
+    matcher.build();
+}
+
+static uint8_t scanAll(const char* text, size_t chunk = 0) {
+    Scan s;
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(text);
+    size_t len = strlen(text);
+    if (chunk == 0) chunk = len ? len : 1;
+    for (size_t i = 0; i < len; i += chunk) {
+        matcher.feed(s, p + i, (len - i < chunk) ? len - i : chunk);
+    }
+    return s.found;
+}
+
+// Whole-buffer reference: bit i set if patterns[i] occurs in data
+static uint8_t reference(const uint8_t* data, size_t len, const char* const* patterns, uint8_t count) {
+    uint8_t mask = 0;
+    for (uint8_t i = 0; i < count; i++) {
+        size_t plen = strlen(patterns[i]);
+        for (size_t j = 0; j + plen <= len; j++) {
+            if (memcmp(data + j, patterns[i], plen) == 0) {
+                mask |= 1 << i;
+                break;
+            }
+        }
+    }
+    return mask;
+}
+
+// Deterministic generator so failures reproduce
+static uint32_t rngState = 1;
+static uint32_t rng() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return rngState >> 8;
+}
+
+// ============== Tests: Matching ==============
+
+void test_single_pattern(void) {
+    static const char* const P[] = {"healthy"};
+    compile(P, 1);
+    TEST_ASSERT_EQUAL_HEX8(0x01, scanAll("{\"status\":\"healthy\"}"));
+    TEST_ASSERT_EQUAL_HEX8(0x00, scanAll("{\"status\":\"healt\"}"));
+    TEST_ASSERT_EQUAL_HEX8(0x00, scanAll(""));
+}
+
+void test_classic_overlapping_set(void) {
+    static const char* const P[] = {"he", "she", "his", "hers"};
+    compile(P, 4);
+    TEST_ASSERT_EQUAL_HEX8(0x0B, scanAll("ushers"));   // she, he, hers
+    TEST_ASSERT_EQUAL_HEX8(0x04, scanAll("this"));
+    TEST_ASSERT_EQUAL_HEX8(0x0F, scanAll("this ushers"));
+}
+
+void test_pattern_inside_another(void) {
+    static const char* const P[] = {"status ok", "ok"};
+    compile(P, 2);
+    TEST_ASSERT_EQUAL_HEX8(0x02, scanAll("ok"));
+    TEST_ASSERT_EQUAL_HEX8(0x03, scanAll("status ok"));
+}
+
+void test_repeated_prefix(void) {
+    static const char* const P[] = {"aaab"};
+    compile(P, 1);
+    TEST_ASSERT_EQUAL_HEX8(0x01, scanAll("aaaaaab"));
+    TEST_ASSERT_EQUAL_HEX8(0x00, scanAll("aabaab"));
+}
+
+void test_byte_at_a_time(void) {
+    static const char* const P[] = {"<title>", "</html>"};
+    compile(P, 2);
+    TEST_ASSERT_EQUAL_HEX8(0x03, scanAll("<html><title>x</title></html>", 1));
+}
+
+void test_stops_when_all_found(void) {
+    static const char* const P[] = {"ok"};
+    compile(P, 1);
+    static const char body[] = "xxokyyyyyyyy";
+    Scan s;
+    size_t used = matcher.feed(s, reinterpret_cast<const uint8_t*>(body), strlen(body));
+    TEST_ASSERT_EQUAL_UINT32(4, used);
+    TEST_ASSERT_EQUAL_UINT32(4, s.bytes);
+    TEST_ASSERT_TRUE(matcher.done(s));
+    TEST_ASSERT_EQUAL_UINT32(0, matcher.feed(s, reinterpret_cast<const uint8_t*>(body), 4));
+}
+
+void test_binary_bytes(void) {
+    static const char* const P[] = {"\xff\x80"};
+    static const uint8_t body[] = {0x00, 0xff, 0x80};
+    compile(P, 1);
+    Scan s;
+    matcher.feed(s, body, sizeof(body));
+    TEST_ASSERT_TRUE(matcher.done(s));
+}
+
+void test_capacity_limits(void) {
+    BodyMatcher::Automaton<2, 6> small;
+    TEST_ASSERT_FALSE(small.add("", 0));
+    TEST_ASSERT_TRUE(small.add("abc", 3));
+    TEST_ASSERT_FALSE(small.add("xyz", 3));     // 4 + 3 nodes > 6
+    TEST_ASSERT_TRUE(small.add("abd", 3));      // Shares "ab"
+    TEST_ASSERT_FALSE(small.add("a", 1));       // Pattern count
+    TEST_ASSERT_EQUAL_UINT16(5, small.stateCount());
+}
+
+// ============== Tests: Fuzz ==============
+
+void test_fuzz_chunk_boundaries(void) {
+    static const char* const P[] = {"abab", "bba", "aab", "babba"};
+    uint8_t body[256];
+
+    rngState = 12345;
+    for (int round = 0; round < 2000; round++) {
+        uint8_t count = 1 + rng() % 4;
+        compile(P, count);
+
+        // Small alphabet so patterns and near misses are common
+        size_t len = rng() % sizeof(body);
+        for (size_t i = 0; i < len; i++) body[i] = "abx"[rng() % 3];
+
+        uint8_t expect = reference(body, len, P, count);
+        Scan s;
+        for (size_t i = 0; i < len;) {
+            size_t n = 1 + rng() % 9;
+            if (n > len - i) n = len - i;
+            matcher.feed(s, body + i, n);
+            i += n;
+        }
+        if (s.found != expect) {
+            char msg[64];
+            snprintf(msg, sizeof(msg), "round %d: found %02x, expected %02x", round, s.found, expect);
+            TEST_FAIL_MESSAGE(msg);
+        }
+    }
+}
+
+// ============== Tests: Benchmark ==============
+
+void test_benchmark_throughput(void) {
+    static const char* const P[] = {"</html>", "healthy", "error", "maintenance"};
+    compile(P, 4);
+
+    // HTML-like text with no match, so every byte is scanned
+    static uint8_t page[4096];
+    rngState = 99;
+    for (size_t i = 0; i < sizeof(page); i++) page[i] = "<div class=\"row\">lorem ip</div>\n"[rng() % 32];
+
+    const int REPEAT = 64;
+    uint32_t start = Bench::nowUs();
+    uint8_t  found = 0;
+    for (int r = 0; r < REPEAT; r++) {
+        Scan s;
+        for (size_t i = 0; i < sizeof(page); i += 512) matcher.feed(s, page + i, 512);
+        found |= s.found;
+    }
+    uint32_t us = Bench::nowUs() - start;
+    TEST_ASSERT_EQUAL_HEX8(0, found);
+
+    char msg[80];
+    uint32_t kb = REPEAT * sizeof(page) / 1024;
+    snprintf(msg, sizeof(msg), "%u KB in %u us: %u ns/KB, %u states",
+             static_cast<unsigned>(kb), static_cast<unsigned>(us),
+             static_cast<unsigned>(1000ull * us / kb), static_cast<unsigned>(matcher.stateCount()));
+    TEST_MESSAGE(msg);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    matcher.clear();
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Matching
+    RUN_TEST(test_single_pattern);
+    RUN_TEST(test_classic_overlapping_set);
+    RUN_TEST(test_pattern_inside_another);
+    RUN_TEST(test_repeated_prefix);
+    RUN_TEST(test_byte_at_a_time);
+    RUN_TEST(test_stops_when_all_found);
+    RUN_TEST(test_binary_bytes);
+    RUN_TEST(test_capacity_limits);
+
+    // Fuzz
+    RUN_TEST(test_fuzz_chunk_boundaries);
+
+    // Benchmark
+    RUN_TEST(test_benchmark_throughput);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,229 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_config_store.cpp
+ *
+ * Tests for the binary configuration record (include/config_store.h)
+ *
+ * GOLDEN was written by:
+ *   tools/mkconfig.py --check-interval 60000 --intensity 5 --ssid home
+ *                     --url https://example.com/
+ *
+ * Run with: pio test -e native -f test_config_store
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "config_store.h"
+
+static const uint8_t GOLDEN[] = {
+    0x4c, 0x50, 0x43, 0x46, 0x01, 0x00, 0x3e, 0x00, 0xb8, 0xe9, 0xe9, 0x15,
+    0x60, 0xea, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x05, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00, 0x29, 0x00, 0x00, 0x00,
+    0x68, 0x6f, 0x6d, 0x65, 0x00, 0x68, 0x74, 0x74, 0x70, 0x73, 0x3a, 0x2f,
+    0x2f, 0x65, 0x78, 0x61, 0x6d, 0x70, 0x6c, 0x65, 0x2e, 0x63, 0x6f, 0x6d,
+    0x2f, 0x00
+};
+
+static uint8_t record[ConfigStore::RECORD_MAX];
+
+static ConfigStore::Values defaults() {
+    ConfigStore::Values v = {30000, 5000, 60000, 2, 40, "ssid", "pass", "https://default/", "status=200"};
+    return v;
+}
+
+// Fix up the CRC after editing a field, so only the field is wrong
+static void reseal(uint8_t* data) {
+    size_t length = data[6] | (data[7] << 8);
+    uint32_t crc  = Crc::crc32(data + 12, length - 12);
+    for (int i = 0; i < 4; i++) data[8 + i] = static_cast<uint8_t>(crc >> (8 * i));
+}
+
+static ConfigStore::Error parse(size_t len) {
+    ConfigStore::Config c;
+    return c.parse(record, len);
+}
+
+// ============== Tests: Parsing ==============
+
+void test_parses_record_from_host_tool(void) {
+    ConfigStore::Config c;
+    TEST_ASSERT_EQUAL(ConfigStore::Error::NONE, c.parse(GOLDEN, sizeof(GOLDEN)));
+    TEST_ASSERT_TRUE(c.valid());
+    TEST_ASSERT_EQUAL_HEX32(0x15e9e9b8, c.crc());
+    TEST_ASSERT_EQUAL_UINT32(60000, c.checkIntervalMs());
+    TEST_ASSERT_EQUAL_UINT32(0, c.httpTimeoutMs());
+    TEST_ASSERT_EQUAL_UINT8(5, c.intensity());
+    TEST_ASSERT_EQUAL_STRING("home", c.ssid());
+    TEST_ASSERT_NULL(c.pass());
+    TEST_ASSERT_EQUAL_STRING("https://example.com/", c.siteUrl());
+    TEST_ASSERT_NULL(c.rules());
+}
+
+void test_strings_point_into_record(void) {
+    ConfigStore::Config c;
+    c.parse(GOLDEN, sizeof(GOLDEN));
+    TEST_ASSERT_TRUE(c.ssid() == reinterpret_cast<const char*>(GOLDEN + 36));
+    TEST_ASSERT_TRUE(c.siteUrl() == reinterpret_cast<const char*>(GOLDEN + 41));
+}
+
+void test_unset_fields_keep_defaults(void) {
+    ConfigStore::Config c;
+    c.parse(GOLDEN, sizeof(GOLDEN));
+    ConfigStore::Values v = defaults();
+    c.applyTo(v);
+    TEST_ASSERT_EQUAL_UINT32(60000, v.checkIntervalMs);
+    TEST_ASSERT_EQUAL_UINT32(5000, v.httpTimeoutMs);
+    TEST_ASSERT_EQUAL_UINT32(60000, v.reconnectMs);
+    TEST_ASSERT_EQUAL_UINT8(5, v.intensity);
+    TEST_ASSERT_EQUAL_UINT16(40, v.scrollSpeed);
+    TEST_ASSERT_EQUAL_STRING("home", v.ssid);
+    TEST_ASSERT_EQUAL_STRING("pass", v.pass);
+    TEST_ASSERT_EQUAL_STRING("https://example.com/", v.siteUrl);
+    TEST_ASSERT_EQUAL_STRING("status=200", v.rules);
+}
+
+void test_trailing_bytes_ignored(void) {
+    memcpy(record, GOLDEN, sizeof(GOLDEN));
+    TEST_ASSERT_EQUAL(ConfigStore::Error::NONE, parse(sizeof(GOLDEN) + 10));
+}
+
+// ============== Tests: Building ==============
+
+void test_build_matches_host_tool(void) {
+    ConfigStore::Values v = {60000, 0, 0, 5, 0, "home", nullptr, "https://example.com/"};
+    size_t len = ConfigStore::build(v, record, sizeof(record));
+    TEST_ASSERT_EQUAL(sizeof(GOLDEN), len);
+    TEST_ASSERT_EQUAL_MEMORY(GOLDEN, record, len);
+}
+
+void test_build_round_trip(void) {
+    ConfigStore::Values in = defaults();
+    size_t len = ConfigStore::build(in, record, sizeof(record));
+    TEST_ASSERT_TRUE(len > ConfigStore::HEADER_SIZE);
+
+    ConfigStore::Config c;
+    TEST_ASSERT_EQUAL(ConfigStore::Error::NONE, c.parse(record, len));
+    ConfigStore::Values out = {};
+    c.applyTo(out);
+    TEST_ASSERT_EQUAL_UINT32(in.checkIntervalMs, out.checkIntervalMs);
+    TEST_ASSERT_EQUAL_UINT32(in.reconnectMs, out.reconnectMs);
+    TEST_ASSERT_EQUAL_UINT16(in.scrollSpeed, out.scrollSpeed);
+    TEST_ASSERT_EQUAL_STRING(in.pass, out.pass);
+    TEST_ASSERT_EQUAL_STRING(in.siteUrl, out.siteUrl);
+    TEST_ASSERT_EQUAL_STRING(in.rules, out.rules);
+}
+
+void test_build_refuses_oversized_strings(void) {
+    char url[ConfigStore::RECORD_MAX];
+    memset(url, 'a', sizeof(url) - 1);
+    url[sizeof(url) - 1] = '\0';
+    ConfigStore::Values v = defaults();
+    v.siteUrl = url;
+    TEST_ASSERT_EQUAL(0, ConfigStore::build(v, record, sizeof(record)));
+    TEST_ASSERT_EQUAL(0, ConfigStore::build(defaults(), record, 40));
+}
+
+// ============== Tests: Rejection ==============
+
+void test_rejects_corruption(void) {
+    for (size_t i = 12; i < sizeof(GOLDEN); i++) {
+        memcpy(record, GOLDEN, sizeof(GOLDEN));
+        record[i] ^= 0x01;
+        TEST_ASSERT_EQUAL(ConfigStore::Error::BAD_CRC, parse(sizeof(GOLDEN)));
+    }
+}
+
+void test_rejects_bad_header(void) {
+    memcpy(record, GOLDEN, sizeof(GOLDEN));
+    TEST_ASSERT_EQUAL(ConfigStore::Error::TOO_SHORT, parse(ConfigStore::HEADER_SIZE - 1));
+    TEST_ASSERT_EQUAL(ConfigStore::Error::BAD_LENGTH, parse(sizeof(GOLDEN) - 1));   // Truncated file
+
+    record[4] = 2;
+    TEST_ASSERT_EQUAL(ConfigStore::Error::BAD_VERSION, parse(sizeof(GOLDEN)));
+    record[4] = 1;
+    record[0] = 'X';
+    TEST_ASSERT_EQUAL(ConfigStore::Error::BAD_MAGIC, parse(sizeof(GOLDEN)));
+}
+
+void test_rejects_bad_string_offsets(void) {
+    memcpy(record, GOLDEN, sizeof(GOLDEN));
+    record[30] = 8;    // pass inside the header
+    reseal(record);
+    TEST_ASSERT_EQUAL(ConfigStore::Error::BAD_STRING, parse(sizeof(GOLDEN)));
+
+    memcpy(record, GOLDEN, sizeof(GOLDEN));
+    record[30] = sizeof(GOLDEN);    // pass past the end
+    reseal(record);
+    TEST_ASSERT_EQUAL(ConfigStore::Error::BAD_STRING, parse(sizeof(GOLDEN)));
+
+    memcpy(record, GOLDEN, sizeof(GOLDEN));
+    record[sizeof(GOLDEN) - 1] = '/';    // url not terminated
+    reseal(record);
+    TEST_ASSERT_EQUAL(ConfigStore::Error::BAD_STRING, parse(sizeof(GOLDEN)));
+}
+
+void test_rejects_out_of_range_values(void) {
+    memcpy(record, GOLDEN, sizeof(GOLDEN));
+    record[24] = 16;    // Intensity
+    reseal(record);
+    TEST_ASSERT_EQUAL(ConfigStore::Error::BAD_VALUE, parse(sizeof(GOLDEN)));
+
+    memcpy(record, GOLDEN, sizeof(GOLDEN));
+    record[12] = 100; record[13] = 0;    // Check every 100 ms
+    reseal(record);
+    TEST_ASSERT_EQUAL(ConfigStore::Error::BAD_VALUE, parse(sizeof(GOLDEN)));
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    memset(record, 0, sizeof(record));
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Parsing
+    RUN_TEST(test_parses_record_from_host_tool);
+    RUN_TEST(test_strings_point_into_record);
+    RUN_TEST(test_unset_fields_keep_defaults);
+    RUN_TEST(test_trailing_bytes_ignored);
+
+    // Building
+    RUN_TEST(test_build_matches_host_tool);
+    RUN_TEST(test_build_round_trip);
+    RUN_TEST(test_build_refuses_oversized_strings);
+
+    // Rejection
+    RUN_TEST(test_rejects_corruption);
+    RUN_TEST(test_rejects_bad_header);
+    RUN_TEST(test_rejects_bad_string_offsets);
+    RUN_TEST(test_rejects_out_of_range_values);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
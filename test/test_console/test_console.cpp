@@ -0,0 +1,203 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_console.cpp
+ *
+ * Tests for the serial command console (include/console.h)
+ *
+ * Run with: pio test -e native -f test_console
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "console.h"
+
+static Console::LineBuffer lineBuf;
+static uint8_t  lastArgc;
+static char     lastArg[Console::LINE_MAX];
+static uint32_t setValue;
+
+// Feed text; returns the number of complete lines seen, last one in lineBuf
+static int feed(const char* text) {
+    int lines = 0;
+    for (const char* p = text; *p; ++p) {
+        if (lineBuf.feed(*p)) lines++;
+    }
+    return lines;
+}
+
+static bool cmdPing(uint8_t argc, char** argv) {
+    lastArgc = argc;
+    return true;
+}
+
+static bool cmdSet(uint8_t argc, char** argv) {
+    lastArgc = argc;
+    strcpy(lastArg, argv[1]);
+    return Console::parseUint(argv[1], setValue) && setValue <= 15;
+}
+
+static const Console::Command COMMANDS[] = {
+    {"ping", "",      0, 0, cmdPing},
+    {"set",  "<0-15>", 1, 1, cmdSet},
+};
+
+static Console::Result run(const char* text) {
+    char line[Console::LINE_MAX];
+    strcpy(line, text);
+    return Console::dispatch(COMMANDS, 2, line);
+}
+
+// ============== Tests: Line Assembly ==============
+
+void test_line_endings(void) {
+    TEST_ASSERT_EQUAL(0, feed("sta"));
+    TEST_ASSERT_EQUAL(1, feed("tus\n"));
+    TEST_ASSERT_EQUAL_STRING("status", lineBuf.line());
+
+    TEST_ASSERT_EQUAL(1, feed("hist\r\n"));   // CRLF is one line end
+    TEST_ASSERT_EQUAL_STRING("hist", lineBuf.line());
+    TEST_ASSERT_EQUAL(1, feed("check\r"));
+    TEST_ASSERT_EQUAL_STRING("check", lineBuf.line());
+    TEST_ASSERT_EQUAL(1, feed("\n\n"));        // LF after CR skipped, next LF is a blank line
+    TEST_ASSERT_EQUAL_STRING("", lineBuf.line());
+}
+
+void test_backspace_edits(void) {
+    TEST_ASSERT_EQUAL(1, feed("mutx\b\x7f" "te\n"));   // BS and DEL both erase
+    TEST_ASSERT_EQUAL_STRING("mute", lineBuf.line());
+    feed("\b\b\bok\n");   // Backspace on an empty line does nothing
+    TEST_ASSERT_EQUAL_STRING("ok", lineBuf.line());
+}
+
+void test_overlong_line_dropped_whole(void) {
+    char longLine[Console::LINE_MAX + 10];
+    memset(longLine, 'x', sizeof(longLine) - 2);
+    longLine[sizeof(longLine) - 2] = '\n';
+    longLine[sizeof(longLine) - 1] = '\0';
+
+    TEST_ASSERT_EQUAL(0, feed(longLine));
+    TEST_ASSERT_EQUAL_UINT32(1, lineBuf.overflows());
+    TEST_ASSERT_EQUAL(1, feed("ping\n"));   // Next line unaffected
+    TEST_ASSERT_EQUAL_STRING("ping", lineBuf.line());
+}
+
+void test_longest_line_fits(void) {
+    char line[Console::LINE_MAX + 1];
+    memset(line, 'a', Console::LINE_MAX - 1);
+    line[Console::LINE_MAX - 1] = '\n';
+    line[Console::LINE_MAX]     = '\0';
+    TEST_ASSERT_EQUAL(1, feed(line));
+    TEST_ASSERT_EQUAL(Console::LINE_MAX - 1, strlen(lineBuf.line()));
+}
+
+// ============== Tests: Tokenizing ==============
+
+void test_split_in_place(void) {
+    char line[] = "  interval \t 60000  ";
+    char* argv[Console::ARGS_MAX];
+    TEST_ASSERT_EQUAL(2, Console::split(line, argv, Console::ARGS_MAX));
+    TEST_ASSERT_EQUAL_STRING("interval", argv[0]);
+    TEST_ASSERT_EQUAL_STRING("60000", argv[1]);
+    TEST_ASSERT_TRUE(argv[0] >= line && argv[0] < line + sizeof(line));
+
+    char many[] = "a b c d e";
+    TEST_ASSERT_EQUAL(Console::ARGS_MAX + 1, Console::split(many, argv, Console::ARGS_MAX));
+}
+
+void test_parse_uint(void) {
+    uint32_t v = 0;
+    TEST_ASSERT_TRUE(Console::parseUint("4294967295", v));
+    TEST_ASSERT_EQUAL_UINT32(4294967295u, v);
+    TEST_ASSERT_FALSE(Console::parseUint("4294967296", v));
+    TEST_ASSERT_FALSE(Console::parseUint("", v));
+    TEST_ASSERT_FALSE(Console::parseUint("12ms", v));
+    TEST_ASSERT_FALSE(Console::parseUint("-1", v));
+}
+
+// ============== Tests: Dispatch ==============
+
+void test_dispatch_runs_handler(void) {
+    TEST_ASSERT_EQUAL(Console::Result::OK, run("ping"));
+    TEST_ASSERT_EQUAL(1, lastArgc);
+    TEST_ASSERT_EQUAL(Console::Result::OK, run(" set 12 "));
+    TEST_ASSERT_EQUAL(2, lastArgc);
+    TEST_ASSERT_EQUAL_STRING("12", lastArg);
+    TEST_ASSERT_EQUAL_UINT32(12, setValue);
+}
+
+void test_dispatch_errors(void) {
+    TEST_ASSERT_EQUAL(Console::Result::EMPTY, run("   "));
+    TEST_ASSERT_EQUAL(Console::Result::UNKNOWN, run("reboot"));
+    TEST_ASSERT_EQUAL(Console::Result::UNKNOWN, run("pin"));    // No prefix matching
+    TEST_ASSERT_EQUAL(Console::Result::BAD_ARGS, run("ping 1"));
+    TEST_ASSERT_EQUAL(Console::Result::BAD_ARGS, run("set"));
+    TEST_ASSERT_EQUAL(Console::Result::BAD_ARGS, run("set 1 2 3 4 5"));
+    TEST_ASSERT_EQUAL(Console::Result::BAD_ARGS, run("set 16"));   // Handler refused
+}
+
+void test_dispatch_reports_matched_command(void) {
+    char line[] = "set";
+    const Console::Command* cmd = nullptr;
+    TEST_ASSERT_EQUAL(Console::Result::BAD_ARGS, Console::dispatch(COMMANDS, 2, line, &cmd));
+    TEST_ASSERT_NOT_NULL(cmd);
+    TEST_ASSERT_EQUAL_STRING("<0-15>", cmd->usage);
+
+    char unknown[] = "nope";
+    TEST_ASSERT_EQUAL(Console::Result::UNKNOWN, Console::dispatch(COMMANDS, 2, unknown, &cmd));
+    TEST_ASSERT_NULL(cmd);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    lineBuf  = Console::LineBuffer();
+    lastArgc = 0;
+    lastArg[0] = '\0';
+    setValue = 0;
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Line assembly
+    RUN_TEST(test_line_endings);
+    RUN_TEST(test_backspace_edits);
+    RUN_TEST(test_overlong_line_dropped_whole);
+    RUN_TEST(test_longest_line_fits);
+
+    // Tokenizing
+    RUN_TEST(test_split_in_place);
+    RUN_TEST(test_parse_uint);
+
+    // Dispatch
+    RUN_TEST(test_dispatch_runs_handler);
+    RUN_TEST(test_dispatch_errors);
+    RUN_TEST(test_dispatch_reports_matched_command);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
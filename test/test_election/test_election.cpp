@@ -0,0 +1,293 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_election.cpp
+ *
+ * Tests for the prober election (include/election.h)
+ *
+ * Several boards run side by side in one process on a simulated LAN:
+ * each encodes real beacons, the LAN delivers the bytes to every other
+ * board that is up, and each board feeds its own FleetTable and Election
+ * the same way loop() does on the ESP8266.
+ *
+ * Run with: pio test -e native -f test_election
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "beacon.h"
+#include "fleet_table.h"
+#include "election.h"
+
+static const uint32_t HEARTBEAT      = 5000;
+static const uint32_t LEASE          = 3 * HEARTBEAT;
+static const uint32_t CHECK_INTERVAL = 30000;
+static const uint32_t TICK           = 100;
+static const size_t   MAX_BOARDS     = 6;
+static const uint8_t  FLEET_KEY[SipHash::KEY_SIZE] = {1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15, 16};
+
+// ============== Simulated Boards ==============
+
+struct Board {
+    uint32_t      id       = 0;
+    uint32_t      target   = 0;
+    bool          up       = false;   // Powered and on the LAN
+    bool          online   = false;   // Joined the group (election started)
+    bool          noJoin   = false;   // Multicast join keeps failing
+    uint8_t       segment  = 0;       // For partition tests
+    FleetTable<8> fleet;
+    Election      election;
+    uint32_t      seq       = 0;
+    uint32_t      lastSent  = 0;
+    uint32_t      lastCheck = 0;
+    uint32_t      probes    = 0;
+};
+
+static Board    boards[MAX_BOARDS];
+static size_t   boardCount;
+static uint32_t nowMs;
+static uint8_t  wire[MAX_BOARDS][Beacon::SIZE];
+static bool     pending[MAX_BOARDS];
+
+static void addBoards(size_t n) {
+    boardCount = n;
+    for (size_t i = 0; i < n; i++) {
+        boards[i]        = Board();
+        boards[i].id     = 0x100 + static_cast<uint32_t>(i);   // boards[0] has the lowest id
+        boards[i].target = Beacon::targetId("https://example.com/");
+        boards[i].up     = true;
+    }
+}
+
+static void send(size_t i) {
+    Board& b = boards[i];
+    Beacon::Status s = {};
+    s.boardId  = b.id;
+    s.targetId = b.target;
+    s.seq      = ++b.seq;
+    s.term     = b.election.term();
+    if (b.election.isLeader()) {
+        s.flags = Beacon::FLAG_PROBER;
+        if (b.probes > 0) {
+            s.flags |= Beacon::FLAG_VALID | Beacon::FLAG_UP;
+            s.ageMs  = nowMs - b.lastCheck;
+        }
+    }
+    Beacon::encode(s, FLEET_KEY, wire[i]);
+    pending[i] = true;
+    b.lastSent = nowMs;
+}
+
+// One loop() pass on every board, then deliver what was sent
+static void tick() {
+    for (size_t i = 0; i < boardCount; i++) {
+        Board& b = boards[i];
+        if (!b.up) continue;
+        if (!b.online && !b.noJoin) {
+            b.online = true;
+            b.election.begin(b.id, b.target, LEASE, nowMs);
+        }
+
+        b.fleet.expire(nowMs, 3 * CHECK_INTERVAL);
+        if (b.online && b.election.update(b.fleet, nowMs) && b.election.isLeader()) {
+            b.lastCheck = nowMs - CHECK_INTERVAL;
+        }
+        if (b.election.shouldProbe(b.online) && nowMs - b.lastCheck >= CHECK_INTERVAL) {
+            b.lastCheck = nowMs;
+            b.probes++;
+            if (b.online) send(i);
+        }
+        if (b.online && nowMs - b.lastSent >= HEARTBEAT) send(i);
+    }
+
+    for (size_t from = 0; from < boardCount; from++) {
+        if (!pending[from]) continue;
+        pending[from] = false;
+        for (size_t to = 0; to < boardCount; to++) {
+            if (to == from || !boards[to].up || !boards[to].online || boards[to].segment != boards[from].segment) continue;
+            Beacon::Status s;
+            TEST_ASSERT_TRUE(Beacon::decode(wire[from], Beacon::SIZE, FLEET_KEY, s));
+            boards[to].fleet.update(s, nowMs);
+        }
+    }
+    nowMs += TICK;
+}
+
+static void run(uint32_t ms) {
+    for (uint32_t t = 0; t < ms; t += TICK) tick();
+}
+
+static size_t leaderCount() {
+    size_t n = 0;
+    for (size_t i = 0; i < boardCount; i++) {
+        if (boards[i].up && boards[i].election.isLeader()) n++;
+    }
+    return n;
+}
+
+static uint32_t totalProbes() {
+    uint32_t n = 0;
+    for (size_t i = 0; i < boardCount; i++) n += boards[i].probes;
+    return n;
+}
+
+// ============== Tests ==============
+
+void test_term_comparison_wraps(void) {
+    TEST_ASSERT_TRUE(Election::termNewer(1, 0));
+    TEST_ASSERT_FALSE(Election::termNewer(3, 3));
+    TEST_ASSERT_TRUE(Election::termNewer(0, 0xFFFF));
+}
+
+void test_listens_for_a_lease_before_claiming(void) {
+    addBoards(1);
+    run(LEASE - TICK);
+    TEST_ASSERT_EQUAL(Election::Role::LISTENING, boards[0].election.role());
+    run(2 * TICK);
+    TEST_ASSERT_TRUE(boards[0].election.isLeader());
+    TEST_ASSERT_EQUAL_UINT16(1, boards[0].election.term());
+}
+
+void test_lowest_id_elected_once(void) {
+    addBoards(5);
+    run(LEASE + HEARTBEAT);
+    TEST_ASSERT_EQUAL(1, leaderCount());
+    TEST_ASSERT_TRUE(boards[0].election.isLeader());
+    for (size_t i = 1; i < 5; i++) {
+        TEST_ASSERT_EQUAL_HEX32(boards[0].id, boards[i].election.leaderId());
+    }
+    run(10 * 60000);
+    TEST_ASSERT_EQUAL_UINT32(1, boards[0].election.changes());
+}
+
+void test_probe_load_independent_of_board_count(void) {
+    addBoards(1);
+    run(10 * 60000);
+    uint32_t single = totalProbes();
+
+    addBoards(6);
+    run(10 * 60000);
+    uint32_t fleet = totalProbes();
+
+    TEST_ASSERT_UINT32_WITHIN(1, single, fleet);
+}
+
+void test_failover_within_bound(void) {
+    addBoards(4);
+    run(LEASE + HEARTBEAT);
+    TEST_ASSERT_TRUE(boards[0].election.isLeader());
+
+    boards[0].up = false;   // Leader vanishes without a word
+    uint32_t failedAt = nowMs;
+    while (leaderCount() == 0 && nowMs - failedAt < 2 * (LEASE + HEARTBEAT)) tick();
+
+    TEST_ASSERT_EQUAL(1, leaderCount());
+    TEST_ASSERT_TRUE(boards[1].election.isLeader());
+    TEST_ASSERT_TRUE(nowMs - failedAt <= LEASE + HEARTBEAT + TICK);
+    TEST_ASSERT_EQUAL_UINT16(2, boards[1].election.term());
+}
+
+void test_returning_board_does_not_preempt(void) {
+    addBoards(3);
+    run(LEASE + HEARTBEAT);
+    boards[0].up = false;
+    run(LEASE + 2 * HEARTBEAT);
+    TEST_ASSERT_TRUE(boards[1].election.isLeader());
+
+    // Lowest id comes back: it rejoins as a follower
+    boards[0].up     = true;
+    boards[0].online = false;
+    boards[0].fleet  = FleetTable<8>();
+    run(3 * LEASE);
+    TEST_ASSERT_EQUAL(1, leaderCount());
+    TEST_ASSERT_TRUE(boards[1].election.isLeader());
+    TEST_ASSERT_EQUAL(Election::Role::FOLLOWER, boards[0].election.role());
+}
+
+void test_partition_heals_to_one_leader(void) {
+    addBoards(4);
+    boards[2].segment = boards[3].segment = 1;
+    run(LEASE + HEARTBEAT);
+    TEST_ASSERT_EQUAL(2, leaderCount());
+
+    for (size_t i = 0; i < 4; i++) boards[i].segment = 0;
+    run(2 * HEARTBEAT);
+    TEST_ASSERT_EQUAL(1, leaderCount());
+    TEST_ASSERT_TRUE(boards[0].election.isLeader());   // Same term: lower id keeps it
+}
+
+void test_other_targets_are_ignored(void) {
+    addBoards(2);
+    boards[0].target = Beacon::targetId("https://other.example/");
+    run(LEASE + HEARTBEAT);
+    TEST_ASSERT_EQUAL(2, leaderCount());   // One prober per target
+}
+
+void test_followers_see_prober_results(void) {
+    addBoards(3);
+    run(LEASE + CHECK_INTERVAL);
+    const FleetTable<8>::Entry* e = boards[2].fleet.find(boards[0].id);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_TRUE(e->status.prober());
+    TEST_ASSERT_TRUE(e->status.valid());
+    TEST_ASSERT_TRUE(e->status.up());
+    TEST_ASSERT_EQUAL_UINT32(0, boards[2].probes);
+}
+
+void test_board_outside_group_probes_alone(void) {
+    addBoards(2);
+    boards[1].noJoin = true;
+    run(LEASE + 2 * CHECK_INTERVAL);
+    TEST_ASSERT_TRUE(boards[0].election.isLeader());
+    TEST_ASSERT_EQUAL(Election::Role::LISTENING, boards[1].election.role());
+    TEST_ASSERT_TRUE(boards[1].probes >= 2);   // Unheard, so not a follower
+    TEST_ASSERT_EQUAL_UINT32(0, boards[0].fleet.count());
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    nowMs = 1000;
+    memset(pending, 0, sizeof(pending));
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_term_comparison_wraps);
+    RUN_TEST(test_listens_for_a_lease_before_claiming);
+    RUN_TEST(test_lowest_id_elected_once);
+    RUN_TEST(test_probe_load_independent_of_board_count);
+    RUN_TEST(test_failover_within_bound);
+    RUN_TEST(test_returning_board_does_not_preempt);
+    RUN_TEST(test_partition_heals_to_one_leader);
+    RUN_TEST(test_other_targets_are_ignored);
+    RUN_TEST(test_followers_see_prober_results);
+    RUN_TEST(test_board_outside_group_probes_alone);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
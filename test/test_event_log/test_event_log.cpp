@@ -0,0 +1,298 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_event_log.cpp
+ *
+ * Tests for the flash event log (include/event_log.h)
+ *
+ * FakeFlash keeps each segment in RAM, counts erases per segment and can
+ * fail or tear the next append, standing in for the LittleFS segment
+ * files used on the board.
+ *
+ * Run with: pio test -e native -f test_event_log
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "event_log.h"
+
+static const uint8_t SEGMENTS     = 3;
+static const size_t  SEGMENT_SIZE = Event::HEADER_SIZE + 4 * Event::RECORD_SIZE;
+static const size_t  BATCH        = 2;
+
+struct FakeFlash {
+    uint8_t  data[SEGMENTS][SEGMENT_SIZE];
+    size_t   len[SEGMENTS]    = {};
+    uint32_t erases[SEGMENTS] = {};
+    uint32_t appends = 0;
+    bool     failNext = false;
+    size_t   tearNext = 0;     // Write only this many bytes of the next append
+
+    size_t size(uint8_t seg) { return len[seg]; }
+
+    size_t read(uint8_t seg, size_t offset, uint8_t* buf, size_t n) {
+        if (offset >= len[seg]) return 0;
+        if (n > len[seg] - offset) n = len[seg] - offset;
+        memcpy(buf, data[seg] + offset, n);
+        return n;
+    }
+
+    bool append(uint8_t seg, const uint8_t* buf, size_t n) {
+        if (failNext) {
+            failNext = false;
+            return false;
+        }
+        if (tearNext) {
+            n = tearNext;
+            tearNext = 0;
+            memcpy(data[seg] + len[seg], buf, n);
+            len[seg] += n;
+            return false;
+        }
+        TEST_ASSERT_TRUE(len[seg] + n <= SEGMENT_SIZE);
+        memcpy(data[seg] + len[seg], buf, n);
+        len[seg] += n;
+        appends++;
+        return true;
+    }
+
+    bool erase(uint8_t seg) {
+        len[seg] = 0;
+        erases[seg]++;
+        return true;
+    }
+};
+
+typedef EventLog<FakeFlash, SEGMENTS, SEGMENT_SIZE, BATCH> Log;
+
+static FakeFlash flash;
+static uint32_t  clockMs;
+
+static Event::Record event(Event::Type type = Event::Type::PROBE_FAIL) {
+    Event::Record r = {};
+    r.type     = type;
+    r.code     = -4;
+    r.boot     = 7;
+    r.uptimeMs = ++clockMs;
+    r.value    = 1234;
+    return r;
+}
+
+// Uptimes of all readable records, oldest first
+static size_t readUptimes(Log& log, uint32_t* out, size_t max) {
+    uint8_t buf[16 * Event::RECORD_SIZE];
+    size_t n = log.read(0, buf, max < 16 ? max : 16);
+    for (size_t i = 0; i < n; i++) {
+        Event::Record r;
+        TEST_ASSERT_TRUE(Event::decode(buf + i * Event::RECORD_SIZE, r));
+        out[i] = r.uptimeMs;
+    }
+    return n;
+}
+
+// ============== Tests: Records ==============
+
+void test_record_round_trip(void) {
+    Event::Record in = event(Event::Type::RESET);
+    in.code  = -32000;
+    in.extra = 0xBEEF;
+    uint8_t raw[Event::RECORD_SIZE];
+    Event::encode(in, raw);
+
+    Event::Record out;
+    TEST_ASSERT_TRUE(Event::decode(raw, out));
+    TEST_ASSERT_EQUAL(Event::Type::RESET, out.type);
+    TEST_ASSERT_EQUAL_INT(-32000, out.code);
+    TEST_ASSERT_EQUAL_UINT32(0xBEEF, out.extra);
+    TEST_ASSERT_EQUAL_UINT32(in.uptimeMs, out.uptimeMs);
+    TEST_ASSERT_EQUAL_STRING("reset", Event::typeName(out.type));
+}
+
+void test_record_corruption_detected(void) {
+    uint8_t raw[Event::RECORD_SIZE];
+    Event::Record r;
+    for (size_t i = 1; i < Event::RECORD_SIZE; i++) {
+        Event::encode(event(), raw);
+        raw[i] ^= 0x10;
+        TEST_ASSERT_FALSE(Event::decode(raw, r));
+    }
+    memset(raw, 0xFF, sizeof(raw));   // Erased flash
+    TEST_ASSERT_FALSE(Event::decode(raw, r));
+}
+
+// ============== Tests: Batching ==============
+
+void test_events_batched(void) {
+    Log log(flash);
+    log.begin();
+    log.append(event());
+    TEST_ASSERT_EQUAL_UINT32(0, flash.appends);
+    log.append(event());
+    TEST_ASSERT_EQUAL_UINT32(0, flash.appends);
+    log.append(event());   // Batch full: the first two go out together
+    TEST_ASSERT_EQUAL_UINT32(2, flash.appends);   // Header + one batch
+    TEST_ASSERT_EQUAL(1, log.pending());
+
+    TEST_ASSERT_TRUE(log.flush());
+    TEST_ASSERT_EQUAL(0, log.pending());
+    TEST_ASSERT_EQUAL(Event::HEADER_SIZE + 3 * Event::RECORD_SIZE, flash.len[0]);
+}
+
+void test_read_includes_pending(void) {
+    Log log(flash);
+    log.begin();
+    log.append(event());
+    log.append(event());
+    log.flush();
+    log.append(event());
+
+    uint32_t t[8];
+    TEST_ASSERT_EQUAL(3, readUptimes(log, t, 8));
+    TEST_ASSERT_EQUAL_UINT32(1, t[0]);
+    TEST_ASSERT_EQUAL_UINT32(3, t[2]);
+
+    uint8_t one[Event::RECORD_SIZE];
+    TEST_ASSERT_EQUAL(1, log.read(2, one, 1));
+    TEST_ASSERT_EQUAL(0, log.read(3, one, 1));
+}
+
+// ============== Tests: Wear Levelling ==============
+
+void test_ring_rotation_keeps_newest(void) {
+    Log log(flash);
+    log.begin();
+    for (int i = 0; i < 50; i++) {
+        log.append(event());
+        log.flush();
+    }
+
+    uint32_t t[16];
+    size_t n = readUptimes(log, t, 16);
+    TEST_ASSERT_TRUE(n >= Log::CAPACITY);
+    TEST_ASSERT_EQUAL_UINT32(50, t[n - 1]);
+    for (size_t i = 1; i < n; i++) TEST_ASSERT_EQUAL_UINT32(t[i - 1] + 1, t[i]);
+}
+
+void test_erases_spread_evenly(void) {
+    Log log(flash);
+    log.begin();
+    for (int i = 0; i < 300; i++) log.append(event());
+    log.flush();
+
+    uint32_t lo = flash.erases[0], hi = flash.erases[0];
+    for (uint8_t s = 1; s < SEGMENTS; s++) {
+        if (flash.erases[s] < lo) lo = flash.erases[s];
+        if (flash.erases[s] > hi) hi = flash.erases[s];
+    }
+    TEST_ASSERT_TRUE(hi - lo <= 1);
+    TEST_ASSERT_UINT32_WITHIN(1, 300 / Log::PER_SEGMENT, log.erases());
+}
+
+void test_reopen_continues_newest_segment(void) {
+    {
+        Log log(flash);
+        log.begin();
+        for (int i = 0; i < 10; i++) log.append(event());   // Segments 0, 1 and half of 2
+        log.flush();
+    }
+    Log log(flash);
+    log.begin();
+    log.append(event());
+    log.flush();
+
+    TEST_ASSERT_EQUAL(Event::HEADER_SIZE + 3 * Event::RECORD_SIZE, flash.len[2]);
+    uint32_t t[16];
+    size_t n = readUptimes(log, t, 16);
+    TEST_ASSERT_EQUAL(11, n);
+    TEST_ASSERT_EQUAL_UINT32(11, t[10]);
+}
+
+// ============== Tests: Failures ==============
+
+void test_torn_write_closes_segment(void) {
+    Log log(flash);
+    log.begin();
+    log.append(event());
+    log.flush();
+
+    flash.tearNext = 5;   // Power cut mid-record
+    log.append(event());
+    TEST_ASSERT_FALSE(log.flush());
+    TEST_ASSERT_EQUAL(1, log.pending());
+
+    // After a reboot the torn segment is left alone
+    Log reopened(flash);
+    reopened.begin();
+    reopened.append(event());
+    TEST_ASSERT_TRUE(reopened.flush());
+    TEST_ASSERT_EQUAL(Event::HEADER_SIZE + Event::RECORD_SIZE, flash.len[1]);
+
+    uint32_t t[8];
+    TEST_ASSERT_EQUAL(2, readUptimes(reopened, t, 8));   // Torn bytes skipped
+}
+
+void test_storage_error_keeps_events(void) {
+    Log log(flash);
+    log.begin();
+    log.append(event());
+    flash.failNext = true;
+    TEST_ASSERT_FALSE(log.flush());
+    TEST_ASSERT_EQUAL(1, log.pending());
+    TEST_ASSERT_TRUE(log.flush());
+    TEST_ASSERT_EQUAL(0, log.pending());
+    TEST_ASSERT_EQUAL_UINT32(0, log.dropped());
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    flash   = FakeFlash();
+    clockMs = 0;
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Records
+    RUN_TEST(test_record_round_trip);
+    RUN_TEST(test_record_corruption_detected);
+
+    // Batching
+    RUN_TEST(test_events_batched);
+    RUN_TEST(test_read_includes_pending);
+
+    // Wear levelling
+    RUN_TEST(test_ring_rotation_keeps_newest);
+    RUN_TEST(test_erases_spread_evenly);
+    RUN_TEST(test_reopen_continues_newest_segment);
+
+    // Failures
+    RUN_TEST(test_torn_write_closes_segment);
+    RUN_TEST(test_storage_error_keeps_events);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,330 @@
+/**
+ * LED-Panel-ESP12F - Scriptable Stand-in Site for Probe Tests
+ *
+ * An in-process HTTP(S) server and the network shim the probe talks to
+ * it through, on a virtual clock, so checkSiteStatus()'s engine
+ * (HttpProbe::probe plus ProbeRules) runs offline, deterministically
+ * and much faster than real time.
+ *
+ * - Hosts set the connect cost: TCP time, full and resumed TLS handshake
+ *   time, refused connections and failing handshakes. TLS is modelled,
+ *   not run: like the firmware's single BearSSL::Session, the shim keeps
+ *   one session and resumes only to the host it came from
+ * - Routes (host, scheme, path) script the replies: raw response bytes,
+ *   time to first byte, delivery in timed bursts, a reset after N bytes,
+ *   or a connection left open. A route can be limited to N replies, so
+ *   "three 503s, then 200" is two routes
+ * - Unmatched requests get a 404
+ * - Counters and a short request log let tests check redirect chains and
+ *   handshake counts
+ *
+ *   FakeSite::Site site;
+ *   site.host({"example.com", 20, 400, 80});
+ *   site.route("example.com", "/health", {FakeSite::OK_BODY, 150});
+ *   FakeSite::Env env(site);
+ *   HttpProbe::probe("https://example.com/health", arena, 10000, env);
+ *
+ * The shim satisfies HttpProbe's Client and Env interfaces; see
+ * include/http_probe.h.
+ */
+
+#ifndef FAKE_SITE_H
+#define FAKE_SITE_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "http_probe.h"
+
+namespace FakeSite {
+
+constexpr uint8_t HOST_MAX  = 8;
+constexpr uint8_t ROUTE_MAX = 16;
+constexpr uint8_t LOG_MAX   = 16;
+
+static const char OK_BODY[] =
+    "HTTP/1.1 200 OK\r\nContent-Type: text/plain\r\nContent-Length: 7\r\n\r\nhealthy";
+static const char NOT_FOUND[] =
+    "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n\r\n";
+
+enum class Scheme : uint8_t { ANY, HTTP, HTTPS };
+
+/**
+ * Connect behaviour of one host
+ */
+struct Host {
+    const char* name        = nullptr;   // nullptr = any host
+    uint32_t    tcpMs       = 20;
+    uint32_t    tlsMs       = 400;       // Full handshake
+    uint32_t    tlsResumeMs = 80;        // With the cached session
+    bool        refuse      = false;     // DNS or TCP failure
+    bool        tlsFails    = false;     // Handshake rejected
+};
+
+/**
+ * What the server sends once the request is in
+ */
+struct Reply {
+    const char* response    = NOT_FOUND;  // Raw bytes: status line, headers, body
+    uint32_t    firstByteMs = 0;          // Server think time
+    uint16_t    burst       = 0;          // Bytes per burst; 0 = all at once
+    uint32_t    gapMs       = 0;          // Between bursts
+    int32_t     resetAfter  = -1;         // Drop the connection after this many bytes
+    bool        keepOpen    = false;      // Do not close after the response
+};
+
+struct Route {
+    const char* host   = nullptr;   // nullptr = any
+    Scheme      scheme = Scheme::ANY;
+    const char* path   = nullptr;   // nullptr = any; exact match otherwise
+    Reply       reply;
+    uint16_t    times  = 0;         // Replies before the route is used up; 0 = no limit
+    uint16_t    hits   = 0;
+};
+
+struct Request {
+    char host[HttpProbe::HOST_MAX];
+    char path[HttpProbe::PATH_MAX];
+    bool https;
+};
+
+/**
+ * The stand-in server: hosts, routes and what it has seen
+ */
+class Site {
+public:
+    void host(const Host& h) {
+        if (_hostCount < HOST_MAX) _hosts[_hostCount++] = h;
+    }
+
+    Route& route(const char* host, const char* path, const Reply& reply, uint16_t times = 0,
+                 Scheme scheme = Scheme::ANY) {
+        Route& r = _routes[_routeCount < ROUTE_MAX ? _routeCount++ : ROUTE_MAX - 1];
+        r = Route();
+        r.host   = host;
+        r.scheme = scheme;
+        r.path   = path;
+        r.reply  = reply;
+        r.times  = times;
+        return r;
+    }
+
+    const Host& hostFor(const char* name) const {
+        for (uint8_t i = 0; i < _hostCount; i++) {
+            if (!_hosts[i].name || strcmp(_hosts[i].name, name) == 0) return _hosts[i];
+        }
+        return _defaultHost;
+    }
+
+    /**
+     * Pick (and use up) the reply for a request
+     */
+    const Reply& serve(const char* host, const char* path, bool https) {
+        Request& r = _log[_requests % LOG_MAX];
+        strncpy(r.host, host, sizeof(r.host) - 1);
+        r.host[sizeof(r.host) - 1] = '\0';
+        strncpy(r.path, path, sizeof(r.path) - 1);
+        r.path[sizeof(r.path) - 1] = '\0';
+        r.https = https;
+        _requests++;
+
+        for (uint8_t i = 0; i < _routeCount; i++) {
+            Route& route = _routes[i];
+            if (route.times && route.hits >= route.times) continue;
+            if (route.host && strcmp(route.host, host) != 0) continue;
+            if (route.path && strcmp(route.path, path) != 0) continue;
+            if (route.scheme != Scheme::ANY && (route.scheme == Scheme::HTTPS) != https) continue;
+            route.hits++;
+            return route.reply;
+        }
+        return _notFound;
+    }
+
+    // Request i, oldest first among the last LOG_MAX
+    const Request& request(uint32_t i) const {
+        uint32_t first = (_requests > LOG_MAX) ? _requests - LOG_MAX : 0;
+        return _log[(first + i) % LOG_MAX];
+    }
+
+    uint32_t requests() const { return _requests; }
+
+    // Connect counters, kept by the shim
+    uint32_t connects      = 0;
+    uint32_t refused       = 0;
+    uint32_t fullHandshakes = 0;
+    uint32_t resumptions   = 0;
+    uint32_t tlsFailures   = 0;
+    uint32_t bytesSent     = 0;
+
+private:
+    Host     _hosts[HOST_MAX];
+    uint8_t  _hostCount  = 0;
+    Route    _routes[ROUTE_MAX];
+    uint8_t  _routeCount = 0;
+    Request  _log[LOG_MAX];
+    uint32_t _requests   = 0;
+    Host     _defaultHost;
+    Reply    _notFound;
+};
+
+class Env;
+
+/**
+ * One client socket, plain or TLS, as HttpProbe::fetchStatus() sees it
+ */
+class Client {
+public:
+    Client(Env& env, bool tls) : _env(env), _tls(tls) {}
+
+    bool   connect(const char* host, uint16_t port);
+    size_t write(const uint8_t* buf, size_t len);
+    int    available();
+    int    read(uint8_t* buf, size_t len);
+    bool   connected();
+    void   stop() { _open = false; _reply = nullptr; }
+
+private:
+    size_t released() const;
+
+    Env&         _env;
+    bool         _tls;
+    bool         _open   = false;
+    char         _host[HttpProbe::HOST_MAX] = "";
+    const Reply* _reply  = nullptr;
+    size_t       _length = 0;       // Bytes the reply will deliver
+    size_t       _pos    = 0;       // Bytes read so far
+    uint32_t     _sentAt = 0;       // Request written
+};
+
+/**
+ * Virtual clock and the probe's two clients
+ */
+class Env {
+public:
+    explicit Env(Site& site) : _site(site), _plain(*this, false), _tls(*this, true) {}
+
+    uint32_t now() { return clock; }
+    void     idle() { clock += idleMs; }
+    Client&  clientFor(const HttpProbe::Url& url) { return url.https ? _tls : _plain; }
+
+    Site& site() { return _site; }
+
+    // Cached TLS session: one, for the host it came from
+    void forgetSession() { _session[0] = '\0'; }
+
+    uint32_t clock  = 0;
+    uint32_t idleMs = 1;
+
+private:
+    friend class Client;
+
+    Site&  _site;
+    Client _plain;
+    Client _tls;
+    char   _session[HttpProbe::HOST_MAX] = "";
+};
+
+// ============== Client ==============
+
+inline bool Client::connect(const char* host, uint16_t port) {
+    (void)port;
+    Site& site = _env._site;
+    const Host& h = site.hostFor(host);
+    site.connects++;
+    _open  = false;
+    _reply = nullptr;
+
+    _env.clock += h.tcpMs;
+    if (h.refuse) {
+        site.refused++;
+        return false;
+    }
+
+    if (_tls) {
+        bool resume = strcmp(_env._session, host) == 0;
+        _env.clock += resume ? h.tlsResumeMs : h.tlsMs;
+        if (h.tlsFails) {
+            site.tlsFailures++;
+            _env.forgetSession();
+            return false;
+        }
+        if (resume) {
+            site.resumptions++;
+        } else {
+            site.fullHandshakes++;
+            strncpy(_env._session, host, sizeof(_env._session) - 1);
+        }
+    }
+
+    strncpy(_host, host, sizeof(_host) - 1);
+    _host[sizeof(_host) - 1] = '\0';
+    _open = true;
+    return true;
+}
+
+inline size_t Client::write(const uint8_t* buf, size_t len) {
+    if (!_open) return 0;
+
+    // "GET <path> HTTP/1.1" is all the server needs; the host is the
+    // one connected to
+    char path[HttpProbe::PATH_MAX] = "/";
+    const char* p = reinterpret_cast<const char*>(buf);
+    if (len > 4 && memcmp(p, "GET ", 4) == 0) {
+        size_t n = 0;
+        for (p += 4; n < sizeof(path) - 1 && n + 4 < len && p[n] != ' '; n++) path[n] = p[n];
+        path[n] = '\0';
+    }
+
+    _reply  = &_env._site.serve(_host, path, _tls);
+    _length = strlen(_reply->response);
+    if (_reply->resetAfter >= 0 && static_cast<size_t>(_reply->resetAfter) < _length) {
+        _length = static_cast<size_t>(_reply->resetAfter);
+    }
+    _pos    = 0;
+    _sentAt = _env.clock;
+    return len;
+}
+
+// Bytes the server has sent by now
+inline size_t Client::released() const {
+    if (!_reply) return 0;
+    uint32_t elapsed = _env.clock - _sentAt;
+    if (elapsed < _reply->firstByteMs) return 0;
+    if (_reply->burst == 0 || _reply->gapMs == 0) return _length;
+
+    uint64_t bursts = 1 + (elapsed - _reply->firstByteMs) / _reply->gapMs;
+    uint64_t bytes  = bursts * _reply->burst;
+    return (bytes < _length) ? static_cast<size_t>(bytes) : _length;
+}
+
+inline int Client::available() {
+    if (!_open) return 0;
+    return static_cast<int>(released() - _pos);
+}
+
+inline int Client::read(uint8_t* buf, size_t len) {
+    size_t left = static_cast<size_t>(available());
+    size_t n = (len < left) ? len : left;
+    memcpy(buf, _reply->response + _pos, n);
+    _pos += n;
+    _env._site.bytesSent += static_cast<uint32_t>(n);
+    return static_cast<int>(n);
+}
+
+/**
+ * Open until everything is read and the server closes (or resets)
+ */
+inline bool Client::connected() {
+    if (!_open) return false;
+    if (available() > 0) return true;
+    if (_reply && _pos == _length && released() == _length) {
+        bool reset = _reply->resetAfter >= 0;
+        return !reset && _reply->keepOpen;
+    }
+    return true;
+}
+
+}  // namespace FakeSite
+
+#endif
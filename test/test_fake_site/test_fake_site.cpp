@@ -0,0 +1,337 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_fake_site.cpp
+ *
+ * The probe engine (HttpProbe::probe with ProbeRules) against a scripted
+ * stand-in site (fake_site.h): latency, status codes and 5xx bursts,
+ * partial responses, resets, silent servers, slow and failing TLS,
+ * session resumption and redirect chains. Everything runs on a virtual
+ * clock, so the timings asserted here are exact.
+ *
+ * Run with: pio test -e native -f test_fake_site
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <new>
+#include "http_probe.h"
+#include "probe_rules.h"
+#include "fake_site.h"
+#include "bench_clock.h"
+
+using namespace HttpProbe;
+using FakeSite::Reply;
+using FakeSite::Scheme;
+
+constexpr uint32_t TIMEOUT = 10000;
+
+static FakeSite::Site*   site = nullptr;
+static FakeSite::Env*    env  = nullptr;
+static ProbeArena        arena;
+static ProbeRules::Table rules;
+
+static const char HEALTH[] =
+    "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 44\r\n\r\n"
+    "{\"status\":\"ok\",\"checks\":{\"db\":\"up\"},\"v\":\"1\"}";
+static const char UNAVAILABLE[] =
+    "HTTP/1.1 503 Service Unavailable\r\nRetry-After: 5\r\nContent-Length: 0\r\n\r\n";
+static const char TO_HTTPS[] =
+    "HTTP/1.1 301 Moved Permanently\r\nLocation: https://example.com/health\r\nContent-Length: 0\r\n\r\n";
+static const char TO_WWW[] =
+    "HTTP/1.1 302 Found\r\nLocation: https://www.example.com/health\r\nContent-Length: 0\r\n\r\n";
+static const char TO_SELF[] =
+    "HTTP/1.1 307 Temporary Redirect\r\nLocation: /loop\r\nContent-Length: 0\r\n\r\n";
+static const char CHUNKED[] =
+    "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+    "7\r\n{\"statu\r\n9\r\ns\":\"ok\"}\r\n0\r\n\r\n";
+
+struct Outcome {
+    int                code;
+    uint8_t            redirects;
+    uint32_t           latencyMs;   // Virtual
+    ProbeRules::Reason verdict;
+};
+
+// ============== Helpers ==============
+
+static void useRules(const char* line) {
+    TEST_ASSERT_EQUAL(ProbeRules::Error::NONE, ProbeRules::compile(line, rules));
+}
+
+// One check, as checkSiteStatus() does it
+static Outcome check(const char* url) {
+    ProbeRules::Evaluator eval(rules);
+    uint32_t start = env->now();
+    ProbeResult r = probe(url, arena, TIMEOUT, *env, eval);
+    uint32_t latency = env->now() - start;
+    return {r.code, r.redirects, latency, eval.verdict(r.code, latency)};
+}
+
+// ============== Tests: Latency and Status ==============
+
+void test_latency_is_connect_plus_first_byte(void) {
+    site->host({"example.com", 20, 400, 80});
+    site->route("example.com", "/health", {HEALTH, 150});
+
+    Outcome o = check("https://example.com/health");
+    TEST_ASSERT_EQUAL_INT(200, o.code);
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, o.verdict);
+    TEST_ASSERT_EQUAL_UINT32(20 + 400 + 150, o.latencyMs);
+
+    o = check("http://example.com/health");   // No TLS
+    TEST_ASSERT_EQUAL_UINT32(20 + 150, o.latencyMs);
+}
+
+void test_status_codes_and_5xx_burst(void) {
+    site->route(nullptr, "/health", {UNAVAILABLE, 30}, 3);
+    site->route(nullptr, "/health", {HEALTH, 30});
+
+    for (int i = 0; i < 3; i++) {
+        Outcome o = check("https://example.com/health");
+        TEST_ASSERT_EQUAL_INT(503, o.code);
+        TEST_ASSERT_EQUAL(ProbeRules::Reason::STATUS, o.verdict);
+    }
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, check("https://example.com/health").verdict);
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, check("https://example.com/health").verdict);
+
+    Outcome o = check("https://example.com/missing");   // Unrouted: 404, still "up" by default
+    TEST_ASSERT_EQUAL_INT(404, o.code);
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, o.verdict);
+    useRules("status=200-299");
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::STATUS, check("https://example.com/missing").verdict);
+}
+
+void test_latency_rule_on_slow_server(void) {
+    useRules("latency<1000");
+    site->host({nullptr, 20, 400, 80});
+    site->route(nullptr, "/fast", {HEALTH, 100});
+    site->route(nullptr, "/slow", {HEALTH, 950});
+
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, check("https://example.com/fast").verdict);
+    Outcome o = check("https://example.com/slow");
+    TEST_ASSERT_EQUAL_INT(200, o.code);
+    TEST_ASSERT_EQUAL_UINT32(20 + 80 + 950, o.latencyMs);   // Resumed session
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::LATENCY, o.verdict);
+}
+
+// ============== Tests: Broken Servers ==============
+
+void test_reset_before_any_byte(void) {
+    Reply r = {HEALTH, 50};
+    r.resetAfter = 0;
+    site->route(nullptr, nullptr, r);
+
+    Outcome o = check("https://example.com/health");
+    TEST_ASSERT_EQUAL_INT(ERR_CONNECTION_LOST, o.code);
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::NO_RESPONSE, o.verdict);
+}
+
+void test_reset_inside_headers(void) {
+    Reply r = {HEALTH, 50};
+    r.resetAfter = 20;   // "HTTP/1.1 200 OK\r\nCon"
+    site->route(nullptr, nullptr, r);
+    TEST_ASSERT_EQUAL_INT(ERR_CONNECTION_LOST, check("https://example.com/health").code);
+}
+
+void test_partial_body_fails_body_rules(void) {
+    useRules("json.status=ok; json.checks.db=up");
+    Reply r = {HEALTH, 50};
+    r.resetAfter = static_cast<int32_t>(strlen(HEALTH) - 20);   // Cut inside "checks"
+    site->route(nullptr, nullptr, r);
+
+    Outcome o = check("https://example.com/health");
+    TEST_ASSERT_EQUAL_INT(200, o.code);            // The status stands
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::JSON, o.verdict);
+}
+
+void test_silent_server_times_out(void) {
+    site->route(nullptr, nullptr, {HEALTH, TIMEOUT * 2});
+
+    Outcome o = check("https://example.com/health");
+    TEST_ASSERT_EQUAL_INT(ERR_READ_TIMEOUT, o.code);
+    TEST_ASSERT_EQUAL_UINT32(20 + 400 + TIMEOUT, o.latencyMs);
+}
+
+void test_open_connection_ends_with_the_body(void) {
+    useRules("body~healthy");
+    Reply r = {FakeSite::OK_BODY, 40};
+    r.keepOpen = true;   // Server ignores "Connection: close"
+    site->route(nullptr, nullptr, r);
+
+    Outcome o = check("https://example.com/health");
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, o.verdict);
+    TEST_ASSERT_EQUAL_UINT32(20 + 400 + 40, o.latencyMs);   // Content-Length, not the timeout
+}
+
+void test_drip_fed_chunked_response(void) {
+    useRules("json.status=ok");
+    Reply r = {CHUNKED, 10, 1, 2};   // One byte every 2 ms
+    site->route(nullptr, nullptr, r);
+
+    Outcome o = check("https://example.com/health");
+    TEST_ASSERT_EQUAL_INT(200, o.code);
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, o.verdict);
+    TEST_ASSERT_TRUE(o.latencyMs >= 20 + 400 + 10 + 2 * (strlen(CHUNKED) - 12));
+}
+
+// ============== Tests: TLS ==============
+
+void test_slow_and_failing_tls(void) {
+    site->host({"slow.example.com", 30, 4000, 300});
+    site->host({"bad.example.com", 30, 600, 100, false, true});
+    site->host({"gone.example.com", 3000, 0, 0, true});
+    site->route(nullptr, nullptr, {HEALTH, 50});
+
+    Outcome o = check("https://slow.example.com/");
+    TEST_ASSERT_EQUAL_INT(200, o.code);
+    TEST_ASSERT_EQUAL_UINT32(30 + 4000 + 50, o.latencyMs);
+
+    o = check("https://bad.example.com/");
+    TEST_ASSERT_EQUAL_INT(ERR_CONNECTION_FAILED, o.code);
+    TEST_ASSERT_EQUAL_UINT32(30 + 600, o.latencyMs);
+    TEST_ASSERT_EQUAL_UINT32(1, site->tlsFailures);
+
+    o = check("https://gone.example.com/");
+    TEST_ASSERT_EQUAL_INT(ERR_CONNECTION_FAILED, o.code);
+    TEST_ASSERT_EQUAL_UINT32(1, site->refused);
+}
+
+void test_session_resumed_for_same_host_only(void) {
+    site->host({nullptr, 20, 400, 80});
+    site->route(nullptr, nullptr, {HEALTH, 0});
+
+    check("https://a.example.com/");
+    check("https://a.example.com/");
+    check("https://a.example.com/");
+    TEST_ASSERT_EQUAL_UINT32(1, site->fullHandshakes);
+    TEST_ASSERT_EQUAL_UINT32(2, site->resumptions);
+
+    check("https://b.example.com/");   // Replaces the one cached session
+    Outcome o = check("https://a.example.com/");
+    TEST_ASSERT_EQUAL_UINT32(3, site->fullHandshakes);
+    TEST_ASSERT_EQUAL_UINT32(20 + 400, o.latencyMs);
+}
+
+// ============== Tests: Redirects ==============
+
+void test_redirect_chain_http_to_https_to_www(void) {
+    site->host({nullptr, 20, 400, 80});
+    site->route("example.com", "/health", {TO_HTTPS, 10}, 0, Scheme::HTTP);
+    site->route("example.com", "/health", {TO_WWW, 10}, 0, Scheme::HTTPS);
+    site->route("www.example.com", "/health", {HEALTH, 100});
+
+    Outcome o = check("http://example.com/health");
+    TEST_ASSERT_EQUAL_INT(200, o.code);
+    TEST_ASSERT_EQUAL_UINT8(2, o.redirects);
+    TEST_ASSERT_EQUAL_UINT32((20 + 10) + (20 + 400 + 10) + (20 + 400 + 100), o.latencyMs);
+
+    TEST_ASSERT_EQUAL_UINT32(3, site->requests());
+    TEST_ASSERT_FALSE(site->request(0).https);
+    TEST_ASSERT_EQUAL_STRING("example.com", site->request(1).host);
+    TEST_ASSERT_TRUE(site->request(1).https);
+    TEST_ASSERT_EQUAL_STRING("www.example.com", site->request(2).host);
+    TEST_ASSERT_EQUAL_UINT32(2, site->fullHandshakes);
+}
+
+void test_redirect_loop_stops_at_limit(void) {
+    site->route(nullptr, nullptr, {TO_SELF, 5});
+
+    Outcome o = check("https://example.com/loop");
+    TEST_ASSERT_EQUAL_INT(307, o.code);
+    TEST_ASSERT_EQUAL_UINT8(REDIRECT_LIMIT, o.redirects);
+    TEST_ASSERT_EQUAL_UINT32(REDIRECT_LIMIT + 1, site->requests());
+}
+
+// ============== Tests: Throughput ==============
+
+void test_benchmark_mixed_checks(void) {
+    useRules("status=200-299; json.status=ok");
+    site->host({nullptr, 20, 400, 80});
+    site->route(nullptr, "/health", {UNAVAILABLE, 30}, 50);
+    site->route(nullptr, "/health", {HEALTH, 120, 16, 1});
+    site->route(nullptr, "/", {TO_HTTPS, 10});
+    site->route("example.com", "/health", {HEALTH, 120}, 0, Scheme::HTTPS);
+
+    const int CHECKS = 2000;
+    int up = 0;
+    uint32_t start = Bench::nowUs();
+    for (int i = 0; i < CHECKS; i++) {
+        up += check((i & 1) ? "http://example.com/" : "https://example.com/health").verdict ==
+              ProbeRules::Reason::OK;
+    }
+    uint32_t us = Bench::nowUs() - start;
+    TEST_ASSERT_EQUAL_INT(CHECKS - 50, up);
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%d checks (%u s virtual) in %u us: %u us/check",
+             CHECKS, static_cast<unsigned>(env->clock / 1000), static_cast<unsigned>(us),
+             static_cast<unsigned>(us / CHECKS));
+    TEST_MESSAGE(msg);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    // Fresh site and shim per test, built in place
+    static FakeSite::Site siteStorage;
+    alignas(FakeSite::Env) static uint8_t envStorage[sizeof(FakeSite::Env)];
+    site = new (&siteStorage) FakeSite::Site();
+    env  = new (envStorage) FakeSite::Env(*site);
+    ProbeRules::compile("", rules);
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Latency and status
+    RUN_TEST(test_latency_is_connect_plus_first_byte);
+    RUN_TEST(test_status_codes_and_5xx_burst);
+    RUN_TEST(test_latency_rule_on_slow_server);
+
+    // Broken servers
+    RUN_TEST(test_reset_before_any_byte);
+    RUN_TEST(test_reset_inside_headers);
+    RUN_TEST(test_partial_body_fails_body_rules);
+    RUN_TEST(test_silent_server_times_out);
+    RUN_TEST(test_open_connection_ends_with_the_body);
+    RUN_TEST(test_drip_fed_chunked_response);
+
+    // TLS
+    RUN_TEST(test_slow_and_failing_tls);
+    RUN_TEST(test_session_resumed_for_same_host_only);
+
+    // Redirects
+    RUN_TEST(test_redirect_chain_http_to_https_to_www);
+    RUN_TEST(test_redirect_loop_stops_at_limit);
+
+    // Throughput
+    RUN_TEST(test_benchmark_mixed_checks);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
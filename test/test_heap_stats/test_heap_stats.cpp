@@ -0,0 +1,173 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_heap_stats.cpp
+ * 
+ * Tests for heap telemetry ring buffer (include/heap_stats.h)
+ * 
+ * Run with: pio test -e native -f test_heap_stats
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include "heap_stats.h"
+
+constexpr uint32_t LOW_BLOCK = 20000;
+
+static HeapStats<8> stats;
+
+static void record(uint32_t freeHeap, uint32_t maxBlock, uint8_t frag = 10) {
+    HeapSample s = {freeHeap, maxBlock, frag};
+    stats.record(s, LOW_BLOCK);
+}
+
+// ============== Tests: Ring Buffer ==============
+
+void test_empty_stats(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, stats.count());
+    TEST_ASSERT_EQUAL_UINT32(0, stats.minFreeHeap());
+    TEST_ASSERT_EQUAL_INT32(0, stats.freeHeapTrend());
+}
+
+void test_count_saturates_at_capacity(void) {
+    for (int i = 0; i < 20; i++) record(30000, 25000);
+    TEST_ASSERT_EQUAL_UINT32(8, stats.count());
+    TEST_ASSERT_EQUAL_UINT32(20, stats.total());
+}
+
+void test_oldest_sample_evicted(void) {
+    record(10000, 25000);
+    for (int i = 0; i < 8; i++) record(30000 + i, 25000);
+    TEST_ASSERT_EQUAL_UINT32(30000, stats.minFreeHeap());
+    TEST_ASSERT_EQUAL_UINT32(30000, stats.at(0).freeHeap);
+    TEST_ASSERT_EQUAL_UINT32(30007, stats.latest().freeHeap);
+}
+
+// ============== Tests: Min/Max ==============
+
+void test_min_max_free_heap(void) {
+    record(30000, 25000);
+    record(28000, 24000);
+    record(31000, 26000);
+    TEST_ASSERT_EQUAL_UINT32(28000, stats.minFreeHeap());
+    TEST_ASSERT_EQUAL_UINT32(31000, stats.maxFreeHeap());
+    TEST_ASSERT_EQUAL_UINT32(24000, stats.minMaxBlock());
+}
+
+void test_max_fragmentation(void) {
+    record(30000, 25000, 5);
+    record(30000, 25000, 42);
+    record(30000, 25000, 12);
+    TEST_ASSERT_EQUAL_UINT8(42, stats.maxFragmentation());
+}
+
+void test_min_block_ever_survives_eviction(void) {
+    record(30000, 12000);
+    for (int i = 0; i < 8; i++) record(30000, 25000);
+    TEST_ASSERT_EQUAL_UINT32(12000, stats.minBlockEver());
+    TEST_ASSERT_EQUAL_UINT32(25000, stats.minMaxBlock());
+}
+
+// ============== Tests: Trend ==============
+
+void test_trend_flat(void) {
+    for (int i = 0; i < 8; i++) record(30000, 25000);
+    TEST_ASSERT_EQUAL_INT32(0, stats.freeHeapTrend());
+}
+
+void test_trend_leak(void) {
+    for (int i = 0; i < 8; i++) record(30000 - i * 100, 25000);
+    TEST_ASSERT_EQUAL_INT32(-100, stats.freeHeapTrend());
+}
+
+void test_trend_noisy_but_stable(void) {
+    const uint32_t heap[] = {30000, 29500, 30000, 29500, 30000, 29500, 30000, 29500};
+    for (uint32_t h : heap) record(h, 25000);
+    TEST_ASSERT_INT32_WITHIN(30, 0, stats.freeHeapTrend());
+}
+
+// ============== Tests: Low Block Streak ==============
+
+void test_low_block_streak_counts(void) {
+    record(30000, 15000);
+    record(30000, 15000);
+    TEST_ASSERT_EQUAL_UINT32(2, stats.lowBlockStreak());
+}
+
+void test_low_block_streak_resets(void) {
+    record(30000, 15000);
+    record(30000, 15000);
+    record(30000, 21000);
+    TEST_ASSERT_EQUAL_UINT32(0, stats.lowBlockStreak());
+}
+
+void test_restart_forced_when_never_quiet(void) {
+    // Starved heap: every TLS check fails, the site stays down
+    for (int i = 0; i < 5; i++) record(30000, 6000);
+    TEST_ASSERT_EQUAL(HeapRestart::NONE, stats.restartNeed(6, 6));
+    record(30000, 6000);
+    TEST_ASSERT_EQUAL(HeapRestart::WHEN_QUIET, stats.restartNeed(6, 6));
+    for (int i = 0; i < 5; i++) record(30000, 6000);
+    TEST_ASSERT_EQUAL(HeapRestart::WHEN_QUIET, stats.restartNeed(6, 6));
+    record(30000, 6000);
+    TEST_ASSERT_EQUAL(HeapRestart::NOW, stats.restartNeed(6, 6));
+
+    // A heap that recovers is never forced
+    record(30000, 25000);
+    TEST_ASSERT_EQUAL(HeapRestart::NONE, stats.restartNeed(6, 6));
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    stats.reset();
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+    
+    // Ring buffer
+    RUN_TEST(test_empty_stats);
+    RUN_TEST(test_count_saturates_at_capacity);
+    RUN_TEST(test_oldest_sample_evicted);
+    
+    // Min/max
+    RUN_TEST(test_min_max_free_heap);
+    RUN_TEST(test_max_fragmentation);
+    RUN_TEST(test_min_block_ever_survives_eviction);
+    
+    // Trend
+    RUN_TEST(test_trend_flat);
+    RUN_TEST(test_trend_leak);
+    RUN_TEST(test_trend_noisy_but_stable);
+    
+    // Low block streak
+    RUN_TEST(test_low_block_streak_counts);
+    RUN_TEST(test_low_block_streak_resets);
+    RUN_TEST(test_restart_forced_when_never_quiet);
+    
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -12,7 +12,8 @@
 #include <stdint.h>
 
 // ============== HTTP Code Interpretation Logic ==============
-// Mirrors the logic in checkSiteStatus()
+// Mirrors the default rules in checkSiteStatus() (no PROBE_RULES set);
+// stricter rules are tested in test_probe_rules
 
 /**
  * Determines if site is "up" based on HTTP response code
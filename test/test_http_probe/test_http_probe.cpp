@@ -0,0 +1,402 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_http_probe.cpp
+ * 
+ * Tests for the allocation-free probe (include/http_probe.h)
+ * 
+ * Global operator new/delete are replaced with counting versions so the
+ * steady-state probe path can be shown to allocate nothing.
+ * 
+ * Run with: pio test -e native -f test_http_probe
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <new>
+#include "http_probe.h"
+
+using namespace HttpProbe;
+
+// ============== Allocation Counting ==============
+
+static volatile uint32_t allocCount = 0;
+
+void* operator new(size_t size) {
+    allocCount++;
+    void* p = malloc(size ? size : 1);
+    if (!p) abort();
+    return p;
+}
+
+void* operator new[](size_t size) {
+    allocCount++;
+    void* p = malloc(size ? size : 1);
+    if (!p) abort();
+    return p;
+}
+
+void operator delete(void* p) noexcept { free(p); }
+void operator delete[](void* p) noexcept { free(p); }
+void operator delete(void* p, size_t) noexcept { free(p); }
+void operator delete[](void* p, size_t) noexcept { free(p); }
+
+// ============== Fake Client ==============
+// Serves canned responses from memory, one per connect()
+
+struct FakeClient {
+    const char* responses[4] = {};
+    uint8_t     responseCount = 0;
+    uint8_t     connects      = 0;
+    const char* current       = nullptr;
+    size_t      pos           = 0;
+    bool        refuse        = false;
+    char        lastHost[HOST_MAX] = "";
+    char        lastRequest[REQUEST_MAX] = "";
+
+    bool connect(const char* host, uint16_t port) {
+        if (refuse) return false;
+        strncpy(lastHost, host, sizeof(lastHost) - 1);
+        current = responses[connects < responseCount ? connects : responseCount - 1];
+        connects++;
+        pos = 0;
+        return true;
+    }
+    size_t write(const uint8_t* buf, size_t len) {
+        size_t n = (len < sizeof(lastRequest) - 1) ? len : sizeof(lastRequest) - 1;
+        memcpy(lastRequest, buf, n);
+        lastRequest[n] = '\0';
+        return len;
+    }
+    int available() {
+        return current ? static_cast<int>(strlen(current) - pos) : 0;
+    }
+    int read(uint8_t* buf, size_t len) {
+        // Deliver in small pieces to exercise line reassembly
+        size_t left = strlen(current) - pos;
+        size_t n = (len < 7) ? len : 7;
+        if (n > left) n = left;
+        memcpy(buf, current + pos, n);
+        pos += n;
+        return static_cast<int>(n);
+    }
+    bool connected() { return available() > 0; }
+    void stop() { current = nullptr; }
+};
+
+struct FakeEnv {
+    FakeClient client;
+    uint32_t   clock = 0;
+    uint32_t now() { return clock; }
+    void idle() { clock += 10; }
+    FakeClient& clientFor(const Url&) { return client; }
+};
+
+static ProbeArena arena;
+static FakeEnv    env;
+
+static const char RESP_200[] = "HTTP/1.1 200 OK\r\nContent-Length: 5\r\n\r\nhello";
+static const char RESP_503[] = "HTTP/1.1 503 Service Unavailable\r\n\r\n";
+static const char RESP_301[] = "HTTP/1.1 301 Moved\r\nLocation: https://www.example.com/home\r\n\r\n";
+static const char RESP_302_REL[] = "HTTP/1.1 302 Found\r\nlocation: /login\r\n\r\n";
+static const char RESP_JUNK[] = "SSH-2.0-OpenSSH\r\n";
+
+// ============== Tests: URL Parsing ==============
+
+void test_parse_https_url(void) {
+    Url url;
+    TEST_ASSERT_TRUE(parseUrl("https://example.com/status?x=1", url));
+    TEST_ASSERT_TRUE(url.https);
+    TEST_ASSERT_EQUAL_UINT16(443, url.port);
+    TEST_ASSERT_EQUAL_STRING("example.com", url.host);
+    TEST_ASSERT_EQUAL_STRING("/status?x=1", url.path);
+}
+
+void test_parse_http_url_with_port_no_path(void) {
+    Url url;
+    TEST_ASSERT_TRUE(parseUrl("HTTP://10.0.0.5:8080", url));
+    TEST_ASSERT_FALSE(url.https);
+    TEST_ASSERT_EQUAL_UINT16(8080, url.port);
+    TEST_ASSERT_EQUAL_STRING("/", url.path);
+}
+
+void test_parse_rejects_bad_urls(void) {
+    Url url;
+    TEST_ASSERT_FALSE(parseUrl("ftp://example.com/", url));
+    TEST_ASSERT_FALSE(parseUrl("https:///path", url));
+    TEST_ASSERT_FALSE(parseUrl("https://example.com:99999/", url));
+}
+
+void test_resolve_relative_location(void) {
+    Url base, out;
+    parseUrl("https://example.com:8443/a/b", base);
+    TEST_ASSERT_TRUE(resolveLocation(base, "/c", out));
+    TEST_ASSERT_EQUAL_STRING("example.com", out.host);
+    TEST_ASSERT_EQUAL_UINT16(8443, out.port);
+    TEST_ASSERT_EQUAL_STRING("/c", out.path);
+}
+
+void test_resolve_relative_path_against_directory(void) {
+    Url base, out;
+    parseUrl("https://example.com:8443/a/b", base);
+    TEST_ASSERT_TRUE(resolveLocation(base, "next", out));
+    TEST_ASSERT_EQUAL_STRING("example.com", out.host);
+    TEST_ASSERT_EQUAL_UINT16(8443, out.port);
+    TEST_ASSERT_EQUAL_STRING("/a/next", out.path);
+
+    // RFC 3986 section 5.4 examples, base http://a/b/c/d;p?q
+    static const char* const CASES[][2] = {
+        {"g",          "/b/c/g"},
+        {"./g",        "/b/c/g"},
+        {"g/",         "/b/c/g/"},
+        {"/g",         "/g"},
+        {"?y",         "/b/c/d;p?y"},
+        {"g?y",        "/b/c/g?y"},
+        {"#s",         "/b/c/d;p?q"},
+        {"g#s",        "/b/c/g"},
+        {".",          "/b/c/"},
+        {"..",         "/b/"},
+        {"../g",       "/b/g"},
+        {"../..",      "/"},
+        {"../../../g", "/g"},
+        {"/./g",       "/g"},
+        {"g/../h",     "/b/c/h"},
+        {"g;x=1/../y", "/b/c/y"},
+        {"g?y/./x",    "/b/c/g?y/./x"},
+    };
+    parseUrl("http://a/b/c/d;p?q", base);
+    for (const auto& c : CASES) {
+        TEST_ASSERT_TRUE_MESSAGE(resolveLocation(base, c[0], out), c[0]);
+        TEST_ASSERT_EQUAL_STRING_MESSAGE(c[1], out.path, c[0]);
+    }
+
+    // In place, as follow() does it
+    parseUrl("https://example.com/status/", base);
+    TEST_ASSERT_TRUE(resolveLocation(base, "health", base));
+    TEST_ASSERT_EQUAL_STRING("/status/health", base.path);
+}
+
+void test_resolve_scheme_relative_location(void) {
+    Url base, out;
+    parseUrl("https://example.com/", base);
+    TEST_ASSERT_TRUE(resolveLocation(base, "//cdn.example.com/x", out));
+    TEST_ASSERT_TRUE(out.https);
+    TEST_ASSERT_EQUAL_STRING("cdn.example.com", out.host);
+}
+
+void test_format_url_round_trip(void) {
+    Url url;
+    char buf[HOST_MAX + PATH_MAX + 16];
+    parseUrl("https://www.example.com/health?x=1", url);
+    TEST_ASSERT_EQUAL_UINT32(34, formatUrl(url, buf, sizeof(buf)));
+    TEST_ASSERT_EQUAL_STRING("https://www.example.com/health?x=1", buf);
+
+    parseUrl("http://example.com:8080", url);
+    formatUrl(url, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_STRING("http://example.com:8080/", buf);
+    TEST_ASSERT_EQUAL_UINT32(0, formatUrl(url, buf, 10));
+}
+
+// ============== Tests: Request ==============
+
+void test_build_request(void) {
+    Url url;
+    char buf[REQUEST_MAX];
+    parseUrl("http://example.com:8080/health", url);
+    size_t n = buildRequest(url, buf, sizeof(buf));
+    TEST_ASSERT_EQUAL_UINT32(strlen(buf), n);
+    TEST_ASSERT_TRUE(strncmp(buf, "GET /health HTTP/1.1\r\nHost: example.com:8080\r\n", 46) == 0);
+    TEST_ASSERT_NOT_NULL(strstr(buf, "Connection: close\r\n\r\n"));
+}
+
+void test_build_request_too_small(void) {
+    Url url;
+    char buf[16];
+    parseUrl("http://example.com/", url);
+    TEST_ASSERT_EQUAL_UINT32(0, buildRequest(url, buf, sizeof(buf)));
+}
+
+// ============== Tests: Response Parser ==============
+
+void test_parser_status_and_headers(void) {
+    ResponseParser p;
+    p.reset();
+    size_t used = p.feed(reinterpret_cast<const uint8_t*>(RESP_200), strlen(RESP_200));
+    TEST_ASSERT_TRUE(p.headersDone());
+    TEST_ASSERT_EQUAL_INT(200, p.statusCode());
+    TEST_ASSERT_EQUAL_INT32(5, p.contentLength());
+    TEST_ASSERT_EQUAL_UINT32(strlen(RESP_200) - 5, used);  // Body left unread
+}
+
+void test_parser_rejects_non_http(void) {
+    ResponseParser p;
+    p.reset();
+    p.feed(reinterpret_cast<const uint8_t*>(RESP_JUNK), strlen(RESP_JUNK));
+    TEST_ASSERT_TRUE(p.failed());
+}
+
+// ============== Tests: Body Decoder ==============
+
+void test_decoder_chunked(void) {
+    uint8_t body[] = "7\r\nhealthy\r\n0\r\n\r\n";
+    BodyDecoder d;
+    d.reset(-1, true);
+    size_t n = d.decode(body, sizeof(body) - 1);
+    TEST_ASSERT_EQUAL_UINT32(7, n);
+    TEST_ASSERT_EQUAL_MEMORY("healthy", body, 7);
+    TEST_ASSERT_TRUE(d.done());
+}
+
+void test_decoder_oversized_chunk_saturates(void) {
+    // 2^32 would wrap to 0, the last-chunk marker
+    uint8_t body[] = "100000000\r\nabc";
+    BodyDecoder d;
+    d.reset(-1, true);
+    TEST_ASSERT_EQUAL_UINT32(3, d.decode(body, sizeof(body) - 1));
+    TEST_ASSERT_FALSE(d.done());
+}
+
+// ============== Tests: Probe ==============
+
+void test_probe_200(void) {
+    env.client.responses[0] = RESP_200;
+    env.client.responseCount = 1;
+    ProbeResult r = probe("https://example.com/", arena, 5000, env);
+    TEST_ASSERT_EQUAL_INT(200, r.code);
+    TEST_ASSERT_EQUAL_UINT8(0, r.redirects);
+}
+
+void test_probe_5xx(void) {
+    env.client.responses[0] = RESP_503;
+    env.client.responseCount = 1;
+    TEST_ASSERT_EQUAL_INT(503, probe("https://example.com/", arena, 5000, env).code);
+}
+
+void test_probe_follows_redirects(void) {
+    env.client.responses[0] = RESP_301;
+    env.client.responses[1] = RESP_302_REL;
+    env.client.responses[2] = RESP_200;
+    env.client.responseCount = 3;
+    ProbeResult r = probe("http://example.com/", arena, 5000, env);
+    TEST_ASSERT_EQUAL_INT(200, r.code);
+    TEST_ASSERT_EQUAL_UINT8(2, r.redirects);
+    TEST_ASSERT_EQUAL_STRING("www.example.com", env.client.lastHost);
+    TEST_ASSERT_EQUAL_STRING("/login", arena.url.path);
+}
+
+void test_probe_redirect_limit(void) {
+    env.client.responses[0] = RESP_302_REL;
+    env.client.responseCount = 1;
+    ProbeResult r = probe("http://example.com/", arena, 5000, env);
+    TEST_ASSERT_EQUAL_INT(302, r.code);
+    TEST_ASSERT_EQUAL_UINT8(REDIRECT_LIMIT, r.redirects);
+}
+
+void test_probe_connection_refused(void) {
+    env.client.refuse = true;
+    TEST_ASSERT_EQUAL_INT(ERR_CONNECTION_FAILED, probe("https://example.com/", arena, 5000, env).code);
+}
+
+void test_probe_bad_url(void) {
+    TEST_ASSERT_EQUAL_INT(ERR_BAD_URL, probe("example.com", arena, 5000, env).code);
+}
+
+void test_probe_non_http_server(void) {
+    env.client.responses[0] = RESP_JUNK;
+    env.client.responseCount = 1;
+    TEST_ASSERT_EQUAL_INT(ERR_NO_HTTP_SERVER, probe("https://example.com/", arena, 5000, env).code);
+}
+
+// ============== Tests: Allocation ==============
+
+void test_steady_state_probe_allocates_nothing(void) {
+    env.client.responses[0] = RESP_301;
+    env.client.responses[1] = RESP_200;
+    env.client.responseCount = 2;
+    
+    uint32_t before = allocCount;
+    for (int i = 0; i < 100; i++) {
+        env.client.connects = 0;
+        ProbeResult r = probe("http://example.com/", arena, 5000, env);
+        TEST_ASSERT_EQUAL_INT(200, r.code);
+    }
+    TEST_ASSERT_EQUAL_UINT32(before, allocCount);
+}
+
+void test_allocation_counter_works(void) {
+    uint32_t before = allocCount;
+    int* volatile p = new int(1);
+    delete p;
+    TEST_ASSERT_EQUAL_UINT32(before + 1, allocCount);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    env = FakeEnv();
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+    
+    // URL parsing
+    RUN_TEST(test_parse_https_url);
+    RUN_TEST(test_parse_http_url_with_port_no_path);
+    RUN_TEST(test_parse_rejects_bad_urls);
+    RUN_TEST(test_resolve_relative_location);
+    RUN_TEST(test_resolve_relative_path_against_directory);
+    RUN_TEST(test_resolve_scheme_relative_location);
+    RUN_TEST(test_format_url_round_trip);
+    
+    // Request
+    RUN_TEST(test_build_request);
+    RUN_TEST(test_build_request_too_small);
+    
+    // Response parser
+    RUN_TEST(test_parser_status_and_headers);
+    RUN_TEST(test_parser_rejects_non_http);
+    
+    // Body decoder
+    RUN_TEST(test_decoder_chunked);
+    RUN_TEST(test_decoder_oversized_chunk_saturates);
+    
+    // Probe
+    RUN_TEST(test_probe_200);
+    RUN_TEST(test_probe_5xx);
+    RUN_TEST(test_probe_follows_redirects);
+    RUN_TEST(test_probe_redirect_limit);
+    RUN_TEST(test_probe_connection_refused);
+    RUN_TEST(test_probe_bad_url);
+    RUN_TEST(test_probe_non_http_server);
+    
+    // Allocation
+    RUN_TEST(test_allocation_counter_works);
+    RUN_TEST(test_steady_state_probe_allocates_nothing);
+    
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,282 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_json_fields.cpp
+ *
+ * Tests for the streaming JSON field extractor (include/json_fields.h)
+ *
+ * The fuzz tests check that random chunk splits give the same result as
+ * one whole feed, and that mutated documents never break the parser's
+ * bounds. The benchmark reports parse time per KB.
+ *
+ * Run with: pio test -e native -f test_json_fields
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include "json_fields.h"
+#include "bench_clock.h"
+
+using namespace JsonFields;
+
+static Parser parser;
+static Value  values[FIELD_MAX];
+static char   paths[FIELD_MAX][PATH_MAX];
+
+static const char HEALTH[] =
+    "{\"status\":\"ok\",\"version\":\"1.4.2\",\n"
+    "  \"checks\":{\"db\":{\"status\":\"up\",\"latency_ms\":12},\"cache\":\"up\"},\n"
+    "  \"nodes\":[{\"ok\":true},{\"ok\":false,\"err\":\"disk \\\"full\\\"\"}],\n"
+    "  \"uptime\":-1.5e3, \"maint\":null}";
+
+// ============== Helpers ==============
+
+static void setPaths(const char* const* list, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        strncpy(paths[i], list[i], PATH_MAX - 1);
+        paths[i][PATH_MAX - 1] = '\0';
+    }
+    parser.begin(paths, count, values);
+}
+
+static size_t feedText(const char* text, size_t chunk = 0) {
+    const uint8_t* p = reinterpret_cast<const uint8_t*>(text);
+    size_t len = strlen(text);
+    size_t used = 0;
+    if (chunk == 0) chunk = len ? len : 1;
+    for (size_t i = 0; i < len; i += chunk) {
+        used += parser.feed(p + i, (len - i < chunk) ? len - i : chunk);
+    }
+    return used;
+}
+
+static uint32_t rngState = 1;
+static uint32_t rng() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return rngState >> 8;
+}
+
+// ============== Tests: Extraction ==============
+
+void test_top_level_and_nested_fields(void) {
+    static const char* const P[] = {"status", "checks.db.status", "checks.cache", "checks.db.latency_ms"};
+    setPaths(P, 4);
+    feedText(HEALTH);
+    TEST_ASSERT_EQUAL_HEX8(0x0F, parser.foundMask());
+    TEST_ASSERT_EQUAL_STRING("ok", values[0].text);
+    TEST_ASSERT_EQUAL_STRING("up", values[1].text);
+    TEST_ASSERT_EQUAL_STRING("up", values[2].text);
+    TEST_ASSERT_EQUAL_STRING("12", values[3].text);
+    TEST_ASSERT_TRUE(values[0].equals("ok"));
+    TEST_ASSERT_FALSE(values[0].equals("o"));
+}
+
+void test_array_elements_and_literals(void) {
+    static const char* const P[] = {"nodes.0.ok", "nodes.1.ok", "uptime", "maint"};
+    setPaths(P, 4);
+    feedText(HEALTH);
+    TEST_ASSERT_EQUAL_STRING("true", values[0].text);
+    TEST_ASSERT_EQUAL_STRING("false", values[1].text);
+    TEST_ASSERT_EQUAL_STRING("-1.5e3", values[2].text);
+    TEST_ASSERT_EQUAL_STRING("null", values[3].text);
+}
+
+void test_escapes_decoded(void) {
+    static const char* const P[] = {"nodes.1.err", "u"};
+    setPaths(P, 2);
+    feedText("{\"nodes\":[1,{\"err\":\"disk \\\"full\\\"\"}],\"u\":\"a\\u00e9b\\n\"}");
+    TEST_ASSERT_EQUAL_STRING("disk \"full\"", values[0].text);
+    TEST_ASSERT_EQUAL_STRING("a?b\n", values[1].text);
+}
+
+void test_missing_field_and_object_value(void) {
+    static const char* const P[] = {"checks", "checks.queue"};
+    setPaths(P, 2);
+    feedText(HEALTH);
+    TEST_ASSERT_FALSE(values[0].found);   // Objects are not scalars
+    TEST_ASSERT_FALSE(values[1].found);
+    TEST_ASSERT_TRUE(parser.done());
+    TEST_ASSERT_FALSE(parser.failed());
+}
+
+void test_key_prefix_does_not_match(void) {
+    static const char* const P[] = {"stat"};
+    setPaths(P, 1);
+    feedText("{\"status\":\"ok\",\"stats\":{\"stat\":1}}");
+    TEST_ASSERT_FALSE(values[0].found);
+}
+
+void test_long_value_truncated(void) {
+    static const char* const P[] = {"msg"};
+    setPaths(P, 1);
+    feedText("{\"msg\":\"0123456789abcdefghij\"}");
+    TEST_ASSERT_TRUE(values[0].found);
+    TEST_ASSERT_TRUE(values[0].truncated);
+    TEST_ASSERT_EQUAL_UINT8(VALUE_MAX - 1, values[0].len);
+    TEST_ASSERT_FALSE(values[0].equals("0123456789abcde"));
+}
+
+void test_stops_when_all_found(void) {
+    static const char* const P[] = {"status"};
+    setPaths(P, 1);
+    size_t used = feedText(HEALTH);
+    TEST_ASSERT_EQUAL_UINT32(strlen("{\"status\":\"ok\""), used);
+}
+
+void test_malformed_and_too_deep(void) {
+    static const char* const P[] = {"a"};
+    setPaths(P, 1);
+    feedText("{\"a\" 1}");
+    TEST_ASSERT_TRUE(parser.failed());
+
+    setPaths(P, 1);
+    feedText("[[[[[[[[[1]]]]]]]]]");   // DEPTH_MAX + 1 levels
+    TEST_ASSERT_TRUE(parser.failed());
+
+    setPaths(P, 1);
+    feedText("{\"b\":[1,2,],\"a\":1}");
+    TEST_ASSERT_TRUE(parser.failed());
+    TEST_ASSERT_FALSE(values[0].found);
+}
+
+void test_long_paths_never_match(void) {
+    static const char* const P[] = {"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa", "ok"};   // PATH_MAX - 1
+    setPaths(P, 2);
+    feedText("{\"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\":1,\"ok\":1}");
+    TEST_ASSERT_FALSE(values[0].found);
+    TEST_ASSERT_TRUE(values[1].found);   // Path recovers at the next key
+}
+
+// ============== Tests: Fuzz ==============
+
+void test_fuzz_chunk_splits(void) {
+    static const char* const P[] = {"checks.db.status", "nodes.1.err", "uptime", "version"};
+    Value whole[FIELD_MAX];
+
+    setPaths(P, 4);
+    feedText(HEALTH);
+    memcpy(whole, values, sizeof(whole));
+
+    rngState = 777;
+    const uint8_t* doc = reinterpret_cast<const uint8_t*>(HEALTH);
+    size_t len = strlen(HEALTH);
+    for (int round = 0; round < 500; round++) {
+        parser.begin(paths, 4, values);
+        for (size_t i = 0; i < len;) {
+            size_t n = 1 + rng() % 11;
+            if (n > len - i) n = len - i;
+            parser.feed(doc + i, n);
+            i += n;
+        }
+        TEST_ASSERT_EQUAL_MEMORY(whole, values, sizeof(whole));
+    }
+}
+
+void test_fuzz_mutations_stay_in_bounds(void) {
+    static const char* const P[] = {"status", "checks.db.status", "nodes.0.ok", "maint"};
+    static const char ALPHABET[] = "{}[]:,\"\\ a1.-tu";
+    uint8_t doc[sizeof(HEALTH)];
+
+    rngState = 4242;
+    for (int round = 0; round < 3000; round++) {
+        memcpy(doc, HEALTH, sizeof(doc));
+        int edits = 1 + rng() % 6;
+        for (int e = 0; e < edits; e++) {
+            doc[rng() % (sizeof(doc) - 1)] = ALPHABET[rng() % (sizeof(ALPHABET) - 1)];
+        }
+        setPaths(P, 4);
+        parser.feed(doc, sizeof(doc) - 1);
+        for (uint8_t i = 0; i < 4; i++) {
+            TEST_ASSERT_TRUE(values[i].len < VALUE_MAX);
+            if (values[i].found) TEST_ASSERT_EQUAL_UINT32(values[i].len, strlen(values[i].text));
+        }
+    }
+}
+
+// ============== Tests: Benchmark ==============
+
+void test_benchmark_throughput(void) {
+    static const char* const P[] = {"missing.a", "missing.b"};   // Never done early
+    static char doc[4096];
+    size_t n = 0;
+    doc[n++] = '[';
+    while (n + strlen(HEALTH) + 2 < sizeof(doc)) {
+        if (n > 1) doc[n++] = ',';
+        memcpy(doc + n, HEALTH, strlen(HEALTH));
+        n += strlen(HEALTH);
+    }
+    doc[n++] = ']';
+
+    const int REPEAT = 64;
+    uint32_t start = Bench::nowUs();
+    for (int r = 0; r < REPEAT; r++) {
+        setPaths(P, 2);
+        for (size_t i = 0; i < n; i += 512) {
+            parser.feed(reinterpret_cast<const uint8_t*>(doc) + i, (n - i < 512) ? n - i : 512);
+        }
+        TEST_ASSERT_FALSE(parser.failed());
+    }
+    uint32_t us = Bench::nowUs() - start;
+
+    char msg[80];
+    uint32_t bytes = REPEAT * n;
+    snprintf(msg, sizeof(msg), "%u KB in %u us: %u ns/KB",
+             static_cast<unsigned>(bytes / 1024), static_cast<unsigned>(us),
+             static_cast<unsigned>(1024000ull * us / bytes));
+    TEST_MESSAGE(msg);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    memset(paths, 0, sizeof(paths));
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Extraction
+    RUN_TEST(test_top_level_and_nested_fields);
+    RUN_TEST(test_array_elements_and_literals);
+    RUN_TEST(test_escapes_decoded);
+    RUN_TEST(test_missing_field_and_object_value);
+    RUN_TEST(test_key_prefix_does_not_match);
+    RUN_TEST(test_long_value_truncated);
+    RUN_TEST(test_stops_when_all_found);
+    RUN_TEST(test_malformed_and_too_deep);
+    RUN_TEST(test_long_paths_never_match);
+
+    // Fuzz
+    RUN_TEST(test_fuzz_chunk_splits);
+    RUN_TEST(test_fuzz_mutations_stay_in_bounds);
+
+    // Benchmark
+    RUN_TEST(test_benchmark_throughput);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
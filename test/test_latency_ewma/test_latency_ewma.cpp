@@ -0,0 +1,183 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_latency_ewma.cpp
+ *
+ * Tests for latency anomaly detection (include/latency_ewma.h)
+ *
+ * The traces are probe latencies (ms) as logged by a board checking a
+ * site every 30 s.
+ *
+ * Run with: pio test -e native -f test_latency_ewma
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "latency_ewma.h"
+
+// Healthy site behind a CDN: 250-420 ms with the odd slow handshake
+static const uint16_t TRACE_HEALTHY[] = {
+    312, 298, 341, 305, 287, 330, 356, 301, 295, 318, 420, 309, 284, 300, 327, 311,
+    296, 343, 305, 290, 315, 388, 302, 299, 321, 308, 286, 334, 297, 310, 305, 352,
+};
+
+// Database saturating: latency climbs to just under the 5 s timeout
+static const uint16_t TRACE_SATURATION[] = {
+    1850, 3420, 4710, 4890, 4930, 4880, 4905, 4870,
+};
+
+// Recovery after the incident
+static const uint16_t TRACE_RECOVERY[] = {
+    410, 335, 301, 296, 318, 307,
+};
+
+static LatencyEwma ewma;
+
+// Feed a trace; returns the index at which the state first became slow, or -1
+static int feed(const uint16_t* trace, size_t n) {
+    int first = -1;
+    for (size_t i = 0; i < n; i++) {
+        if (ewma.add(trace[i]) && first < 0) first = static_cast<int>(i);
+    }
+    return first;
+}
+
+#define FEED(trace) feed(trace, sizeof(trace) / sizeof(trace[0]))
+
+// ============== Tests: Statistics ==============
+
+void test_constant_latency_converges(void) {
+    for (int i = 0; i < 50; i++) ewma.add(250);
+    TEST_ASSERT_EQUAL_UINT32(250, ewma.meanMs());
+    TEST_ASSERT_EQUAL_UINT32(0, ewma.sigmaMs());
+    TEST_ASSERT_FALSE(ewma.slow());
+}
+
+void test_mean_and_sigma_track_trace(void) {
+    FEED(TRACE_HEALTHY);
+    TEST_ASSERT_UINT32_WITHIN(25, 315, ewma.meanMs());
+    TEST_ASSERT_TRUE(ewma.sigmaMs() >= 10);
+    TEST_ASSERT_TRUE(ewma.sigmaMs() <= 60);
+}
+
+// ============== Tests: Detection ==============
+
+void test_healthy_trace_never_slow(void) {
+    TEST_ASSERT_EQUAL_INT(-1, FEED(TRACE_HEALTHY));
+    TEST_ASSERT_EQUAL_INT(-1, FEED(TRACE_HEALTHY));
+}
+
+void test_saturation_raises_degraded(void) {
+    FEED(TRACE_HEALTHY);
+    TEST_ASSERT_EQUAL_INT(1, FEED(TRACE_SATURATION));   // Second slow sample
+    TEST_ASSERT_TRUE(ewma.slow());
+}
+
+void test_recovery_clears_after_exit_count(void) {
+    FEED(TRACE_HEALTHY);
+    FEED(TRACE_SATURATION);
+    ewma.add(TRACE_RECOVERY[0]);
+    TEST_ASSERT_TRUE(ewma.slow());
+    ewma.add(TRACE_RECOVERY[1]);
+    TEST_ASSERT_TRUE(ewma.slow());
+    ewma.add(TRACE_RECOVERY[2]);   // Third normal sample
+    TEST_ASSERT_FALSE(ewma.slow());
+}
+
+void test_single_spike_ignored(void) {
+    FEED(TRACE_HEALTHY);
+    TEST_ASSERT_FALSE(ewma.add(4800));
+    TEST_ASSERT_FALSE(ewma.add(310));
+    TEST_ASSERT_EQUAL_INT(-1, FEED(TRACE_HEALTHY));
+}
+
+void test_gradual_drift_accepted(void) {
+    FEED(TRACE_HEALTHY);
+    for (uint32_t ms = 320; ms < 1200; ms += 8) {
+        TEST_ASSERT_FALSE(ewma.add(ms + (ms % 3) * 15));
+    }
+}
+
+void test_lasting_shift_becomes_normal(void) {
+    FEED(TRACE_HEALTHY);
+    int cleared = -1;
+    for (int i = 0; i < 120 && cleared < 0; i++) {
+        ewma.add(1500 + (i % 4) * 20);
+        if (i > 2 && !ewma.slow()) cleared = i;
+    }
+    TEST_ASSERT_TRUE(cleared > 0);
+}
+
+void test_min_delta_on_steady_site(void) {
+    for (int i = 0; i < 20; i++) ewma.add(40);
+    TEST_ASSERT_FALSE(ewma.add(150));   // Many sigma, but only 110 ms
+    TEST_ASSERT_FALSE(ewma.add(150));
+    TEST_ASSERT_FALSE(ewma.add(300));
+    TEST_ASSERT_TRUE(ewma.add(300));
+}
+
+void test_no_judgement_during_warmup(void) {
+    static const uint16_t SLOW_START[] = {300, 310, 4900, 4900, 4900};
+    TEST_ASSERT_EQUAL_INT(-1, FEED(SLOW_START));
+}
+
+void test_thresholds_configurable(void) {
+    LatencyEwma::Params p;
+    p.enterSigma10 = 150;   // 15 sigma
+    p.enterCount   = 1;
+    ewma = LatencyEwma(p);
+    FEED(TRACE_HEALTHY);             // Mean about 317 ms, sigma about 25 ms
+    TEST_ASSERT_FALSE(ewma.add(600));   // About 11 sigma
+    TEST_ASSERT_TRUE(ewma.add(2000));
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    ewma = LatencyEwma();
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Statistics
+    RUN_TEST(test_constant_latency_converges);
+    RUN_TEST(test_mean_and_sigma_track_trace);
+
+    // Detection
+    RUN_TEST(test_healthy_trace_never_slow);
+    RUN_TEST(test_saturation_raises_degraded);
+    RUN_TEST(test_recovery_clears_after_exit_count);
+    RUN_TEST(test_single_spike_ignored);
+    RUN_TEST(test_gradual_drift_accepted);
+    RUN_TEST(test_lasting_shift_becomes_normal);
+    RUN_TEST(test_min_delta_on_steady_site);
+    RUN_TEST(test_no_judgement_during_warmup);
+    RUN_TEST(test_thresholds_configurable);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
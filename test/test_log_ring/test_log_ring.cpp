@@ -0,0 +1,169 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_log_ring.cpp
+ *
+ * Tests for the log ring buffer and level/category names
+ * (include/log_ring.h, include/log.h)
+ *
+ * FakeUart stands in for Serial: it accepts only as many bytes as its
+ * transmit FIFO has room for, like HardwareSerial::availableForWrite().
+ *
+ * Run with: pio test -e native -f test_log_ring
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "log_ring.h"
+#include "log.h"
+
+struct FakeUart {
+    int    room = 128;            // Free FIFO space
+    char   out[512];
+    size_t len = 0;
+
+    int availableForWrite() { return room; }
+
+    size_t write(const uint8_t* data, size_t n) {
+        if (n > static_cast<size_t>(room)) n = room;   // Never happens if the caller checks
+        memcpy(out + len, data, n);
+        len  += n;
+        room -= static_cast<int>(n);
+        out[len] = '\0';
+        return n;
+    }
+};
+
+static FakeUart uart;
+
+// ============== Tests: Ring ==============
+
+void test_lines_come_out_in_order(void) {
+    LogRing<64> ring;
+    TEST_ASSERT_TRUE(ring.push("one\n", 4));
+    TEST_ASSERT_TRUE(ring.push("two\n", 4));
+    TEST_ASSERT_EQUAL(8, ring.drain(uart, 100));
+    TEST_ASSERT_EQUAL_STRING("one\ntwo\n", uart.out);
+    TEST_ASSERT_EQUAL(0, ring.used());
+}
+
+void test_drain_respects_uart_room(void) {
+    LogRing<64> ring;
+    ring.push("0123456789\n", 11);
+    uart.room = 4;
+    TEST_ASSERT_EQUAL(4, ring.drain(uart, 100));
+    TEST_ASSERT_EQUAL(0, ring.drain(uart, 100));    // FIFO full: returns at once
+    TEST_ASSERT_EQUAL(7, ring.used());
+
+    uart.room = 100;
+    TEST_ASSERT_EQUAL(7, ring.drain(uart, 100));
+    TEST_ASSERT_EQUAL_STRING("0123456789\n", uart.out);
+}
+
+void test_drain_respects_budget(void) {
+    LogRing<64> ring;
+    ring.push("0123456789\n", 11);
+    TEST_ASSERT_EQUAL(5, ring.drain(uart, 5));
+    TEST_ASSERT_EQUAL(6, ring.drain(uart, 50));
+}
+
+void test_full_ring_drops_whole_lines(void) {
+    LogRing<16> ring;
+    TEST_ASSERT_TRUE(ring.push("0123456789\n", 11));
+    TEST_ASSERT_FALSE(ring.push("abcdef\n", 7));    // Would need 18 bytes
+    TEST_ASSERT_EQUAL_UINT32(1, ring.dropped());
+    TEST_ASSERT_TRUE(ring.push("xyz\n", 4));        // Smaller line still fits
+
+    ring.drain(uart, 100);
+    TEST_ASSERT_EQUAL_STRING("0123456789\nxyz\n", uart.out);   // No partial line
+}
+
+void test_wraps_around(void) {
+    LogRing<16> ring;
+    for (int i = 0; i < 10; i++) {
+        uart.len  = 0;
+        uart.room = 128;
+        TEST_ASSERT_TRUE(ring.push("abcdefghi\n", 10));
+        TEST_ASSERT_EQUAL(10, ring.drain(uart, 100));
+        TEST_ASSERT_EQUAL_STRING("abcdefghi\n", uart.out);
+    }
+    TEST_ASSERT_EQUAL_UINT32(0, ring.dropped());
+}
+
+void test_exact_fill(void) {
+    LogRing<8> ring;
+    TEST_ASSERT_TRUE(ring.push("1234567\n", 8));
+    TEST_ASSERT_EQUAL(0, ring.free());
+    TEST_ASSERT_FALSE(ring.push("x", 1));
+    TEST_ASSERT_EQUAL(8, ring.drain(uart, 100));
+    TEST_ASSERT_EQUAL(8, ring.free());
+}
+
+// ============== Tests: Names ==============
+
+void test_level_and_category_names(void) {
+    TEST_ASSERT_EQUAL('E', Log::levelChar(Log::Level::ERROR));
+    TEST_ASSERT_EQUAL('W', Log::levelChar(Log::Level::WARN));
+    TEST_ASSERT_EQUAL('I', Log::levelChar(Log::Level::INFO));
+    TEST_ASSERT_EQUAL('D', Log::levelChar(Log::Level::DEBUG));
+    TEST_ASSERT_EQUAL_STRING("wifi", Log::categoryName(Log::Category::WIFI));
+    TEST_ASSERT_EQUAL_STRING("config", Log::categoryName(Log::Category::CONFIG));
+    TEST_ASSERT_EQUAL_STRING("?", Log::categoryName(Log::Category::COUNT));
+}
+
+void test_levels_ordered(void) {
+    // A level is compiled in when LOG_LEVEL >= its value
+    TEST_ASSERT_TRUE(LOG_LEVEL_NONE < LOG_LEVEL_ERROR);
+    TEST_ASSERT_TRUE(LOG_LEVEL_ERROR < LOG_LEVEL_WARN);
+    TEST_ASSERT_TRUE(LOG_LEVEL_WARN < LOG_LEVEL_INFO);
+    TEST_ASSERT_TRUE(LOG_LEVEL_INFO < LOG_LEVEL_DEBUG);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    uart = FakeUart();
+    uart.out[0] = '\0';
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Ring
+    RUN_TEST(test_lines_come_out_in_order);
+    RUN_TEST(test_drain_respects_uart_room);
+    RUN_TEST(test_drain_respects_budget);
+    RUN_TEST(test_full_ring_drops_whole_lines);
+    RUN_TEST(test_wraps_around);
+    RUN_TEST(test_exact_fill);
+
+    // Names
+    RUN_TEST(test_level_and_category_names);
+    RUN_TEST(test_levels_ordered);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
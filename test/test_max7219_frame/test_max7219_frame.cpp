@@ -0,0 +1,116 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_max7219_frame.cpp
+ * 
+ * Tests for MAX7219 row packing (include/max7219_frame.h)
+ * 
+ * Run with: pio test -e native -f test_max7219_frame
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "max7219_frame.h"
+
+using namespace Max7219Frame;
+
+constexpr uint8_t DEVICES = 4;
+constexpr uint16_t COLUMNS = DEVICES * COLS_PER_DEV;
+
+static uint8_t cols[COLUMNS];
+static uint8_t packed[frameBytes(DEVICES)];
+
+// ============== Tests: Sizes ==============
+
+void test_frame_fits_hspi_fifo(void) {
+    // 4 modules x 8 rows x 2 bytes is exactly one 64-byte FIFO load
+    TEST_ASSERT_EQUAL_UINT32(64, frameBytes(DEVICES));
+    TEST_ASSERT_EQUAL_UINT32(8, rowBytes(DEVICES));
+}
+
+// ============== Tests: Packing ==============
+
+void test_blank_frame_has_digit_opcodes(void) {
+    packFrame(cols, DEVICES, packed);
+    for (uint8_t row = 0; row < ROWS; row++) {
+        for (uint8_t dev = 0; dev < DEVICES; dev++) {
+            TEST_ASSERT_EQUAL_UINT8(OP_DIGIT0 + row, packed[row * 8 + dev * 2]);
+            TEST_ASSERT_EQUAL_UINT8(0, packed[row * 8 + dev * 2 + 1]);
+        }
+    }
+}
+
+void test_leftmost_column_goes_to_first_byte_out(void) {
+    // Leftmost module is the far end of the chain, so it is shifted first
+    cols[0] = 0x01;  // Top row
+    packRow(cols, DEVICES, 0, packed);
+    TEST_ASSERT_EQUAL_HEX8(0x01, packed[1]);
+    TEST_ASSERT_EQUAL_HEX8(0x00, packed[7]);
+}
+
+void test_rightmost_column_goes_to_last_byte_out(void) {
+    cols[COLUMNS - 1] = 0x01;
+    packRow(cols, DEVICES, 0, packed);
+    TEST_ASSERT_EQUAL_HEX8(0x80, packed[7]);
+}
+
+void test_row_selects_bit(void) {
+    cols[0] = 0x80;  // Bottom row only
+    packRow(cols, DEVICES, 0, packed);
+    TEST_ASSERT_EQUAL_HEX8(0x00, packed[1]);
+    packRow(cols, DEVICES, 7, packed);
+    TEST_ASSERT_EQUAL_HEX8(0x01, packed[1]);
+}
+
+void test_full_row(void) {
+    memset(cols, 0x10, sizeof(cols));
+    packFrame(cols, DEVICES, packed);
+    for (uint8_t dev = 0; dev < DEVICES; dev++) {
+        TEST_ASSERT_EQUAL_HEX8(0xFF, packed[4 * 8 + dev * 2 + 1]);
+        TEST_ASSERT_EQUAL_HEX8(0x00, packed[3 * 8 + dev * 2 + 1]);
+    }
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    memset(cols, 0, sizeof(cols));
+    memset(packed, 0xAA, sizeof(packed));
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+    
+    RUN_TEST(test_frame_fits_hspi_fifo);
+    RUN_TEST(test_blank_frame_has_digit_opcodes);
+    RUN_TEST(test_leftmost_column_goes_to_first_byte_out);
+    RUN_TEST(test_rightmost_column_goes_to_last_byte_out);
+    RUN_TEST(test_row_selects_bit);
+    RUN_TEST(test_full_row);
+    
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
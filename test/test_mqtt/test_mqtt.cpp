@@ -0,0 +1,376 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_mqtt.cpp
+ *
+ * Tests for the MQTT packet encoder, event outbox and publisher session
+ * (include/mqtt_packet.h, include/event_outbox.h, include/mqtt_session.h)
+ *
+ * The session talks to an in-process broker stand-in that decodes every
+ * packet written to it and answers CONNECT and PINGREQ.
+ *
+ * Run with: pio test -e native -f test_mqtt
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include <new>
+#include "mqtt_packet.h"
+#include "event_outbox.h"
+#include "mqtt_session.h"
+
+// ============== Broker Stand-in ==============
+// Acts as the TCP client: bytes written are decoded as broker input,
+// replies are queued for read()
+
+struct FakeBroker {
+    // Behaviour
+    bool    reachable   = true;
+    uint8_t connackCode = 0;
+    bool    answerPings = true;
+    int     window      = 1024;      // availableForWrite()
+
+    // Connection
+    bool    open     = false;
+    uint8_t connects = 0;
+    uint8_t rx[16];
+    size_t  rxLen = 0;
+    size_t  rxPos = 0;
+
+    // Decoded traffic
+    char     clientId[32] = "";
+    uint16_t keepAlive    = 0;
+    uint8_t  pings        = 0;
+    uint8_t  publishCount = 0;
+    char     topics[16][48];
+    char     payloads[16][160];
+    bool     retained[16];
+
+    int connect(const char*, uint16_t) {
+        if (!reachable) return 0;
+        open = true;
+        connects++;
+        rxLen = rxPos = 0;
+        return 1;
+    }
+    bool connected() { return open; }
+    int available() { return open ? static_cast<int>(rxLen - rxPos) : 0; }
+    int read(uint8_t* buf, size_t len) {
+        size_t n = rxLen - rxPos;
+        if (n > len) n = len;
+        memcpy(buf, rx + rxPos, n);
+        rxPos += n;
+        return static_cast<int>(n);
+    }
+    int availableForWrite() { return open ? window : 0; }
+    void stop() { open = false; }
+
+    size_t write(const uint8_t* buf, size_t len) {
+        if (!open) return 0;
+        uint32_t remaining = 0;
+        size_t used = 1, mult = 1;
+        do {
+            remaining += (buf[used] & 0x7F) * mult;
+            mult *= 128;
+        } while (buf[used++] & 0x80);
+        TEST_ASSERT_EQUAL_UINT32(len, used + remaining);   // One whole packet per write
+
+        const uint8_t* body = buf + used;
+        switch (buf[0] & 0xF0) {
+            case Mqtt::CONNECT: {
+                TEST_ASSERT_EQUAL_MEMORY("\x00\x04MQTT\x04\x02", body, 8);
+                keepAlive = (body[8] << 8) | body[9];
+                size_t idLen = (body[10] << 8) | body[11];
+                memcpy(clientId, body + 12, idLen);
+                clientId[idLen] = '\0';
+                reply(Mqtt::CONNACK, connackCode);
+                break;
+            }
+            case Mqtt::PUBLISH: {
+                size_t topicLen = (body[0] << 8) | body[1];
+                size_t payloadLen = remaining - 2 - topicLen;
+                memcpy(topics[publishCount], body + 2, topicLen);
+                topics[publishCount][topicLen] = '\0';
+                memcpy(payloads[publishCount], body + 2 + topicLen, payloadLen);
+                payloads[publishCount][payloadLen] = '\0';
+                retained[publishCount] = buf[0] & Mqtt::PUBLISH_RETAIN;
+                publishCount++;
+                break;
+            }
+            case Mqtt::PINGREQ:
+                pings++;
+                if (answerPings) {
+                    rx[rxLen++] = Mqtt::PINGRESP;
+                    rx[rxLen++] = 0;
+                }
+                break;
+        }
+        return len;
+    }
+
+    void reply(uint8_t type, uint8_t code) {
+        rx[rxLen++] = type;
+        rx[rxLen++] = 2;
+        rx[rxLen++] = 0;
+        rx[rxLen++] = code;
+    }
+};
+
+typedef MqttSession<FakeBroker, 4, 64> Session;
+
+static FakeBroker broker;
+static Session*   session;
+static uint8_t    buf[256];
+
+// Run handle() a few times, as loop() would
+static void pump(uint32_t now, int passes = 4, bool mayBlock = true) {
+    for (int i = 0; i < passes; i++) session->handle(now, mayBlock);
+}
+
+// ============== Tests: Packets ==============
+
+void test_remaining_length_encoding(void) {
+    uint8_t out[4];
+    TEST_ASSERT_EQUAL(1, Mqtt::encodeRemainingLength(127, out));
+    TEST_ASSERT_EQUAL_HEX8(0x7F, out[0]);
+    TEST_ASSERT_EQUAL(2, Mqtt::encodeRemainingLength(128, out));
+    TEST_ASSERT_EQUAL_HEX8(0x80, out[0]);
+    TEST_ASSERT_EQUAL_HEX8(0x01, out[1]);
+    TEST_ASSERT_EQUAL(3, Mqtt::encodeRemainingLength(16384, out));
+    TEST_ASSERT_EQUAL(2, Mqtt::remainingLengthSize(16383));
+}
+
+void test_encode_connect(void) {
+    size_t len = Mqtt::encodeConnect(buf, sizeof(buf), "abc", 60);
+    static const uint8_t expected[] = {
+        0x10, 15, 0, 4, 'M', 'Q', 'T', 'T', 4, 0x02, 0, 60, 0, 3, 'a', 'b', 'c'
+    };
+    TEST_ASSERT_EQUAL(sizeof(expected), len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, buf, len);
+}
+
+void test_encode_publish_retained(void) {
+    size_t len = Mqtt::encodePublish(buf, sizeof(buf), "a/b",
+                                     reinterpret_cast<const uint8_t*>("hi"), 2, true);
+    static const uint8_t expected[] = {0x31, 7, 0, 3, 'a', '/', 'b', 'h', 'i'};
+    TEST_ASSERT_EQUAL(sizeof(expected), len);
+    TEST_ASSERT_EQUAL_MEMORY(expected, buf, len);
+}
+
+void test_encode_rejects_small_buffer(void) {
+    TEST_ASSERT_EQUAL(0, Mqtt::encodePublish(buf, 8, "a/b",
+                                             reinterpret_cast<const uint8_t*>("hi"), 2, false));
+    TEST_ASSERT_EQUAL(0, Mqtt::encodeConnect(buf, 10, "abc", 60));
+}
+
+void test_reader_connack_and_pingresp(void) {
+    Mqtt::PacketReader reader;
+    const uint8_t stream[] = {0x20, 2, 0, 5, 0xD0, 0};
+    TEST_ASSERT_FALSE(reader.feed(stream[0]));
+    TEST_ASSERT_FALSE(reader.feed(stream[1]));
+    TEST_ASSERT_FALSE(reader.feed(stream[2]));
+    TEST_ASSERT_TRUE(reader.feed(stream[3]));
+    TEST_ASSERT_EQUAL(5, reader.connackCode());
+    TEST_ASSERT_FALSE(reader.feed(stream[4]));
+    TEST_ASSERT_TRUE(reader.feed(stream[5]));
+    TEST_ASSERT_EQUAL_HEX8(Mqtt::PINGRESP, reader.type());
+    TEST_ASSERT_EQUAL(-1, reader.connackCode());
+}
+
+void test_reader_rejects_overlong_length(void) {
+    Mqtt::PacketReader reader;
+    reader.feed(0x30);
+    bool done = false;
+    for (int i = 0; i < 4 && !done; i++) done = reader.feed(0xFF);
+    TEST_ASSERT_TRUE(done);
+    TEST_ASSERT_TRUE(reader.malformed());
+}
+
+// ============== Tests: Outbox ==============
+
+void test_outbox_fifo_order(void) {
+    EventOutbox<3, 16> box;
+    box.push("t", "one");
+    box.push("t", "two");
+    TEST_ASSERT_EQUAL(2, box.count());
+    TEST_ASSERT_EQUAL_MEMORY("one", box.front().payload, 3);
+    box.pop();
+    TEST_ASSERT_EQUAL_MEMORY("two", box.front().payload, 3);
+}
+
+void test_outbox_drops_oldest_when_full(void) {
+    EventOutbox<2, 16> box;
+    TEST_ASSERT_TRUE(box.push("t", "a"));
+    TEST_ASSERT_TRUE(box.push("t", "b"));
+    TEST_ASSERT_FALSE(box.push("t", "c"));
+    TEST_ASSERT_EQUAL_UINT32(1, box.dropped());
+    TEST_ASSERT_EQUAL('b', box.front().payload[0]);
+}
+
+void test_outbox_truncates_long_payload(void) {
+    EventOutbox<2, 4> box;
+    box.push("t", "abcdef");
+    TEST_ASSERT_EQUAL(4, box.front().length);
+    TEST_ASSERT_EQUAL_UINT32(1, box.truncated());
+}
+
+// ============== Tests: Session ==============
+
+void test_session_connects_and_publishes(void) {
+    session->publish("panel/status", "{\"up\":true}", true);
+    pump(1000);
+    TEST_ASSERT_TRUE(session->isConnected());
+    TEST_ASSERT_EQUAL_STRING("panel-1", broker.clientId);
+    TEST_ASSERT_EQUAL(60, broker.keepAlive);
+    TEST_ASSERT_EQUAL(1, broker.publishCount);
+    TEST_ASSERT_EQUAL_STRING("panel/status", broker.topics[0]);
+    TEST_ASSERT_EQUAL_STRING("{\"up\":true}", broker.payloads[0]);
+    TEST_ASSERT_TRUE(broker.retained[0]);
+}
+
+void test_offline_events_flushed_in_order(void) {
+    broker.reachable = false;
+    pump(1000);
+    session->publish("panel/status", "down");
+    session->publish("panel/summary", "s1");
+    session->publish("panel/status", "up");
+    pump(2000);
+    TEST_ASSERT_EQUAL(0, broker.publishCount);
+
+    // Broker back; retry waits for RETRY_INTERVAL
+    broker.reachable = true;
+    pump(1000 + Session::RETRY_INTERVAL - 1);
+    TEST_ASSERT_EQUAL(0, broker.connects);
+    pump(1000 + Session::RETRY_INTERVAL);
+    TEST_ASSERT_EQUAL(3, broker.publishCount);
+    TEST_ASSERT_EQUAL_STRING("down", broker.payloads[0]);
+    TEST_ASSERT_EQUAL_STRING("s1", broker.payloads[1]);
+    TEST_ASSERT_EQUAL_STRING("up", broker.payloads[2]);
+}
+
+void test_no_connect_unless_allowed_to_block(void) {
+    session->publish("panel/status", "x");
+    pump(1000, 4, false);
+    TEST_ASSERT_EQUAL(0, broker.connects);
+    pump(1000, 4, true);
+    TEST_ASSERT_EQUAL(1, broker.publishCount);
+}
+
+void test_flush_budget_per_pass(void) {
+    pump(1000, 2);   // Connect, CONNACK
+    TEST_ASSERT_TRUE(session->isConnected());
+    for (int i = 0; i < 4; i++) session->publish("t", "p");
+    session->handle(1000, true);
+    TEST_ASSERT_EQUAL(Session::FLUSH_BUDGET, broker.publishCount);
+    session->handle(1000, true);
+    TEST_ASSERT_EQUAL(4, broker.publishCount);
+}
+
+void test_waits_for_send_window(void) {
+    pump(1000, 2);
+    broker.window = 4;
+    session->publish("panel/status", "payload");
+    pump(1000);
+    TEST_ASSERT_EQUAL(0, broker.publishCount);
+    TEST_ASSERT_EQUAL(1, session->outbox().count());
+    broker.window = 1024;
+    pump(1000, 1);
+    TEST_ASSERT_EQUAL(1, broker.publishCount);
+}
+
+void test_refused_connack_drops_session(void) {
+    broker.connackCode = 5;   // Not authorised
+    session->publish("t", "p");
+    pump(1000);
+    TEST_ASSERT_FALSE(session->isConnected());
+    TEST_ASSERT_EQUAL(5, session->lastRefusal());
+    TEST_ASSERT_EQUAL(0, broker.publishCount);
+    TEST_ASSERT_EQUAL(1, session->outbox().count());
+}
+
+void test_keepalive_ping_and_dead_broker(void) {
+    pump(0, 2);
+    pump(30000, 2);                   // Half the keep-alive: ping
+    TEST_ASSERT_EQUAL(1, broker.pings);
+    TEST_ASSERT_TRUE(session->isConnected());
+
+    broker.answerPings = false;
+    pump(60000, 2);
+    TEST_ASSERT_EQUAL(2, broker.pings);
+    pump(120000, 1);                  // No PINGRESP within a period
+    TEST_ASSERT_FALSE(session->isConnected());
+}
+
+void test_dropped_connection_reconnects(void) {
+    pump(1000, 2);
+    broker.stop();                    // WiFi loss
+    session->publish("t", "queued");
+    pump(2000);
+    TEST_ASSERT_FALSE(session->isConnected());
+    pump(1000 + Session::RETRY_INTERVAL);
+    TEST_ASSERT_EQUAL(2, broker.connects);
+    TEST_ASSERT_EQUAL(1, broker.publishCount);
+    TEST_ASSERT_EQUAL_STRING("queued", broker.payloads[0]);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+alignas(Session) static uint8_t sessionStorage[sizeof(Session)];
+
+void setUp(void) {
+    broker = FakeBroker();
+    session = new (sessionStorage) Session(broker, "broker", 1883, "panel-1", 60);
+}
+
+void tearDown(void) {
+    session->~Session();
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Packets
+    RUN_TEST(test_remaining_length_encoding);
+    RUN_TEST(test_encode_connect);
+    RUN_TEST(test_encode_publish_retained);
+    RUN_TEST(test_encode_rejects_small_buffer);
+    RUN_TEST(test_reader_connack_and_pingresp);
+    RUN_TEST(test_reader_rejects_overlong_length);
+
+    // Outbox
+    RUN_TEST(test_outbox_fifo_order);
+    RUN_TEST(test_outbox_drops_oldest_when_full);
+    RUN_TEST(test_outbox_truncates_long_payload);
+
+    // Session
+    RUN_TEST(test_session_connects_and_publishes);
+    RUN_TEST(test_offline_events_flushed_in_order);
+    RUN_TEST(test_no_connect_unless_allowed_to_block);
+    RUN_TEST(test_flush_budget_per_pass);
+    RUN_TEST(test_waits_for_send_window);
+    RUN_TEST(test_refused_connack_drops_session);
+    RUN_TEST(test_keepalive_ping_and_dead_broker);
+    RUN_TEST(test_dropped_connection_reconnects);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
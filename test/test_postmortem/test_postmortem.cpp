@@ -0,0 +1,130 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_postmortem.cpp
+ * 
+ * Tests for the RTC post-mortem record (include/postmortem.h)
+ * 
+ * Run with: pio test -e native -f test_postmortem
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "postmortem.h"
+
+using namespace PostMortem;
+
+static Record record;
+
+// ============== Tests: CRC ==============
+
+void test_crc32_check_value(void) {
+    const char* check = "123456789";
+    TEST_ASSERT_EQUAL_HEX32(0xCBF43926, crc32(reinterpret_cast<const uint8_t*>(check), 9));
+}
+
+void test_crc32_empty(void) {
+    TEST_ASSERT_EQUAL_HEX32(0, crc32(nullptr, 0));
+}
+
+// ============== Tests: Record ==============
+
+void test_sealed_record_is_valid(void) {
+    record.bootCount = 3;
+    record.section   = static_cast<uint8_t>(Section::PROBE);
+    seal(record);
+    TEST_ASSERT_TRUE(isValid(record));
+}
+
+void test_random_memory_is_invalid(void) {
+    // RTC memory holds garbage after power-on
+    memset(&record, 0xA5, sizeof(record));
+    TEST_ASSERT_FALSE(isValid(record));
+}
+
+void test_tampered_record_is_invalid(void) {
+    seal(record);
+    record.uptimeMs++;
+    TEST_ASSERT_FALSE(isValid(record));
+}
+
+void test_push_seq_is_covered_by_crc(void) {
+    record.pushSeq = 1700000123;
+    record.flags   = FLAG_PUSH_SEQ;
+    seal(record);
+    TEST_ASSERT_TRUE(isValid(record));
+    record.pushSeq--;   // A rolled-back seq must not pass as valid
+    TEST_ASSERT_FALSE(isValid(record));
+}
+
+void test_record_is_word_sized(void) {
+    TEST_ASSERT_EQUAL_UINT32(0, sizeof(Record) % 4);
+}
+
+// ============== Tests: Names ==============
+
+void test_section_names(void) {
+    TEST_ASSERT_EQUAL_STRING("probe", sectionName(Section::PROBE));
+    TEST_ASSERT_EQUAL_STRING("wifi_reconnect", sectionName(Section::WIFI_RECONNECT));
+    TEST_ASSERT_EQUAL_STRING("http_server", sectionName(Section::HTTP_SERVER));
+    TEST_ASSERT_EQUAL_STRING("log", sectionName(Section::LOG));
+    TEST_ASSERT_EQUAL_STRING("unknown", sectionName(static_cast<Section>(200)));
+}
+
+void test_reset_reason_names(void) {
+    TEST_ASSERT_EQUAL_STRING("power_on", resetReasonName(0));
+    TEST_ASSERT_EQUAL_STRING("exception", resetReasonName(2));
+    TEST_ASSERT_EQUAL_STRING("soft_watchdog", resetReasonName(3));
+    TEST_ASSERT_EQUAL_STRING("unknown", resetReasonName(42));
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    record = Record();
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+    
+    // CRC
+    RUN_TEST(test_crc32_check_value);
+    RUN_TEST(test_crc32_empty);
+    
+    // Record
+    RUN_TEST(test_sealed_record_is_valid);
+    RUN_TEST(test_random_memory_is_invalid);
+    RUN_TEST(test_tampered_record_is_invalid);
+    RUN_TEST(test_push_seq_is_covered_by_crc);
+    RUN_TEST(test_record_is_word_sized);
+    
+    // Names
+    RUN_TEST(test_section_names);
+    RUN_TEST(test_reset_reason_names);
+    
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
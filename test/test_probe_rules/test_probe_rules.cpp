@@ -0,0 +1,270 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_probe_rules.cpp
+ *
+ * Tests for the response classification rules (include/probe_rules.h),
+ * on their own and driven by the streaming probe
+ *
+ * Run with: pio test -e native -f test_probe_rules
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "http_probe.h"
+#include "probe_rules.h"
+
+using namespace ProbeRules;
+
+// ============== Fake Client ==============
+// One canned response, delivered a few bytes per read
+
+struct FakeClient {
+    const char* response = nullptr;
+    size_t      pos      = 0;
+    size_t      reads    = 0;
+    size_t      piece    = 5;
+
+    bool connect(const char*, uint16_t) { pos = 0; return true; }
+    size_t write(const uint8_t*, size_t len) { return len; }
+    int available() { return response ? static_cast<int>(strlen(response) - pos) : 0; }
+    int read(uint8_t* buf, size_t len) {
+        size_t left = strlen(response) - pos;
+        size_t n = (len < piece) ? len : piece;
+        if (n > left) n = left;
+        memcpy(buf, response + pos, n);
+        pos += n;
+        reads++;
+        return static_cast<int>(n);
+    }
+    bool connected() { return available() > 0; }
+    void stop() {}
+};
+
+struct FakeEnv {
+    FakeClient client;
+    uint32_t   clock = 0;
+    uint32_t now() { return clock; }
+    void idle() { clock += 10; }
+    FakeClient& clientFor(const HttpProbe::Url&) { return client; }
+};
+
+static HttpProbe::ProbeArena arena;
+static FakeEnv               env;
+static Table                 table;
+
+static const char RESP_OK[] =
+    "HTTP/1.1 200 OK\r\nX-Health: pass\r\nContent-Length: 26\r\n\r\n"
+    "{\"status\":\"healthy\",\"x\":1}";
+static const char RESP_CHUNKED[] =
+    "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+    "3\r\nhea\r\n1\r\nl\r\n4;ext=1\r\nthy!\r\n0\r\n\r\n";
+static const char RESP_404[] = "HTTP/1.1 404 Not Found\r\nContent-Length: 9\r\n\r\nnot found";
+
+// Run the probe with rules compiled from text; returns the verdict
+static Reason check(const char* rules, const char* response, uint32_t latencyMs = 100) {
+    TEST_ASSERT_EQUAL(Error::NONE, compile(rules, table));
+    env.client.response = response;
+    Evaluator eval(table);
+    HttpProbe::ProbeResult r = HttpProbe::probe("http://example.com/", arena, 5000, env, eval);
+    return eval.verdict(r.code, latencyMs);
+}
+
+// ============== Tests: Compiling ==============
+
+void test_compile_full_rule_line(void) {
+    const char* text = "status=200,204, 300-399; header=X-Health; body~\"status ok\"; "
+                       "body!~error; bytes=2048; latency<1500";
+    TEST_ASSERT_EQUAL(Error::NONE, compile(text, table));
+    TEST_ASSERT_EQUAL_UINT8(3, table.statusCount);
+    TEST_ASSERT_EQUAL_UINT16(300, table.status[2].lo);
+    TEST_ASSERT_EQUAL_UINT16(399, table.status[2].hi);
+    TEST_ASSERT_EQUAL_UINT8(1, table.headerCount);
+    TEST_ASSERT_EQUAL_STRING("X-Health", table.headers[0]);
+    TEST_ASSERT_EQUAL_UINT8(2, table.patternCount);
+    TEST_ASSERT_EQUAL_UINT8(9, table.patterns[0].len);
+    TEST_ASSERT_FALSE(table.patterns[0].negate);
+    TEST_ASSERT_TRUE(table.patterns[1].negate);
+    TEST_ASSERT_EQUAL_UINT16(2048, table.bodyLimit);
+    TEST_ASSERT_EQUAL_UINT32(1500, table.maxLatencyMs);
+}
+
+void test_compile_empty_is_default(void) {
+    TEST_ASSERT_EQUAL(Error::NONE, compile("", table));
+    TEST_ASSERT_EQUAL_UINT8(0, table.statusCount);
+    TEST_ASSERT_EQUAL(Error::NONE, compile(nullptr, table));
+    TEST_ASSERT_EQUAL_UINT16(BODY_DEFAULT, table.bodyLimit);
+}
+
+void test_compile_errors(void) {
+    size_t at = 0;
+    TEST_ASSERT_EQUAL(Error::UNKNOWN_CLAUSE, compile("status=200; colour=red", table, &at));
+    TEST_ASSERT_EQUAL_UINT32(12, at);
+    TEST_ASSERT_EQUAL_UINT8(0, table.statusCount);   // Left as the default
+    TEST_ASSERT_EQUAL(Error::BAD_NUMBER, compile("status=299-200", table));
+    TEST_ASSERT_EQUAL(Error::BAD_NUMBER, compile("status=1000", table));
+    TEST_ASSERT_EQUAL(Error::BAD_NUMBER, compile("latency<0", table));
+    TEST_ASSERT_EQUAL(Error::TOO_MANY, compile("body~a; body~b; body~c; body~d; body~e", table));
+    TEST_ASSERT_EQUAL(Error::TOO_LONG, compile("body~0123456789012345678901234567890123", table));
+    TEST_ASSERT_EQUAL(Error::TOO_LONG, compile("body~\"unterminated", table));
+    TEST_ASSERT_EQUAL(Error::UNKNOWN_CLAUSE, compile("status=200 204", table));
+}
+
+// ============== Tests: Evaluating ==============
+
+void test_default_rules_match_old_behaviour(void) {
+    compile("", table);
+    Evaluator eval(table);
+    eval.begin();
+    TEST_ASSERT_EQUAL(Reason::OK, eval.verdict(200, 10));
+    TEST_ASSERT_EQUAL(Reason::OK, eval.verdict(404, 10));
+    TEST_ASSERT_EQUAL(Reason::STATUS, eval.verdict(500, 10));
+    TEST_ASSERT_EQUAL(Reason::NO_RESPONSE, eval.verdict(-4, 10));
+    TEST_ASSERT_FALSE(eval.wantBody(200));
+}
+
+void test_status_set_makes_404_an_outage(void) {
+    TEST_ASSERT_EQUAL(Reason::STATUS, check("status=200-299", RESP_404));
+    TEST_ASSERT_EQUAL(Reason::OK, check("status=200-299", RESP_OK));
+}
+
+void test_header_presence_any_case(void) {
+    TEST_ASSERT_EQUAL(Reason::OK, check("header=x-health", RESP_OK));
+    TEST_ASSERT_EQUAL(Reason::HEADER, check("header=X-Version", RESP_OK));
+}
+
+void test_body_patterns_across_reads(void) {
+    TEST_ASSERT_EQUAL(Reason::OK, check("body~healthy", RESP_OK));
+    TEST_ASSERT_EQUAL(Reason::BODY, check("body~unhealthy", RESP_OK));
+    TEST_ASSERT_EQUAL(Reason::OK, check("body!~error", RESP_OK));
+    TEST_ASSERT_EQUAL(Reason::BODY, check("body!~x\":1", RESP_OK));
+}
+
+void test_body_pattern_in_chunked_response(void) {
+    // "healthy!" split over three chunks, one with an extension
+    TEST_ASSERT_EQUAL(Reason::OK, check("body~healthy!", RESP_CHUNKED));
+    TEST_ASSERT_EQUAL(Reason::BODY, check("body~ext", RESP_CHUNKED));   // Framing is not payload
+}
+
+void test_body_limit(void) {
+    TEST_ASSERT_EQUAL(Reason::BODY, check("body~healthy; bytes=12", RESP_OK));
+    TEST_ASSERT_EQUAL(Reason::OK, check("body~healthy; bytes=18", RESP_OK));
+}
+
+void test_overlapping_pattern(void) {
+    static const char resp[] = "HTTP/1.1 200 OK\r\n\r\nxaabaaabx";
+    TEST_ASSERT_EQUAL(Reason::OK, check("body~aaab", resp));
+}
+
+void test_latency_limit(void) {
+    TEST_ASSERT_EQUAL(Reason::OK, check("latency<500", RESP_OK, 499));
+    TEST_ASSERT_EQUAL(Reason::LATENCY, check("latency<500", RESP_OK, 501));
+}
+
+void test_json_fields(void) {
+    TEST_ASSERT_EQUAL(Reason::OK, check("json.status=healthy; json.x=1", RESP_OK));
+    TEST_ASSERT_EQUAL(Reason::JSON, check("json.status=ok", RESP_OK));
+    TEST_ASSERT_EQUAL(Reason::OK, check("json.status!=down", RESP_OK));
+    TEST_ASSERT_EQUAL(Reason::JSON, check("json.db!=down", RESP_OK));   // Must be present
+}
+
+void test_json_in_chunked_response(void) {
+    static const char resp[] =
+        "HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n"
+        "9\r\n{\"checks\"\r\n11\r\n:{\"db\":\"up\"},\"ok\"\r\n6\r\n:true}\r\n0\r\n\r\n";
+    TEST_ASSERT_EQUAL(Reason::OK, check("json.checks.db=up; json.ok=true", resp));
+}
+
+void test_compile_json_clauses(void) {
+    TEST_ASSERT_EQUAL(Error::NONE, compile("json.checks.db=\"all up\"; json.ok!=false", table));
+    TEST_ASSERT_EQUAL_UINT8(2, table.jsonCount);
+    TEST_ASSERT_EQUAL_STRING("checks.db", table.jsonPaths[0]);
+    TEST_ASSERT_EQUAL_STRING("all up", table.json[0].expect);
+    TEST_ASSERT_TRUE(table.json[1].negate);
+    TEST_ASSERT_EQUAL(Error::UNKNOWN_CLAUSE, compile("json.=x", table));
+    TEST_ASSERT_EQUAL(Error::UNKNOWN_CLAUSE, compile("json.status", table));
+    TEST_ASSERT_EQUAL(Error::TOO_LONG, compile("json.s=0123456789abcdef", table));
+}
+
+void test_failed_status_body_not_read(void) {
+    env.client.piece = 64;
+    check("status=200; body~found", RESP_404);
+    TEST_ASSERT_EQUAL_UINT32(1, env.client.reads);   // Headers only
+}
+
+void test_reading_stops_once_decided(void) {
+    static const char resp[] =
+        "HTTP/1.1 200 OK\r\nContent-Length: 40\r\n\r\n"
+        "ok..................................end.";
+    compile("body~ok", table);
+    env.client.response = resp;
+    Evaluator eval(table);
+    HttpProbe::probe("http://example.com/", arena, 5000, env, eval);
+    TEST_ASSERT_EQUAL(Reason::OK, eval.verdict(200, 10));
+    TEST_ASSERT_EQUAL_UINT16(2, eval.bodyBytes());
+    TEST_ASSERT_TRUE(env.client.pos < strlen(resp));
+}
+
+void test_reason_names(void) {
+    TEST_ASSERT_EQUAL_STRING("ok", reasonName(Reason::OK));
+    TEST_ASSERT_EQUAL_STRING("latency", reasonName(Reason::LATENCY));
+    TEST_ASSERT_EQUAL_STRING("unknown", reasonName(Reason::COUNT));
+    TEST_ASSERT_EQUAL_STRING("too_long", errorName(Error::TOO_LONG));
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    env = FakeEnv();
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Compiling
+    RUN_TEST(test_compile_full_rule_line);
+    RUN_TEST(test_compile_empty_is_default);
+    RUN_TEST(test_compile_errors);
+
+    // Evaluating
+    RUN_TEST(test_default_rules_match_old_behaviour);
+    RUN_TEST(test_status_set_makes_404_an_outage);
+    RUN_TEST(test_header_presence_any_case);
+    RUN_TEST(test_body_patterns_across_reads);
+    RUN_TEST(test_body_pattern_in_chunked_response);
+    RUN_TEST(test_body_limit);
+    RUN_TEST(test_overlapping_pattern);
+    RUN_TEST(test_latency_limit);
+    RUN_TEST(test_json_fields);
+    RUN_TEST(test_json_in_chunked_response);
+    RUN_TEST(test_compile_json_clauses);
+    RUN_TEST(test_failed_status_body_not_read);
+    RUN_TEST(test_reading_stops_once_decided);
+    RUN_TEST(test_reason_names);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
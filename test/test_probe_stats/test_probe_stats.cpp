@@ -0,0 +1,128 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_probe_stats.cpp
+ * 
+ * Tests for probe counters, failure classes and latency histogram
+ * (include/probe_stats.h)
+ * 
+ * Run with: pio test -e native -f test_probe_stats
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include "probe_stats.h"
+
+static ProbeStats<4> stats;
+
+// ============== Tests: Failure Classes ==============
+
+void test_classify_connection_errors(void) {
+    TEST_ASSERT_EQUAL(FailureClass::CONNECT, classifyFailure(HttpProbe::ERR_CONNECTION_FAILED));
+    TEST_ASSERT_EQUAL(FailureClass::TIMEOUT, classifyFailure(HttpProbe::ERR_READ_TIMEOUT));
+    TEST_ASSERT_EQUAL(FailureClass::PROTOCOL, classifyFailure(HttpProbe::ERR_NO_HTTP_SERVER));
+    TEST_ASSERT_EQUAL(FailureClass::PROTOCOL, classifyFailure(HttpProbe::ERR_CONNECTION_LOST));
+}
+
+void test_classify_server_errors(void) {
+    TEST_ASSERT_EQUAL(FailureClass::HTTP_5XX, classifyFailure(503));
+    TEST_ASSERT_EQUAL(FailureClass::OTHER, classifyFailure(HttpProbe::ERR_BAD_URL));
+}
+
+void test_failure_class_names(void) {
+    TEST_ASSERT_EQUAL_STRING("timeout", failureClassName(FailureClass::TIMEOUT));
+    TEST_ASSERT_EQUAL_STRING("http_5xx", failureClassName(FailureClass::HTTP_5XX));
+}
+
+// ============== Tests: Counters ==============
+
+void test_counts_checks_and_failures(void) {
+    stats.record(200, true, 120);
+    stats.record(503, false, 80);
+    stats.record(HttpProbe::ERR_READ_TIMEOUT, false, 5000);
+    TEST_ASSERT_EQUAL_UINT32(3, stats.checks());
+    TEST_ASSERT_EQUAL_UINT32(2, stats.failures());
+    TEST_ASSERT_EQUAL_UINT32(1, stats.failures(FailureClass::HTTP_5XX));
+    TEST_ASSERT_EQUAL_UINT32(1, stats.failures(FailureClass::TIMEOUT));
+    TEST_ASSERT_EQUAL_UINT32(0, stats.failures(FailureClass::CONNECT));
+    TEST_ASSERT_EQUAL_INT(HttpProbe::ERR_READ_TIMEOUT, stats.lastCode());
+}
+
+// ============== Tests: Histogram ==============
+
+void test_histogram_is_cumulative(void) {
+    stats.record(200, true, 50);     // <= 100
+    stats.record(200, true, 100);    // <= 100 (bounds are inclusive)
+    stats.record(200, true, 300);    // <= 500
+    stats.record(200, true, 9000);   // +Inf
+    TEST_ASSERT_EQUAL_UINT32(2, stats.bucketCumulative(0));
+    TEST_ASSERT_EQUAL_UINT32(2, stats.bucketCumulative(1));
+    TEST_ASSERT_EQUAL_UINT32(3, stats.bucketCumulative(2));
+    TEST_ASSERT_EQUAL_UINT32(3, stats.bucketCumulative(LATENCY_BUCKET_COUNT - 1));
+    TEST_ASSERT_EQUAL_UINT32(4, stats.bucketCumulative(LATENCY_BUCKET_COUNT));
+}
+
+void test_latency_sum(void) {
+    stats.record(200, true, 1500);
+    stats.record(200, true, 2500);
+    TEST_ASSERT_EQUAL_UINT64(4000, stats.latencySumMs());
+}
+
+// ============== Tests: Recent Latencies ==============
+
+void test_recent_latencies_in_order(void) {
+    for (uint32_t i = 1; i <= 6; i++) stats.record(200, true, i * 10);
+    TEST_ASSERT_EQUAL_UINT32(4, stats.count());
+    TEST_ASSERT_EQUAL_UINT32(30, stats.latency(0));
+    TEST_ASSERT_EQUAL_UINT32(60, stats.latency(3));
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    stats = ProbeStats<4>();
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+    
+    // Failure classes
+    RUN_TEST(test_classify_connection_errors);
+    RUN_TEST(test_classify_server_errors);
+    RUN_TEST(test_failure_class_names);
+    
+    // Counters
+    RUN_TEST(test_counts_checks_and_failures);
+    
+    // Histogram
+    RUN_TEST(test_histogram_is_cumulative);
+    RUN_TEST(test_latency_sum);
+    
+    // Recent latencies
+    RUN_TEST(test_recent_latencies_in_order);
+    
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,116 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_prom_text.cpp
+ * 
+ * Tests for the Prometheus text writer (include/prom_text.h)
+ * 
+ * Run with: pio test -e native -f test_prom_text
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "prom_text.h"
+
+static char buf[512];
+
+// ============== Tests: Lines ==============
+
+void test_family_header(void) {
+    PromText out(buf, sizeof(buf));
+    out.family("x_total", "counter", "Things");
+    TEST_ASSERT_EQUAL_STRING("# HELP x_total Things\n# TYPE x_total counter\n", buf);
+}
+
+void test_unsigned_and_signed_samples(void) {
+    PromText out(buf, sizeof(buf));
+    out.sample("a", static_cast<uint32_t>(4000000000u));
+    out.sample("b", static_cast<int32_t>(-67));
+    TEST_ASSERT_EQUAL_STRING("a 4000000000\nb -67\n", buf);
+}
+
+void test_labelled_sample(void) {
+    PromText out(buf, sizeof(buf));
+    out.sample("f_total", "class", "timeout", 3);
+    TEST_ASSERT_EQUAL_STRING("f_total{class=\"timeout\"} 3\n", buf);
+}
+
+void test_seconds_from_ms(void) {
+    PromText out(buf, sizeof(buf));
+    out.sampleSeconds("s", 12345);
+    out.sampleSeconds("t", 7);
+    TEST_ASSERT_EQUAL_STRING("s 12.345\nt 0.007\n", buf);
+}
+
+void test_buckets(void) {
+    PromText out(buf, sizeof(buf));
+    out.bucket("h", 250, 2);
+    out.bucket("h", UINT32_MAX, 5);
+    TEST_ASSERT_EQUAL_STRING("h_bucket{le=\"0.250\"} 2\nh_bucket{le=\"+Inf\"} 5\n", buf);
+}
+
+// ============== Tests: Overflow ==============
+
+void test_overflow_drops_partial_line(void) {
+    char small[16];
+    PromText out(small, sizeof(small));
+    out.sample("abc", static_cast<uint32_t>(1));      // "abc 1\n" = 6
+    out.sample("defghijk", static_cast<uint32_t>(2)); // Would not fit
+    TEST_ASSERT_TRUE(out.overflowed());
+    TEST_ASSERT_EQUAL_STRING("abc 1\n", small);
+    TEST_ASSERT_EQUAL_UINT32(6, out.length());
+}
+
+void test_length_tracks_output(void) {
+    PromText out(buf, sizeof(buf));
+    out.sample("x", static_cast<uint32_t>(10));
+    TEST_ASSERT_EQUAL_UINT32(strlen(buf), out.length());
+    TEST_ASSERT_FALSE(out.overflowed());
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    memset(buf, 0, sizeof(buf));
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+    
+    // Lines
+    RUN_TEST(test_family_header);
+    RUN_TEST(test_unsigned_and_signed_samples);
+    RUN_TEST(test_labelled_sample);
+    RUN_TEST(test_seconds_from_ms);
+    RUN_TEST(test_buckets);
+    
+    // Overflow
+    RUN_TEST(test_overflow_drops_partial_line);
+    RUN_TEST(test_length_tracks_output);
+    
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
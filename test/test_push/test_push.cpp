@@ -0,0 +1,194 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_push.cpp
+ *
+ * Tests for SipHash-2-4 and signed status pushes
+ * (include/siphash.h, include/push_message.h), including replay
+ * protection across a restart via the RTC post-mortem record
+ *
+ * MACs below were computed with key 000102...0f.
+ *
+ * Run with: pio test -e native -f test_push
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "siphash.h"
+#include "push_message.h"
+#include "postmortem.h"
+
+static const char KEY[] = "000102030405060708090a0b0c0d0e0f";
+static Push::Verifier verifier;
+
+static Push::Result verify(const char* msg, Push::Status& s) {
+    return verifier.verify(msg, strlen(msg), s);
+}
+
+// ============== Tests: SipHash ==============
+
+void test_siphash_reference_vectors(void) {
+    uint8_t key[16], msg[15];
+    for (uint8_t i = 0; i < 16; i++) key[i] = i;
+    for (uint8_t i = 0; i < 15; i++) msg[i] = i;
+
+    // From the SipHash paper's vectors.h (64-bit output)
+    TEST_ASSERT_TRUE(SipHash::hash(key, msg, 0) == 0x726fdb47dd0e0e31ULL);
+    TEST_ASSERT_TRUE(SipHash::hash(key, msg, 8) == 0x93f5f5799a932462ULL);
+    TEST_ASSERT_TRUE(SipHash::hash(key, msg, 15) == 0xa129ca6149be45e5ULL);
+}
+
+// ============== Tests: Verification ==============
+
+void test_accepts_signed_push(void) {
+    Push::Status s;
+    TEST_ASSERT_EQUAL(Push::Result::OK, verify("v=1&seq=100&up=0&code=503&mac=26fa611680405976", s));
+    TEST_ASSERT_FALSE(s.up);
+    TEST_ASSERT_EQUAL_INT(503, s.code);
+    TEST_ASSERT_EQUAL_UINT32(100, s.seq);
+    TEST_ASSERT_EQUAL_UINT32(100, verifier.lastSeq());
+}
+
+void test_code_is_optional_and_may_be_negative(void) {
+    Push::Status s;
+    TEST_ASSERT_EQUAL(Push::Result::OK, verify("v=1&seq=101&up=1&mac=5db2850aa84376f0", s));
+    TEST_ASSERT_TRUE(s.up);
+    TEST_ASSERT_EQUAL_INT(0, s.code);
+    TEST_ASSERT_EQUAL(Push::Result::OK, verify("v=1&seq=102&up=0&code=-11&mac=abf839d02061e485", s));
+    TEST_ASSERT_EQUAL_INT(-11, s.code);
+}
+
+void test_mac_hex_case_and_trailing_newline(void) {
+    Push::Status s;
+    TEST_ASSERT_EQUAL(Push::Result::OK, verify("v=1&seq=101&up=1&mac=5DB2850AA84376F0\r\n", s));
+}
+
+void test_unknown_fields_ignored(void) {
+    Push::Status s;
+    TEST_ASSERT_EQUAL(Push::Result::OK, verify("v=1&seq=105&up=1&site=a&mac=ea42b80649a7da5b", s));
+}
+
+void test_rejects_tampered_push(void) {
+    Push::Status s;
+    TEST_ASSERT_EQUAL(Push::Result::BAD_MAC, verify("v=1&seq=100&up=1&code=503&mac=26fa611680405976", s));
+    TEST_ASSERT_EQUAL(Push::Result::BAD_MAC, verify("v=1&seq=100&up=0&code=503&mac=26fa611680405977", s));
+    TEST_ASSERT_EQUAL_UINT32(2, verifier.count(Push::Result::BAD_MAC));
+}
+
+void test_rejects_replay(void) {
+    Push::Status s;
+    TEST_ASSERT_EQUAL(Push::Result::OK, verify("v=1&seq=101&up=1&mac=5db2850aa84376f0", s));
+    TEST_ASSERT_EQUAL(Push::Result::REPLAY, verify("v=1&seq=101&up=1&mac=5db2850aa84376f0", s));
+    TEST_ASSERT_EQUAL(Push::Result::REPLAY, verify("v=1&seq=100&up=0&code=503&mac=26fa611680405976", s));
+    TEST_ASSERT_EQUAL(Push::Result::OK, verify("v=1&seq=102&up=0&code=-11&mac=abf839d02061e485", s));
+}
+
+// What acceptPush() and setupPostMortem()/setupPush() do around a reset
+void test_rejects_replay_after_restart(void) {
+    Push::Status s;
+    TEST_ASSERT_EQUAL(Push::Result::OK, verify("v=1&seq=101&up=1&mac=5db2850aa84376f0", s));
+
+    PostMortem::Record rtc = {};
+    rtc.pushSeq = s.seq;
+    rtc.flags  |= PostMortem::FLAG_PUSH_SEQ;
+    PostMortem::seal(rtc);
+    uint8_t memory[sizeof(rtc)];   // RTC user memory keeps the bytes
+    memcpy(memory, &rtc, sizeof(memory));
+
+    Push::Verifier rebooted;
+    TEST_ASSERT_TRUE(rebooted.begin(KEY));
+    PostMortem::Record previous;
+    memcpy(&previous, memory, sizeof(previous));
+    TEST_ASSERT_TRUE(PostMortem::isValid(previous));
+    TEST_ASSERT_TRUE(previous.flags & PostMortem::FLAG_PUSH_SEQ);
+    rebooted.restore(previous.pushSeq);
+
+    const char* old1 = "v=1&seq=100&up=0&code=503&mac=26fa611680405976";
+    const char* old2 = "v=1&seq=101&up=1&mac=5db2850aa84376f0";
+    const char* next = "v=1&seq=102&up=0&code=-11&mac=abf839d02061e485";
+    TEST_ASSERT_EQUAL(Push::Result::REPLAY, rebooted.verify(old1, strlen(old1), s));
+    TEST_ASSERT_EQUAL(Push::Result::REPLAY, rebooted.verify(old2, strlen(old2), s));
+    TEST_ASSERT_EQUAL(Push::Result::OK, rebooted.verify(next, strlen(next), s));
+    TEST_ASSERT_EQUAL_UINT32(102, rebooted.lastSeq());
+}
+
+void test_fresh_verifier_has_no_seq(void) {
+    // Power-on: no record, so the first signed push sets the floor
+    Push::Status s;
+    TEST_ASSERT_FALSE(verifier.haveSeq());
+    TEST_ASSERT_EQUAL(Push::Result::OK, verify("v=1&seq=100&up=0&code=503&mac=26fa611680405976", s));
+    TEST_ASSERT_TRUE(verifier.haveSeq());
+}
+
+void test_rejects_malformed(void) {
+    Push::Status s;
+    // Correctly signed but wrong version / missing field
+    TEST_ASSERT_EQUAL(Push::Result::MALFORMED, verify("v=2&seq=103&up=1&mac=1e7eea6978dcc31a", s));
+    TEST_ASSERT_EQUAL(Push::Result::MALFORMED, verify("v=1&seq=104&mac=653e5fa22fbcd1e1", s));
+    // No or short MAC
+    TEST_ASSERT_EQUAL(Push::Result::MALFORMED, verify("v=1&seq=101&up=1", s));
+    TEST_ASSERT_EQUAL(Push::Result::MALFORMED, verify("v=1&seq=101&up=1&mac=5db2850a", s));
+    TEST_ASSERT_EQUAL(Push::Result::MALFORMED, verify("", s));
+}
+
+void test_rejects_everything_without_valid_key(void) {
+    Push::Verifier unkeyed;
+    Push::Status s;
+    const char* msg = "v=1&seq=101&up=1&mac=5db2850aa84376f0";
+    TEST_ASSERT_FALSE(unkeyed.begin("0001"));
+    TEST_ASSERT_EQUAL(Push::Result::MALFORMED, unkeyed.verify(msg, strlen(msg), s));
+    TEST_ASSERT_FALSE(unkeyed.begin("zz0102030405060708090a0b0c0d0e0f"));
+    TEST_ASSERT_EQUAL(Push::Result::MALFORMED, unkeyed.verify(msg, strlen(msg), s));
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    verifier = Push::Verifier();
+    verifier.begin(KEY);
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // SipHash
+    RUN_TEST(test_siphash_reference_vectors);
+
+    // Verification
+    RUN_TEST(test_accepts_signed_push);
+    RUN_TEST(test_code_is_optional_and_may_be_negative);
+    RUN_TEST(test_mac_hex_case_and_trailing_newline);
+    RUN_TEST(test_unknown_fields_ignored);
+    RUN_TEST(test_rejects_tampered_push);
+    RUN_TEST(test_rejects_replay);
+    RUN_TEST(test_rejects_replay_after_restart);
+    RUN_TEST(test_fresh_verifier_has_no_seq);
+    RUN_TEST(test_rejects_malformed);
+    RUN_TEST(test_rejects_everything_without_valid_key);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,375 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_redirect_cache.cpp
+ *
+ * Tests for the redirect shortcut cache (include/redirect_cache.h),
+ * against the scripted stand-in site of test_fake_site: remembering
+ * where a chain ends, direct checks, periodic revalidation, falling back
+ * to the chain when the shortcut fails, per-target entries and the hop
+ * and time-saved counters. Timings come from the virtual clock and are
+ * exact.
+ *
+ * Run with: pio test -e native -f test_redirect_cache
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include <new>
+#include "http_probe.h"
+#include "probe_rules.h"
+#include "redirect_cache.h"
+#include "../test_fake_site/fake_site.h"
+
+using namespace HttpProbe;
+using FakeSite::Scheme;
+
+constexpr uint32_t TIMEOUT    = 10000;
+constexpr uint32_t REVALIDATE = 60000;
+constexpr char     ORIGIN[]   = "http://example.com/health";
+
+typedef RedirectCache::Cache<2> Cache;
+
+static FakeSite::Site*   site  = nullptr;
+static FakeSite::Env*    env   = nullptr;
+static Cache*            cache = nullptr;
+static ProbeArena        arena;
+static ProbeRules::Table rules;
+
+static const char HEALTH[] =
+    "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 15\r\n\r\n"
+    "{\"status\":\"ok\"}";
+static const char UNAVAILABLE[] =
+    "HTTP/1.1 503 Service Unavailable\r\nContent-Length: 0\r\n\r\n";
+static const char TO_HTTPS[] =
+    "HTTP/1.1 301 Moved Permanently\r\nLocation: https://example.com/health\r\nContent-Length: 0\r\n\r\n";
+static const char TO_WWW[] =
+    "HTTP/1.1 302 Found\r\nLocation: https://www.example.com/health\r\nContent-Length: 0\r\n\r\n";
+static const char TO_WWW2[] =
+    "HTTP/1.1 302 Found\r\nLocation: https://www2.example.com/health\r\nContent-Length: 0\r\n\r\n";
+static const char TO_V2[] =
+    "HTTP/1.1 308 Permanent Redirect\r\nLocation: /v2/health\r\nContent-Length: 0\r\n\r\n";
+static const char TO_FINAL[] =
+    "HTTP/1.1 301 Moved Permanently\r\nLocation: /final\r\nContent-Length: 0\r\n\r\n";
+
+// Chain costs with the default host (TCP 20, TLS 400, resumed 80):
+// http hop 20+10, https hop 20+400+10, then www 20+400+100
+constexpr uint32_t CHAIN_HOP_MS = (20 + 10) + (20 + 400 + 10);
+constexpr uint32_t CHAIN_MS     = CHAIN_HOP_MS + 20 + 400 + 100;
+constexpr uint32_t DIRECT_MS    = 20 + 80 + 100;   // Session to www resumed
+
+struct Outcome {
+    int                code;
+    uint8_t            redirects;
+    uint32_t           latencyMs;   // Virtual, whole check
+    uint32_t           finalMs;     // The final request alone, as judged
+    ProbeRules::Reason verdict;
+};
+
+// ============== Helpers ==============
+
+// http -> https -> www, as in test_fake_site
+static void chain() {
+    site->route("example.com", "/health", {TO_HTTPS, 10}, 0, Scheme::HTTP);
+    site->route("example.com", "/health", {TO_WWW, 10}, 0, Scheme::HTTPS);
+    site->route("www.example.com", "/health", {HEALTH, 100});
+}
+
+// One check, as checkSiteStatus() does it
+static Outcome check(const char* url = ORIGIN) {
+    ProbeRules::Evaluator eval(rules);
+    uint32_t start = env->now();
+    ProbeResult r = cache->probe(url, arena, TIMEOUT, *env, eval);
+    uint32_t latency = env->now() - start;
+    uint32_t final   = latency - r.redirectMs;
+    return {r.code, r.redirects, latency, final, eval.verdict(r.code, final)};
+}
+
+// ============== Tests: Remembering ==============
+
+void test_chain_end_is_remembered(void) {
+    chain();
+
+    Outcome o = check();
+    TEST_ASSERT_EQUAL_INT(200, o.code);
+    TEST_ASSERT_EQUAL_UINT8(2, o.redirects);
+    TEST_ASSERT_EQUAL_UINT32(CHAIN_MS, o.latencyMs);
+    TEST_ASSERT_FALSE(cache->lastDirect());
+
+    const Cache::Entry* e = cache->entry(ORIGIN);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_STRING("www.example.com", e->url.host);
+    TEST_ASSERT_EQUAL_STRING("/health", e->url.path);
+    TEST_ASSERT_TRUE(e->url.https);
+    TEST_ASSERT_EQUAL_UINT8(2, e->hops);
+    TEST_ASSERT_EQUAL_UINT32(CHAIN_HOP_MS, e->hopMs);
+
+    TEST_ASSERT_EQUAL_UINT32(1, cache->stats().chains);
+    TEST_ASSERT_EQUAL_UINT32(2, cache->stats().hopsFollowed);
+    TEST_ASSERT_EQUAL_UINT32(0, cache->stats().direct);
+}
+
+void test_no_redirect_nothing_remembered(void) {
+    site->route("example.com", "/health", {HEALTH, 50});
+
+    check();
+    check();
+    TEST_ASSERT_NULL(cache->entry(ORIGIN));
+    TEST_ASSERT_EQUAL_UINT32(2, cache->stats().chains);
+    TEST_ASSERT_EQUAL_UINT32(0, cache->stats().hopsFollowed);
+}
+
+void test_chain_to_error_not_remembered(void) {
+    site->route("example.com", "/health", {TO_HTTPS, 10}, 0, Scheme::HTTP);
+    site->route("example.com", "/health", {UNAVAILABLE, 10}, 0, Scheme::HTTPS);
+
+    TEST_ASSERT_EQUAL_INT(503, check().code);
+    TEST_ASSERT_NULL(cache->entry(ORIGIN));
+    TEST_ASSERT_EQUAL_UINT32(1, cache->stats().hopsFollowed);
+}
+
+// ============== Tests: Direct Checks ==============
+
+void test_next_check_goes_direct(void) {
+    chain();
+    check();
+
+    Outcome o = check();
+    TEST_ASSERT_EQUAL_INT(200, o.code);
+    TEST_ASSERT_EQUAL_UINT8(0, o.redirects);
+    TEST_ASSERT_EQUAL_UINT32(DIRECT_MS, o.latencyMs);
+    TEST_ASSERT_TRUE(cache->lastDirect());
+
+    TEST_ASSERT_EQUAL_UINT32(4, site->requests());
+    TEST_ASSERT_EQUAL_STRING("www.example.com", site->request(3).host);
+    TEST_ASSERT_EQUAL_UINT32(1, site->resumptions);
+
+    const RedirectCache::Stats& s = cache->stats();
+    TEST_ASSERT_EQUAL_UINT32(1, s.direct);
+    TEST_ASSERT_EQUAL_UINT32(2, s.hopsSkipped);
+    TEST_ASSERT_EQUAL_UINT32(CHAIN_HOP_MS, s.savedMs);
+}
+
+void test_savings_add_up(void) {
+    chain();
+    for (int i = 0; i < 10; i++) check();
+
+    const RedirectCache::Stats& s = cache->stats();
+    TEST_ASSERT_EQUAL_UINT32(1, s.chains);
+    TEST_ASSERT_EQUAL_UINT32(9, s.direct);
+    TEST_ASSERT_EQUAL_UINT32(2, s.hopsFollowed);
+    TEST_ASSERT_EQUAL_UINT32(18, s.hopsSkipped);
+    TEST_ASSERT_EQUAL_UINT32(9 * CHAIN_HOP_MS, s.savedMs);
+    TEST_ASSERT_EQUAL_UINT32(3 + 9, site->requests());
+    TEST_ASSERT_EQUAL_UINT32(CHAIN_MS + 9 * DIRECT_MS, env->clock);
+}
+
+void test_rules_judge_the_direct_response(void) {
+    TEST_ASSERT_EQUAL(ProbeRules::Error::NONE,
+                      ProbeRules::compile("status=200; json.status=ok; latency<500", rules));
+    chain();
+
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::LATENCY, check().verdict);   // Full handshake to www
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, check().verdict);
+}
+
+void test_latency_rule_ignores_revalidation_hops(void) {
+    // Direct checks take 200 ms; the hourly walk adds two hops and, with
+    // the session moved to the apex, a full handshake to www
+    TEST_ASSERT_EQUAL(ProbeRules::Error::NONE, ProbeRules::compile("latency<600", rules));
+    chain();
+    check();
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, check().verdict);
+
+    env->clock += REVALIDATE;
+    Outcome o = check();
+    TEST_ASSERT_FALSE(cache->lastDirect());
+    TEST_ASSERT_EQUAL_UINT8(2, o.redirects);
+    TEST_ASSERT_EQUAL_UINT32(CHAIN_MS, o.latencyMs);
+    TEST_ASSERT_EQUAL_UINT32(20 + 400 + 100, o.finalMs);
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::OK, o.verdict);
+}
+
+void test_moved_final_url_is_updated(void) {
+    // www answers once, then moves the page to /v2
+    site->route("example.com", "/health", {TO_HTTPS, 10}, 0, Scheme::HTTP);
+    site->route("example.com", "/health", {TO_WWW, 10}, 0, Scheme::HTTPS);
+    site->route("www.example.com", "/health", {HEALTH, 100}, 1);
+    site->route("www.example.com", "/health", {TO_V2, 10});
+    site->route("www.example.com", "/v2/health", {HEALTH, 100});
+
+    check();
+    Outcome o = check();
+    TEST_ASSERT_EQUAL_INT(200, o.code);
+    TEST_ASSERT_EQUAL_UINT8(1, o.redirects);
+    TEST_ASSERT_TRUE(cache->lastDirect());
+
+    const Cache::Entry* e = cache->entry(ORIGIN);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_STRING("/v2/health", e->url.path);
+    TEST_ASSERT_EQUAL_UINT8(3, e->hops);
+
+    check();
+    TEST_ASSERT_EQUAL_STRING("/v2/health", site->request(site->requests() - 1).path);
+}
+
+// ============== Tests: Revalidation and Failures ==============
+
+void test_chain_walked_again_after_period(void) {
+    chain();
+    check();
+    check();
+    uint32_t learnedAt = cache->entry(ORIGIN)->learnedAt;
+
+    env->clock += REVALIDATE;
+    Outcome o = check();
+    TEST_ASSERT_EQUAL_UINT8(2, o.redirects);
+    TEST_ASSERT_FALSE(cache->lastDirect());
+    TEST_ASSERT_EQUAL_UINT32(1, cache->stats().revalidations);
+    TEST_ASSERT_EQUAL_UINT32(2, cache->stats().chains);
+    TEST_ASSERT_TRUE(cache->entry(ORIGIN)->learnedAt > learnedAt);
+
+    TEST_ASSERT_EQUAL_UINT8(0, check().redirects);
+    TEST_ASSERT_TRUE(cache->lastDirect());
+}
+
+void test_revalidation_drops_vanished_redirects(void) {
+    site->route("example.com", "/health", {TO_HTTPS, 10}, 1, Scheme::HTTP);
+    site->route("example.com", "/health", {TO_WWW, 10}, 1, Scheme::HTTPS);
+    site->route(nullptr, "/health", {HEALTH, 100});
+    check();
+    TEST_ASSERT_NOT_NULL(cache->entry(ORIGIN));
+
+    env->clock += REVALIDATE;
+    Outcome o = check();
+    TEST_ASSERT_EQUAL_INT(200, o.code);
+    TEST_ASSERT_EQUAL_UINT8(0, o.redirects);
+    TEST_ASSERT_NULL(cache->entry(ORIGIN));
+    TEST_ASSERT_EQUAL_UINT32(1, cache->stats().dropped);
+
+    check();
+    TEST_ASSERT_EQUAL_STRING("example.com", site->request(site->requests() - 1).host);
+}
+
+void test_failed_shortcut_falls_back_to_chain(void) {
+    // www answers once, then 404s; the chain now ends at www2
+    site->route("example.com", "/health", {TO_HTTPS, 10}, 0, Scheme::HTTP);
+    site->route("example.com", "/health", {TO_WWW, 10}, 1, Scheme::HTTPS);
+    site->route("example.com", "/health", {TO_WWW2, 10}, 0, Scheme::HTTPS);
+    site->route("www.example.com", "/health", {HEALTH, 100}, 1);
+    site->route("www2.example.com", "/health", {HEALTH, 100});
+    check();
+
+    Outcome o = check();
+    TEST_ASSERT_EQUAL_INT(200, o.code);   // The stale shortcut does not decide the check
+    TEST_ASSERT_EQUAL_UINT8(2, o.redirects);
+    TEST_ASSERT_EQUAL_UINT32(20 + 400 + 100, o.finalMs);   // Neither the 404 nor the hops
+    TEST_ASSERT_FALSE(cache->lastDirect());
+    TEST_ASSERT_EQUAL_UINT32(3 + 1 + 3, site->requests());
+
+    const Cache::Entry* e = cache->entry(ORIGIN);
+    TEST_ASSERT_NOT_NULL(e);
+    TEST_ASSERT_EQUAL_STRING("www2.example.com", e->url.host);
+    TEST_ASSERT_EQUAL_UINT32(1, cache->stats().dropped);
+    TEST_ASSERT_EQUAL_UINT32(0, cache->stats().direct);
+}
+
+void test_site_down_forgets_shortcut(void) {
+    site->route("example.com", "/health", {TO_HTTPS, 10}, 1, Scheme::HTTP);
+    site->route("example.com", "/health", {TO_WWW, 10}, 1, Scheme::HTTPS);
+    site->route("www.example.com", "/health", {HEALTH, 100}, 1);
+    site->route(nullptr, nullptr, {UNAVAILABLE, 10});
+    check();
+
+    Outcome o = check();
+    TEST_ASSERT_EQUAL_INT(503, o.code);
+    TEST_ASSERT_EQUAL(ProbeRules::Reason::STATUS, o.verdict);
+    TEST_ASSERT_NULL(cache->entry(ORIGIN));
+    TEST_ASSERT_EQUAL_STRING("example.com", site->request(site->requests() - 1).host);
+}
+
+// ============== Tests: Targets ==============
+
+void test_targets_kept_apart_least_recent_replaced(void) {
+    site->route(nullptr, "/", {TO_FINAL, 10}, 0, Scheme::HTTP);
+    site->route(nullptr, "/final", {HEALTH, 50}, 0, Scheme::HTTP);
+    const char* a = "http://a.example.com/";
+    const char* b = "http://b.example.com/";
+    const char* c = "http://c.example.com/";
+
+    check(a);
+    check(b);
+    TEST_ASSERT_NOT_NULL(cache->entry(a));
+    TEST_ASSERT_NOT_NULL(cache->entry(b));
+    TEST_ASSERT_EQUAL_STRING("b.example.com", cache->entry(b)->url.host);
+
+    check(a);   // a is now the most recently used
+    TEST_ASSERT_TRUE(cache->lastDirect());
+    check(c);
+    TEST_ASSERT_NOT_NULL(cache->entry(a));
+    TEST_ASSERT_NULL(cache->entry(b));
+    TEST_ASSERT_NOT_NULL(cache->entry(c));
+    TEST_ASSERT_EQUAL_STRING("/final", cache->entry(c)->url.path);
+}
+
+void setUp(void) {
+    // Fresh site, shim and cache per test, built in place
+    static FakeSite::Site siteStorage;
+    alignas(FakeSite::Env) static uint8_t envStorage[sizeof(FakeSite::Env)];
+    alignas(Cache) static uint8_t cacheStorage[sizeof(Cache)];
+    site  = new (&siteStorage) FakeSite::Site();
+    env   = new (envStorage) FakeSite::Env(*site);
+    cache = new (cacheStorage) Cache(REVALIDATE);
+    ProbeRules::compile("", rules);
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Remembering
+    RUN_TEST(test_chain_end_is_remembered);
+    RUN_TEST(test_no_redirect_nothing_remembered);
+    RUN_TEST(test_chain_to_error_not_remembered);
+
+    // Direct checks
+    RUN_TEST(test_next_check_goes_direct);
+    RUN_TEST(test_savings_add_up);
+    RUN_TEST(test_rules_judge_the_direct_response);
+    RUN_TEST(test_latency_rule_ignores_revalidation_hops);
+    RUN_TEST(test_moved_final_url_is_updated);
+
+    // Revalidation and failures
+    RUN_TEST(test_chain_walked_again_after_period);
+    RUN_TEST(test_revalidation_drops_vanished_redirects);
+    RUN_TEST(test_failed_shortcut_falls_back_to_chain);
+    RUN_TEST(test_site_down_forgets_shortcut);
+
+    // Targets
+    RUN_TEST(test_targets_kept_apart_least_recent_replaced);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,143 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_request_line.cpp
+ * 
+ * Tests for the incremental HTTP request line reader (include/request_line.h)
+ * 
+ * Run with: pio test -e native -f test_request_line
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "request_line.h"
+
+static RequestLine req;
+
+static void feedAll(const char* text) {
+    while (*text && req.feed(*text)) text++;
+}
+
+// ============== Tests: Request Line ==============
+
+void test_simple_get(void) {
+    feedAll("GET /status HTTP/1.1\r\nHost: panel\r\n\r\n");
+    TEST_ASSERT_TRUE(req.done());
+    TEST_ASSERT_EQUAL_STRING("GET", req.method());
+    TEST_ASSERT_EQUAL_STRING("/status", req.path());
+    TEST_ASSERT_TRUE(req.isPath("/status"));
+}
+
+void test_query_is_split(void) {
+    feedAll("GET /metrics?x=1 HTTP/1.0\r\n\r\n");
+    TEST_ASSERT_TRUE(req.done());
+    TEST_ASSERT_EQUAL_STRING("/metrics", req.path());
+    TEST_ASSERT_EQUAL_STRING("x=1", req.query());
+}
+
+void test_bare_newlines_accepted(void) {
+    feedAll("GET / HTTP/1.1\nHost: x\n\n");
+    TEST_ASSERT_TRUE(req.done());
+}
+
+void test_incomplete_head_not_done(void) {
+    feedAll("GET / HTTP/1.1\r\nHost: x\r\n");
+    TEST_ASSERT_FALSE(req.done());
+    TEST_ASSERT_FALSE(req.failed());
+}
+
+void test_byte_at_a_time_matches(void) {
+    const char* text = "POST /push HTTP/1.1\r\n\r\n";
+    for (size_t i = 0; i < strlen(text); i++) req.feed(text[i]);
+    TEST_ASSERT_TRUE(req.done());
+    TEST_ASSERT_TRUE(req.isMethod("POST"));
+}
+
+void test_content_length_header(void) {
+    feedAll("POST /push HTTP/1.1\r\nHost: x\r\ncontent-LENGTH:  42\r\n\r\n");
+    TEST_ASSERT_TRUE(req.done());
+    TEST_ASSERT_EQUAL_INT32(42, req.contentLength());
+}
+
+void test_content_length_absent(void) {
+    feedAll("POST /push HTTP/1.1\r\nContent-Type: text/plain\r\n\r\n");
+    TEST_ASSERT_TRUE(req.done());
+    TEST_ASSERT_EQUAL_INT32(-1, req.contentLength());
+}
+
+// ============== Tests: Failures ==============
+
+void test_missing_version_fails(void) {
+    feedAll("GET /\r\n\r\n");
+    TEST_ASSERT_TRUE(req.failed());
+}
+
+void test_not_http_fails(void) {
+    feedAll("HELLO WORLD\r\n");
+    TEST_ASSERT_TRUE(req.failed());
+}
+
+void test_overlong_target_fails(void) {
+    char line[256];
+    memset(line, 'a', sizeof(line));
+    memcpy(line, "GET /", 5);
+    line[sizeof(line) - 1] = '\0';
+    feedAll(line);
+    TEST_ASSERT_TRUE(req.failed());
+}
+
+void test_overlong_method_fails(void) {
+    feedAll("VERYLONGMETHOD / HTTP/1.1\r\n\r\n");
+    TEST_ASSERT_TRUE(req.failed());
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    req.reset();
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+    
+    // Request line
+    RUN_TEST(test_simple_get);
+    RUN_TEST(test_query_is_split);
+    RUN_TEST(test_bare_newlines_accepted);
+    RUN_TEST(test_incomplete_head_not_done);
+    RUN_TEST(test_byte_at_a_time_matches);
+    RUN_TEST(test_content_length_header);
+    RUN_TEST(test_content_length_absent);
+    
+    // Failures
+    RUN_TEST(test_missing_version_fails);
+    RUN_TEST(test_not_http_fails);
+    RUN_TEST(test_overlong_target_fails);
+    RUN_TEST(test_overlong_method_fails);
+    
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,580 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_simulation.cpp
+ *
+ * Discrete-event simulation of the firmware loop (include/monitor.h)
+ *
+ * A virtual clock jumps from one event to the next: check due, scripted
+ * site outage or recovery, WiFi drop, button press. Each wakeup runs the
+ * same steps as loop() in the same order, with the real Monitor and
+ * LatencyEwma (and the prober Election, for a board whose beacon
+ * group join may never succeed), and a FakeIo records the panel and buzzer timeline so the
+ * tests can assert when alerts start and stop. Weeks of simulated time
+ * run in well under a second.
+ *
+ * Run with: pio test -e native -f test_simulation
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <new>
+#include "monitor.h"
+#include "latency_ewma.h"
+#include "fleet_table.h"
+#include "election.h"
+#include "bench_clock.h"
+
+// Firmware defaults (src/main.cpp, config.h.sample)
+constexpr uint32_t INTERVAL     = 60000;
+constexpr uint32_t RECONNECT    = 30000;
+constexpr uint32_t RECONNECT_MS = 5000;    // delay() after WiFi.reconnect()
+constexpr uint32_t DEBOUNCE     = 200;
+constexpr uint32_t BASE_LATENCY = 300;
+constexpr uint32_t LEASE        = 15000;   // ELECTION_LEASE
+constexpr uint32_t NEVER        = 0xFFFFFFFF;
+
+constexpr uint32_t SEC  = 1000;
+constexpr uint32_t MIN  = 60 * SEC;
+constexpr uint32_t HOUR = 60 * MIN;
+constexpr uint32_t DAY  = 24 * HOUR;
+
+// ============== Fake Panel and Buzzer ==============
+
+enum class Kind : uint8_t { SHOW, ALARM_ON, ALARM_OFF, CHIRP, BEEP };
+
+struct Mark {
+    uint32_t at;       // Simulated ms since start
+    Kind     kind;
+    Screen   screen;   // SHOW only
+};
+
+struct FakeIo {
+    static constexpr size_t TIMELINE_MAX = 1024;
+
+    const uint32_t* clock = nullptr;
+    Mark     timeline[TIMELINE_MAX];
+    size_t   marks    = 0;          // Recorded; later marks only count
+    bool     alarmOn  = false;
+    Screen   screen   = Screen::SITE_UP;
+    uint32_t shows    = 0;
+    uint32_t alarms   = 0;          // Off -> on edges
+    uint32_t chirps   = 0;
+    uint32_t beeps    = 0;
+
+    void record(Kind kind, Screen s = Screen::SITE_UP) {
+        if (marks < TIMELINE_MAX) timeline[marks++] = {*clock, kind, s};
+    }
+
+    // Every check shows its result; only a change of status screen is recorded
+    void show(Screen s) {
+        bool status = s == Screen::SITE_UP || s == Screen::SITE_DOWN || s == Screen::SITE_SLOW;
+        if (!status || s != screen || shows == 0) record(Kind::SHOW, s);
+        screen = s;
+        shows++;
+    }
+
+    void alarm(bool on) {
+        if (on == alarmOn) return;   // The buzzer keeps sounding (or stays quiet)
+        alarmOn = on;
+        if (on) alarms++;
+        record(on ? Kind::ALARM_ON : Kind::ALARM_OFF);
+    }
+
+    void chirp() { chirps++; record(Kind::CHIRP); }
+    void beep()  { beeps++;  record(Kind::BEEP); }
+};
+
+// ============== Scenario ==============
+
+struct Window {
+    uint32_t start;
+    uint32_t end;      // Exclusive
+    uint32_t value;    // Outage: HTTP code (0 = no response); slow: latency
+};
+
+static bool inside(const Window* w, size_t n, uint32_t at, uint32_t* value = nullptr) {
+    for (size_t i = 0; i < n; i++) {
+        if (at >= w[i].start && at < w[i].end) {
+            if (value) *value = w[i].value;
+            return true;
+        }
+    }
+    return false;
+}
+
+// Next window edge after 'at', or NEVER
+static uint32_t nextEdge(const Window* w, size_t n, uint32_t at) {
+    uint32_t next = NEVER;
+    for (size_t i = 0; i < n; i++) {
+        if (w[i].start > at && w[i].start < next) next = w[i].start;
+        if (w[i].end   > at && w[i].end   < next) next = w[i].end;
+    }
+    return next;
+}
+
+static uint32_t rngState = 1;
+static uint32_t rng() {
+    rngState = rngState * 1664525u + 1013904223u;
+    return rngState >> 8;
+}
+
+// ============== Simulated Board ==============
+
+struct Sim {
+    static constexpr size_t WINDOW_MAX = 64;
+    static constexpr size_t PRESS_MAX  = 16;
+
+    // Script, in ms since start
+    Window   outages[WINDOW_MAX];
+    size_t   outageCount = 0;
+    Window   drops[WINDOW_MAX];      // WiFi link down
+    size_t   dropCount   = 0;
+    Window   slow[WINDOW_MAX];       // Latency while up
+    size_t   slowCount   = 0;
+    uint32_t presses[PRESS_MAX];     // Ascending
+    size_t   pressCount  = 0;
+
+    // Board
+    uint32_t         epoch = 0;      // millis() at start; near the wrap to test it
+    uint32_t         at    = 0;      // Simulated ms since start
+    FakeIo           io;
+    Monitor<FakeIo>  monitor{io, {5000, DEBOUNCE}};
+    LatencyEwma      ewma;
+    size_t           nextPress = 0;
+    uint32_t         checks    = 0;
+
+    // Beacon group; without a join the board has no fleet and probes alone
+    uint32_t         joinAt = NEVER; // Multicast join succeeds at this time
+    bool             joined = false;
+    FleetTable<4>    fleet;          // No peers are simulated
+    Election         election;
+
+    Sim() { io.clock = &at; }
+
+    void outage(uint32_t start, uint32_t len, uint32_t code = 503) {
+        outages[outageCount++] = {start, start + len, code};
+    }
+    void drop(uint32_t start, uint32_t len)               { drops[dropCount++] = {start, start + len, 0}; }
+    void slowFor(uint32_t start, uint32_t len, uint32_t ms) { slow[slowCount++] = {start, start + len, ms}; }
+    void press(uint32_t t)                                { presses[pressCount++] = t; }
+    void join(uint32_t t)                                 { joinAt = t; }
+
+    uint32_t millisNow() const { return epoch + at; }
+    bool     linkUp()    const { return !inside(drops, dropCount, at); }
+
+    void boot() {
+        monitor.begin(millisNow(), INTERVAL, linkUp());
+    }
+
+    /**
+     * One loop() pass: button, WiFi, the site check, then beacons
+     */
+    void pass() {
+        while (nextPress < pressCount && presses[nextPress] <= at) {
+            monitor.button(millisNow());
+            nextPress++;
+        }
+
+        if (monitor.wifi(millisNow(), linkUp(), RECONNECT) == Monitor<FakeIo>::WifiEvent::RECONNECT) {
+            at += RECONNECT_MS;   // WiFi.reconnect(); delay(5000)
+            if (linkUp()) monitor.reconnected();
+        }
+
+        if (monitor.checkDue(millisNow(), INTERVAL, election.shouldProbe(joined))) {
+            probe();
+        }
+
+        // handleBeacons(): join once, then listen a lease before claiming
+        if (!joined && at >= joinAt) {
+            joined = true;
+            election.begin(1, 1, LEASE, millisNow());
+        }
+        if (joined && election.update(fleet, millisNow()) && election.isLeader()) {
+            monitor.checkSoon(millisNow(), INTERVAL);
+        }
+    }
+
+    /**
+     * A blocking probe; the result lands when the response (or timeout) does
+     */
+    void probe() {
+        checks++;
+        uint32_t code;
+        bool up = !inside(outages, outageCount, at, &code);
+        uint32_t latency = BASE_LATENCY - 20 + rng() % 41;
+        uint32_t slowMs;
+        if (up && inside(slow, slowCount, at, &slowMs)) latency = slowMs;
+        if (!up && code == 0) latency = 10000;   // HTTP timeout
+
+        at += latency;
+        bool isSlow = up ? ewma.add(latency) : monitor.siteSlow();
+        monitor.result(up, isSlow);
+    }
+
+    /**
+     * Jump from event to event until 'until'
+     */
+    void runUntil(uint32_t until) {
+        while (at < until) {
+            pass();
+
+            // Next check, or poll each second while the link is down or a
+            // due check was not taken
+            uint32_t next = monitor.lastCheck() - epoch + INTERVAL;
+            if (!monitor.wifiConnected() || next <= at) next = at + SEC;
+            uint32_t edge = nextEdge(outages, outageCount, at);
+            if (edge < next) next = edge;
+            edge = nextEdge(drops, dropCount, at);
+            if (edge < next) next = edge;
+            if (joinAt > at && joinAt < next) next = joinAt;
+            if (joined && !election.isLeader() && at + SEC < next) next = at + SEC;
+            if (nextPress < pressCount && presses[nextPress] > at && presses[nextPress] < next) {
+                next = presses[nextPress];   // A press during a blocking step waits for the next pass
+            }
+            at = (next < until) ? next : until;
+        }
+    }
+
+    // ============== Timeline Queries ==============
+
+    // First mark of 'kind' (and screen, for SHOW) at or after 'from'; NEVER if none
+    uint32_t first(Kind kind, uint32_t from, Screen screen = Screen::SITE_UP) const {
+        for (size_t i = 0; i < io.marks; i++) {
+            const Mark& m = io.timeline[i];
+            if (m.at >= from && m.kind == kind && (kind != Kind::SHOW || m.screen == screen)) {
+                return m.at;
+            }
+        }
+        return NEVER;
+    }
+
+    size_t count(Kind kind, uint32_t from, uint32_t to, Screen screen = Screen::SITE_UP) const {
+        size_t n = 0;
+        for (size_t i = 0; i < io.marks; i++) {
+            const Mark& m = io.timeline[i];
+            if (m.at >= from && m.at < to && m.kind == kind && (kind != Kind::SHOW || m.screen == screen)) n++;
+        }
+        return n;
+    }
+};
+
+// One board at a time, rebuilt in place (too big for the ESP8266 stack)
+static Sim& fresh() {
+    static Sim storage;
+    storage.~Sim();
+    return *new (&storage) Sim();
+}
+
+// ============== Tests: Checks and Outages ==============
+
+void test_first_check_after_boot(void) {
+    Sim& s = fresh();
+    s.boot();
+    s.runUntil(3 * MIN);
+
+    uint32_t shown = s.first(Kind::SHOW, 0, Screen::SITE_UP);
+    TEST_ASSERT_UINT32_WITHIN(BASE_LATENCY, 5000 + BASE_LATENCY, shown);
+    TEST_ASSERT_EQUAL_UINT32(3, s.checks);   // 5s, 65s, 125s
+    TEST_ASSERT_EQUAL_UINT32(0, s.io.alarms);
+    TEST_ASSERT_TRUE(s.monitor.statusKnown());
+}
+
+void test_outage_alert_and_recovery_latency(void) {
+    Sim& s = fresh();
+    s.outage(2 * MIN + 7 * SEC, 10 * MIN);
+    s.boot();
+    s.runUntil(20 * MIN);
+
+    uint32_t start = 2 * MIN + 7 * SEC;
+    uint32_t on    = s.first(Kind::ALARM_ON, start);
+    uint32_t down  = s.first(Kind::SHOW, start, Screen::SITE_DOWN);
+    TEST_ASSERT_TRUE(on != NEVER);
+    TEST_ASSERT_EQUAL_UINT32(down, on);
+    TEST_ASSERT_TRUE(on - start <= INTERVAL + 2 * BASE_LATENCY);
+
+    uint32_t end = start + 10 * MIN;
+    uint32_t off = s.first(Kind::ALARM_OFF, start);
+    TEST_ASSERT_TRUE(off >= end);
+    TEST_ASSERT_TRUE(off - end <= INTERVAL + 2 * BASE_LATENCY);
+    TEST_ASSERT_EQUAL_UINT32(1, s.io.alarms);   // One alarm, held across checks
+    TEST_ASSERT_EQUAL(Screen::SITE_UP, s.io.screen);
+}
+
+void test_unreachable_site_waits_for_timeout(void) {
+    Sim& s = fresh();
+    s.outage(1 * MIN, 5 * MIN, 0);   // No response at all
+    s.boot();
+    s.runUntil(10 * MIN);
+
+    uint32_t on = s.first(Kind::ALARM_ON, 1 * MIN);
+    TEST_ASSERT_TRUE(on - 1 * MIN <= INTERVAL + 10000);
+    TEST_ASSERT_EQUAL_UINT32(1, s.io.alarms);
+}
+
+void test_blip_between_checks_goes_unseen(void) {
+    Sim& s = fresh();
+    s.outage(70 * SEC, 20 * SEC);   // Between the 65s and 125s checks
+    s.boot();
+    s.runUntil(5 * MIN);
+
+    TEST_ASSERT_EQUAL_UINT32(0, s.io.alarms);
+    TEST_ASSERT_EQUAL_UINT32(0, s.count(Kind::SHOW, 0, 5 * MIN, Screen::SITE_DOWN));
+}
+
+// ============== Tests: Beacon Group ==============
+
+void test_board_without_beacon_probes_alone(void) {
+    Sim& s = fresh();   // The multicast join never succeeds
+    s.outage(10 * MIN, 5 * MIN);
+    s.boot();
+    s.runUntil(30 * MIN);
+
+    TEST_ASSERT_FALSE(s.joined);
+    TEST_ASSERT_EQUAL_UINT32(30, s.checks);
+    TEST_ASSERT_TRUE(s.monitor.statusKnown());
+    TEST_ASSERT_TRUE(s.first(Kind::ALARM_ON, 10 * MIN) - 10 * MIN <= INTERVAL + 2 * BASE_LATENCY);
+    TEST_ASSERT_EQUAL(Screen::SITE_UP, s.io.screen);
+}
+
+void test_late_join_hands_over_to_election(void) {
+    Sim& s = fresh();
+    uint32_t joinAt = 2 * MIN + 30 * SEC;
+    s.join(joinAt);
+    s.boot();
+
+    s.runUntil(joinAt);
+    TEST_ASSERT_EQUAL_UINT32(3, s.checks);   // Alone: 5s, 65s, 125s
+
+    // One lease of listening, then leader of a fleet of one, checking at once
+    s.runUntil(joinAt + LEASE - SEC);
+    TEST_ASSERT_EQUAL(Election::Role::LISTENING, s.election.role());
+    TEST_ASSERT_EQUAL_UINT32(3, s.checks);
+    s.runUntil(joinAt + LEASE + 3 * SEC);
+    TEST_ASSERT_TRUE(s.election.isLeader());
+    TEST_ASSERT_EQUAL_UINT32(4, s.checks);
+
+    s.runUntil(10 * MIN);
+    TEST_ASSERT_EQUAL_UINT32(1, s.election.changes());
+    TEST_ASSERT_UINT32_WITHIN(1, 11, s.checks);
+}
+
+// ============== Tests: Mute Button ==============
+
+void test_muted_outage_shows_without_alarm(void) {
+    Sim& s = fresh();
+    s.press(30 * SEC);
+    s.outage(2 * MIN, 5 * MIN);
+    s.press(10 * MIN);
+    s.boot();
+    s.runUntil(12 * MIN);
+
+    TEST_ASSERT_EQUAL_UINT32(30 * SEC, s.first(Kind::SHOW, 0, Screen::MUTED));
+    TEST_ASSERT_TRUE(s.first(Kind::SHOW, 2 * MIN, Screen::SITE_DOWN) - 2 * MIN <= INTERVAL + 2 * BASE_LATENCY);
+    TEST_ASSERT_EQUAL_UINT32(0, s.io.alarms);
+
+    TEST_ASSERT_EQUAL_UINT32(10 * MIN, s.first(Kind::SHOW, 8 * MIN, Screen::UNMUTED));
+    TEST_ASSERT_EQUAL_UINT32(10 * MIN, s.first(Kind::BEEP, 0));
+    TEST_ASSERT_FALSE(s.monitor.muted());
+}
+
+void test_button_bounce_toggles_once(void) {
+    Sim& s = fresh();
+    s.press(30 * SEC);
+    s.press(30 * SEC + 50);
+    s.press(30 * SEC + 150);
+    s.press(30 * SEC + 250);   // A second, real press
+    s.boot();
+    s.runUntil(1 * MIN);
+
+    TEST_ASSERT_EQUAL_UINT32(1, s.count(Kind::SHOW, 0, 1 * MIN, Screen::MUTED));
+    TEST_ASSERT_EQUAL_UINT32(1, s.count(Kind::SHOW, 0, 1 * MIN, Screen::UNMUTED));
+    TEST_ASSERT_EQUAL_UINT32(30 * SEC + 250, s.first(Kind::BEEP, 0));
+}
+
+void test_mute_silences_running_alarm(void) {
+    Sim& s = fresh();
+    s.outage(1 * MIN, 10 * MIN);
+    s.press(4 * MIN);
+    s.boot();
+    s.runUntil(8 * MIN);
+
+    TEST_ASSERT_EQUAL_UINT32(4 * MIN, s.first(Kind::ALARM_OFF, 0));
+    TEST_ASSERT_FALSE(s.io.alarmOn);
+    TEST_ASSERT_EQUAL_UINT32(1, s.io.alarms);   // Later down results stay quiet
+}
+
+// ============== Tests: WiFi ==============
+
+void test_wifi_drop_alarms_and_reconnects(void) {
+    Sim& s = fresh();
+    s.drop(3 * MIN + 10 * SEC, 2 * MIN);
+    s.boot();
+
+    uint32_t dropAt = 3 * MIN + 10 * SEC;
+    uint32_t back   = dropAt + 2 * MIN;
+    s.runUntil(dropAt);
+    uint32_t checks = s.checks;
+    s.runUntil(back);
+    TEST_ASSERT_EQUAL_UINT32(checks, s.checks);   // No checks while down
+    s.runUntil(10 * MIN);
+
+    TEST_ASSERT_EQUAL_UINT32(dropAt, s.first(Kind::ALARM_ON, 0));
+
+    // Reconnect attempts every RECONNECT while down, each one shown
+    size_t attempts = s.count(Kind::SHOW, dropAt, back, Screen::WIFI_RECONNECT);
+    TEST_ASSERT_TRUE(attempts >= 3 && attempts <= 5);
+
+    // Alarm off and checks resume after the link returns
+    uint32_t off = s.first(Kind::ALARM_OFF, dropAt);
+    TEST_ASSERT_TRUE(off >= back && off - back <= RECONNECT + RECONNECT_MS);
+    TEST_ASSERT_TRUE(s.first(Kind::SHOW, back, Screen::SITE_UP) - back <= INTERVAL + RECONNECT + RECONNECT_MS);
+    TEST_ASSERT_EQUAL_UINT32(1, s.monitor.reconnects());
+    TEST_ASSERT_TRUE(s.monitor.wifiConnected());
+}
+
+// ============== Tests: Slow Site ==============
+
+void test_slow_site_shows_and_chirps(void) {
+    Sim& s = fresh();
+    s.slowFor(20 * MIN, 10 * MIN, 2500);   // After the EWMA warmup
+    s.boot();
+    s.runUntil(45 * MIN);
+
+    TEST_ASSERT_EQUAL_UINT32(0, s.count(Kind::SHOW, 0, 20 * MIN, Screen::SITE_SLOW));
+    uint32_t slowAt = s.first(Kind::SHOW, 20 * MIN, Screen::SITE_SLOW);
+    TEST_ASSERT_TRUE(slowAt - 20 * MIN <= 2 * INTERVAL + 2500);   // enterCount = 2
+    TEST_ASSERT_TRUE(s.io.chirps >= 5);
+    TEST_ASSERT_EQUAL_UINT32(0, s.io.alarms);   // Slow is not down
+
+    uint32_t normal = s.first(Kind::SHOW, 30 * MIN, Screen::SITE_UP);
+    TEST_ASSERT_TRUE(normal - 30 * MIN <= 3 * INTERVAL + BASE_LATENCY);   // exitCount = 3
+    TEST_ASSERT_FALSE(s.monitor.siteSlow());
+}
+
+// ============== Tests: Long Runs ==============
+
+/**
+ * Random outages and WiFi drops over three weeks; every outage longer
+ * than two intervals must raise the alarm within one interval plus the
+ * probe time, and clear it within one interval of recovery
+ */
+void test_weeks_of_random_incidents(void) {
+    Sim& s = fresh();
+    rngState = 2024;
+
+    const uint32_t SPAN = 21 * DAY;
+    uint32_t t = 2 * HOUR;
+    while (t < SPAN - DAY && s.outageCount < Sim::WINDOW_MAX) {
+        uint32_t len = 3 * MIN + rng() % (45 * MIN);
+        s.outage(t, len, (rng() & 1) ? 503 : 0);
+        if (s.dropCount < Sim::WINDOW_MAX && (rng() & 3) == 0) {
+            s.drop(t + len + HOUR + rng() % HOUR, 30 * SEC + rng() % (10 * MIN));
+        }
+        t += len + 4 * HOUR + rng() % (12 * HOUR);
+    }
+
+    uint32_t start = Bench::nowUs();
+    s.boot();
+    s.runUntil(SPAN);
+    uint32_t us = Bench::nowUs() - start;
+
+    TEST_ASSERT_TRUE(s.io.marks < FakeIo::TIMELINE_MAX);   // Edges only; timeline fits
+    TEST_ASSERT_UINT32_WITHIN(SPAN / INTERVAL / 50, SPAN / INTERVAL, s.checks);
+
+    for (size_t i = 0; i < s.outageCount; i++) {
+        const Window& o = s.outages[i];
+        if (inside(s.drops, s.dropCount, o.start)) continue;   // WiFi alarm already on
+        uint32_t on = s.first(Kind::ALARM_ON, o.start);
+        char msg[64];
+        snprintf(msg, sizeof(msg), "outage %u at %u ms", static_cast<unsigned>(i), static_cast<unsigned>(o.start));
+        TEST_ASSERT_TRUE_MESSAGE(on < o.end + INTERVAL, msg);
+        TEST_ASSERT_TRUE_MESSAGE(on - o.start <= INTERVAL + 10000, msg);
+        uint32_t off = s.first(Kind::ALARM_OFF, o.end);
+        TEST_ASSERT_TRUE_MESSAGE(off - o.end <= INTERVAL + BASE_LATENCY * 2, msg);
+    }
+    TEST_ASSERT_EQUAL_UINT32(s.dropCount, s.monitor.reconnects());
+
+    char msg[96];
+    snprintf(msg, sizeof(msg), "%u days, %u checks, %u outages, %u drops in %u us",
+             static_cast<unsigned>(SPAN / DAY), static_cast<unsigned>(s.checks),
+             static_cast<unsigned>(s.outageCount), static_cast<unsigned>(s.dropCount),
+             static_cast<unsigned>(us));
+    TEST_MESSAGE(msg);
+}
+
+void test_millis_wrap_mid_outage(void) {
+    Sim& s = fresh();
+    s.epoch = 0xFFFFFFFFu - 30 * MIN;   // millis() wraps 30 minutes in
+    s.outage(25 * MIN, 10 * MIN);
+    s.boot();
+    s.runUntil(1 * HOUR);
+
+    uint32_t on  = s.first(Kind::ALARM_ON, 25 * MIN);
+    uint32_t off = s.first(Kind::ALARM_OFF, 35 * MIN);
+    TEST_ASSERT_TRUE(on - 25 * MIN <= INTERVAL + 2 * BASE_LATENCY);
+    TEST_ASSERT_TRUE(off - 35 * MIN <= INTERVAL + 2 * BASE_LATENCY);
+    TEST_ASSERT_UINT32_WITHIN(1, 60, s.checks);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    rngState = 1;
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Checks and outages
+    RUN_TEST(test_first_check_after_boot);
+    RUN_TEST(test_outage_alert_and_recovery_latency);
+    RUN_TEST(test_unreachable_site_waits_for_timeout);
+    RUN_TEST(test_blip_between_checks_goes_unseen);
+
+    // Beacon group
+    RUN_TEST(test_board_without_beacon_probes_alone);
+    RUN_TEST(test_late_join_hands_over_to_election);
+
+    // Mute button
+    RUN_TEST(test_muted_outage_shows_without_alarm);
+    RUN_TEST(test_button_bounce_toggles_once);
+    RUN_TEST(test_mute_silences_running_alarm);
+
+    // WiFi
+    RUN_TEST(test_wifi_drop_alarms_and_reconnects);
+
+    // Slow site
+    RUN_TEST(test_slow_site_shows_and_chirps);
+
+    // Long runs
+    RUN_TEST(test_weeks_of_random_incidents);
+    RUN_TEST(test_millis_wrap_mid_outage);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
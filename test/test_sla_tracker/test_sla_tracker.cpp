@@ -0,0 +1,187 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_sla_tracker.cpp
+ *
+ * Tests for the rolling SLA windows (include/sla_tracker.h)
+ *
+ * Run with: pio test -e native -f test_sla_tracker
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include "sla_tracker.h"
+
+using Sla::Window;
+
+static const uint32_t MIN  = 60000;
+static const uint32_t HOUR = 60 * MIN;
+
+static Sla::Tracker sla;
+static uint32_t     now;
+
+// Report the same state every interval for duration
+static void hold(bool up, uint32_t duration, uint32_t interval = MIN) {
+    for (uint32_t t = 0; t < duration; t += interval) {
+        now += interval;
+        sla.update(now, up);
+    }
+}
+
+// ============== Tests: Availability ==============
+
+void test_nothing_known_reads_as_available(void) {
+    const Sla::Summary& s = sla.summary(Window::DAY);
+    TEST_ASSERT_EQUAL_UINT32(1000000, s.availabilityPpm());
+    TEST_ASSERT_EQUAL_UINT32(0, s.incidents);
+    TEST_ASSERT_EQUAL_UINT32(0, s.mttrS());
+}
+
+void test_time_credited_to_reported_state(void) {
+    sla.update(now, true);
+    hold(true, 30 * MIN);
+    hold(false, 6 * MIN);   // First down report closes the last up minute
+    now += MIN;
+    sla.tick(now);
+
+    const Sla::Summary& s = sla.summary(Window::HOUR);
+    TEST_ASSERT_EQUAL_UINT32(31 * 60, s.upS);
+    TEST_ASSERT_EQUAL_UINT32(6 * 60, s.downS);
+    TEST_ASSERT_EQUAL_UINT32(837837, s.availabilityPpm());   // 31 / 37
+}
+
+void test_incidents_and_repair_times(void) {
+    sla.update(now, true);
+    for (int i = 0; i < 3; i++) {
+        hold(true, 18 * MIN);
+        hold(false, 2 * MIN);
+    }
+    hold(true, MIN);   // Repair of the last outage
+
+    const Sla::Summary& s = sla.summary(Window::HOUR);
+    TEST_ASSERT_EQUAL_UINT32(3, s.incidents);
+    TEST_ASSERT_EQUAL_UINT32(2 * 60, s.mttrS());
+    TEST_ASSERT_EQUAL_UINT32(55 * 60 / 3, s.mtbfS());   // 19 + 18 + 18 minutes up
+}
+
+void test_pause_leaves_time_out(void) {
+    sla.update(now, true);
+    hold(true, 10 * MIN);
+    hold(false, MIN);
+    sla.pause(now + MIN);          // WiFi lost while down
+    now += 30 * MIN;
+    sla.update(now, false);        // Same outage, not a new incident
+    hold(false, MIN);
+
+    const Sla::Summary& s = sla.summary(Window::HOUR);
+    TEST_ASSERT_EQUAL_UINT32(11 * 60, s.upS);
+    TEST_ASSERT_EQUAL_UINT32(2 * 60, s.downS);         // The 29 paused minutes are left out
+    TEST_ASSERT_EQUAL_UINT32(1, s.incidents);
+}
+
+// ============== Tests: Windows ==============
+
+void test_old_time_leaves_short_window_only(void) {
+    sla.update(now, true);
+    hold(false, 30 * MIN);
+    hold(true, 2 * HOUR, 5 * MIN);
+
+    TEST_ASSERT_EQUAL_UINT32(1000000, sla.summary(Window::HOUR).availabilityPpm());
+    TEST_ASSERT_EQUAL_UINT32(0, sla.summary(Window::HOUR).incidents);
+    TEST_ASSERT_EQUAL_UINT32(34 * 60, sla.summary(Window::DAY).downS);   // Until the first up report
+    TEST_ASSERT_EQUAL_UINT32(1, sla.summary(Window::WEEK).incidents);
+}
+
+void test_window_covers_span_plus_filling_bucket(void) {
+    sla.update(now, true);
+    hold(true, 3 * HOUR, 10 * MIN);
+    uint32_t known = sla.summary(Window::HOUR).knownS();
+    TEST_ASSERT_TRUE(known >= 3600);
+    TEST_ASSERT_TRUE(known < 3600 + 300);
+}
+
+void test_long_gap_clears_windows(void) {
+    sla.update(now, false);
+    hold(false, HOUR);
+    sla.pause(now);
+    now += 10 * 24 * HOUR;   // Ten days without status
+    sla.tick(now);
+
+    for (uint8_t w = 0; w < static_cast<uint8_t>(Window::COUNT); w++) {
+        TEST_ASSERT_EQUAL_UINT32(0, sla.summary(static_cast<Window>(w)).knownS());
+        TEST_ASSERT_EQUAL_UINT32(0, sla.summary(static_cast<Window>(w)).incidents);
+    }
+}
+
+// ============== Tests: Clock ==============
+
+void test_sub_second_updates_carry(void) {
+    sla.update(now, true);
+    hold(true, 60000, 300);   // Results every 300 ms for a minute
+    TEST_ASSERT_EQUAL_UINT32(60, sla.summary(Window::HOUR).upS);
+}
+
+void test_millis_wrap(void) {
+    now = 0xFFFFFFFF - 30000;
+    sla.update(now, true);
+    hold(true, 2 * MIN);
+    TEST_ASSERT_EQUAL_UINT32(120, sla.summary(Window::DAY).upS);
+}
+
+void test_window_names(void) {
+    TEST_ASSERT_EQUAL_STRING("1h", Sla::windowName(Window::HOUR));
+    TEST_ASSERT_EQUAL_STRING("7d", Sla::windowName(Window::WEEK));
+    TEST_ASSERT_EQUAL_STRING("?", Sla::windowName(Window::COUNT));
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    sla = Sla::Tracker();
+    now = 1000;
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    // Availability
+    RUN_TEST(test_nothing_known_reads_as_available);
+    RUN_TEST(test_time_credited_to_reported_state);
+    RUN_TEST(test_incidents_and_repair_times);
+    RUN_TEST(test_pause_leaves_time_out);
+
+    // Windows
+    RUN_TEST(test_old_time_leaves_short_window_only);
+    RUN_TEST(test_window_covers_span_plus_filling_bucket);
+    RUN_TEST(test_long_gap_clears_windows);
+
+    // Clock
+    RUN_TEST(test_sub_second_updates_carry);
+    RUN_TEST(test_millis_wrap);
+    RUN_TEST(test_window_names);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
@@ -0,0 +1,128 @@
+/**
+ * Unit Tests for LED-Panel-ESP12F
+ * Test File: test_tls_buffers.cpp
+ *
+ * Tests for per-host TLS buffer sizes (include/tls_buffers.h): one MFLN
+ * probe per host, full buffers for hosts that refuse it, the heap
+ * guard's allSmall() and least recently used replacement.
+ *
+ * Run with: pio test -e native -f test_tls_buffers
+ */
+
+#ifdef ARDUINO
+#include <Arduino.h>
+#endif
+#include <unity.h>
+#include <stdint.h>
+#include <string.h>
+#include "tls_buffers.h"
+
+typedef TlsBuffers::Table<3> Table;
+
+static Table    table;
+static uint32_t probed;
+
+// MFLN as the servers answer it: the CDN ignores it
+static bool small(const char* host, uint16_t port = 443) {
+    return table.small(host, port, [&] {
+        probed++;
+        return strcmp(host, "cdn.example.net") != 0;
+    });
+}
+
+// ============== Tests ==============
+
+void test_probed_once_per_host(void) {
+    TEST_ASSERT_TRUE(small("example.com"));
+    TEST_ASSERT_TRUE(small("example.com"));
+    TEST_ASSERT_TRUE(small("www.example.com"));
+    TEST_ASSERT_EQUAL_UINT32(2, probed);
+    TEST_ASSERT_EQUAL_UINT32(2, table.probes());
+}
+
+void test_refusing_host_gets_full_buffers(void) {
+    // Configured host honours MFLN, the redirect target does not
+    TEST_ASSERT_TRUE(small("example.com"));
+    TEST_ASSERT_FALSE(small("cdn.example.net"));
+    TEST_ASSERT_FALSE(small("cdn.example.net"));
+    TEST_ASSERT_TRUE(small("example.com"));
+    TEST_ASSERT_EQUAL_UINT32(2, probed);
+}
+
+void test_port_is_part_of_the_host(void) {
+    small("example.com", 443);
+    small("example.com", 8443);
+    TEST_ASSERT_EQUAL_UINT32(2, probed);
+}
+
+void test_all_small_for_the_heap_guard(void) {
+    TEST_ASSERT_FALSE(table.allSmall());   // Nothing known: reserve for full buffers
+    small("example.com");
+    small("www.example.com");
+    TEST_ASSERT_TRUE(table.allSmall());
+    small("cdn.example.net");
+    TEST_ASSERT_FALSE(table.allSmall());
+}
+
+void test_least_recent_host_replaced(void) {
+    small("a.example.com");
+    small("b.example.com");
+    small("c.example.com");
+    small("a.example.com");     // b is now the least recently used
+    small("d.example.com");
+    TEST_ASSERT_EQUAL_UINT32(4, probed);
+    small("a.example.com");
+    small("c.example.com");
+    TEST_ASSERT_EQUAL_UINT32(4, probed);
+    small("b.example.com");     // Probed again
+    TEST_ASSERT_EQUAL_UINT32(5, probed);
+}
+
+void test_clear_forgets_hosts(void) {
+    small("cdn.example.net");
+    table.clear();
+    TEST_ASSERT_FALSE(table.allSmall());
+    small("cdn.example.net");
+    TEST_ASSERT_EQUAL_UINT32(2, probed);
+}
+
+// ============== Unity Setup/Teardown ==============
+
+void setUp(void) {
+    table  = Table();
+    probed = 0;
+}
+
+void tearDown(void) {
+    // Nothing to tear down
+}
+
+// ============== Test Runner ==============
+
+int runTests() {
+    UNITY_BEGIN();
+
+    RUN_TEST(test_probed_once_per_host);
+    RUN_TEST(test_refusing_host_gets_full_buffers);
+    RUN_TEST(test_port_is_part_of_the_host);
+    RUN_TEST(test_all_small_for_the_heap_guard);
+    RUN_TEST(test_least_recent_host_replaced);
+    RUN_TEST(test_clear_forgets_hosts);
+
+    return UNITY_END();
+}
+
+#ifdef ARDUINO
+void setup() {
+    delay(2000);  // Allow board to settle
+    runTests();
+}
+
+void loop() {
+    // Nothing to do here
+}
+#else
+int main(int argc, char** argv) {
+    return runTests();
+}
+#endif
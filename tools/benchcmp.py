@@ -0,0 +1,88 @@
+#!/usr/bin/env python3
+"""
+LED-Panel-ESP12F - Compare benchmark runs
+
+Reads the JSON result lines written by test/test_benchmark (format:
+include/bench.h) and prints them, or compares two runs side by side and
+flags every result that got worse by more than the threshold.
+
+    tools/benchcmp.py bench.jsonl
+    tools/benchcmp.py old.jsonl new.jsonl --threshold 10
+    pio test -e esp12e_bench | tools/benchcmp.py old-esp.jsonl -
+
+Input may also be captured test output: any line containing a result
+object is used, everything else is ignored. Lower is better for every
+unit (ns per operation, us, bytes). Exits with 1 if anything regressed.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    """{(target, bench): (value, unit)} from a result file or test log"""
+    results = {}
+    stream = sys.stdin if path == "-" else open(path)
+    with stream:
+        for line in stream:
+            start = line.find('{"target"')
+            if start < 0:
+                continue
+            try:
+                r = json.loads(line[start:line.rindex("}") + 1])
+            except ValueError:
+                continue
+            results[(r["target"], r["bench"])] = (r["value"], r["unit"])
+    return results
+
+
+def show(results):
+    for (target, bench), (value, unit) in sorted(results.items()):
+        print("%-8s %-24s %12s" % (target, bench, "%d %s" % (value, unit)))
+
+
+def compare(old, new, threshold):
+    regressions = 0
+    print("%-8s %-24s %12s %12s %8s" % ("target", "bench", "old", "new", "change"))
+    for key in sorted(set(old) | set(new)):
+        target, bench = key
+        if key not in old or key not in new:
+            value, unit = old.get(key) or new.get(key)
+            print("%-8s %-24s %12s %12s %8s" % (target, bench,
+                  "-" if key not in old else value, "-" if key not in new else value,
+                  "only " + ("old" if key in old else "new")))
+            continue
+        (before, unit), (after, _) = old[key], new[key]
+        change = (after - before) * 100.0 / before if before else 0.0
+        flag = ""
+        if change > threshold:
+            flag = "  <-- worse"
+            regressions += 1
+        print("%-8s %-24s %12s %12s %+7.1f%%%s" % (target, bench, "%d %s" % (before, unit),
+              "%d %s" % (after, unit), change, flag))
+    return regressions
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Print or compare benchmark results")
+    ap.add_argument("old", help="result file or test log ('-' for stdin)")
+    ap.add_argument("new", nargs="?", help="second run to compare against the first")
+    ap.add_argument("--threshold", type=float, default=10.0,
+                    help="percent increase counted as a regression (default 10)")
+    args = ap.parse_args()
+
+    old = load(args.old)
+    if args.new is None:
+        show(old)
+        return 0
+
+    regressions = compare(old, load(args.new), args.threshold)
+    if regressions:
+        print("%d result(s) worse by more than %g%%" % (regressions, args.threshold))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+"""
+LED-Panel-ESP12F - Decode the flash event log
+
+Prints the board's event log (format: include/event_log.h) as a timeline,
+grouped by boot, so an overnight flap can be read back in the morning.
+
+    curl -s http://ledpanel.local/events | tools/eventlog.py
+    tools/eventlog.py events0.bin events1.bin ...
+
+Input is either the /events stream (records only, oldest first) or the
+segment files copied off LittleFS (header, then records). Records failing
+their CRC-8 are counted and skipped.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC       = b"LPEV"
+VERSION     = 1
+RECORD_SIZE = 16
+HEADER_SIZE = 16
+
+# type, check, code, boot, extra, uptime, value
+RECORD = struct.Struct("<BBhHHII")
+# magic, version, record size, reserved, seq, crc
+HEADER = struct.Struct("<4sBBHII")
+
+TYPES = ("none", "reset", "site_up", "site_down", "probe_fail", "wifi_down", "wifi_up",
+         "site_slow")
+
+RESET_REASONS = ("power_on", "hw_watchdog", "exception", "soft_watchdog",
+                 "soft_restart", "deep_sleep_wake", "external")
+
+SECTIONS = ("boot", "display", "button", "wifi_check", "wifi_reconnect", "probe", "idle",
+            "restart", "mqtt", "config", "console", "push", "http_server", "beacon", "events",
+            "log")
+
+
+def crc8(data):
+    crc = 0
+    for b in data:
+        crc ^= b
+        for _ in range(8):
+            crc = ((crc << 1) ^ 0x07) & 0xFF if crc & 0x80 else (crc << 1) & 0xFF
+    return crc
+
+
+def segment(data):
+    """(seq, records) of a segment file, or None if the header is bad"""
+    if len(data) < HEADER_SIZE:
+        return None
+    magic, version, size, _, seq, crc = HEADER.unpack_from(data)
+    if magic != MAGIC or version != VERSION or size != RECORD_SIZE:
+        return None
+    if zlib.crc32(data[:12]) & 0xFFFFFFFF != crc:
+        return None
+    return seq, data[HEADER_SIZE:]
+
+
+def decode(data):
+    """Yield decoded records; None for each torn or corrupt one"""
+    for off in range(0, len(data) - RECORD_SIZE + 1, RECORD_SIZE):
+        raw = data[off:off + RECORD_SIZE]
+        kind, check, code, boot, extra, uptime, value = RECORD.unpack(raw)
+        if not 0 < kind < len(TYPES) or check != crc8(raw[2:]):
+            yield None
+            continue
+        yield dict(type=TYPES[kind], code=code, boot=boot, extra=extra, uptime=uptime,
+                   value=value)
+
+
+def describe(e):
+    t = e["type"]
+    if t == "reset":
+        reason = e["value"]
+        text = RESET_REASONS[reason] if reason < len(RESET_REASONS) else "reason %d" % reason
+        if e["extra"] < len(SECTIONS):
+            text += ", previous run stopped in %s" % SECTIONS[e["extra"]]
+        if reason == 2:
+            text += ", exception %d" % e["code"]
+        return text
+    if t in ("site_up", "site_down", "probe_fail", "site_slow"):
+        return "code %d, %d ms" % (e["code"], e["value"])
+    if t == "wifi_up":
+        return "%d reconnects" % e["value"]
+    return ""
+
+
+def clock(ms):
+    s = ms // 1000
+    return "%3d:%02d:%02d.%03d" % (s // 3600, s // 60 % 60, s % 60, ms % 1000)
+
+
+def main():
+    p = argparse.ArgumentParser(description="Print the LED panel's event log as a timeline")
+    p.add_argument("files", nargs="*", help="segment files or a saved /events stream "
+                                            "(default: stdin)")
+    args = p.parse_args()
+
+    # Segment files are ordered by their sequence numbers, streams kept as given
+    chunks = []
+    for name in args.files or ["-"]:
+        data = sys.stdin.buffer.read() if name == "-" else open(name, "rb").read()
+        seg = segment(data)
+        chunks.append(seg if seg else (None, data))
+    if all(seq is not None for seq, _ in chunks):
+        chunks.sort(key=lambda c: c[0])
+
+    bad = 0
+    boot = None
+    for _, data in chunks:
+        for e in decode(data):
+            if e is None:
+                bad += 1
+                continue
+            if e["boot"] != boot:
+                boot = e["boot"]
+                print("--- boot %d" % boot)
+            print("%s  %-10s %s" % (clock(e["uptime"]), e["type"], describe(e)))
+
+    if bad:
+        print("(%d torn or corrupt records skipped)" % bad, file=sys.stderr)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
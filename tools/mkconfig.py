@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""
+LED-Panel-ESP12F - Build /config.bin
+
+Writes the binary settings record read by the firmware at boot and
+re-read every few seconds (format: include/config_store.h). Options not
+given keep the compiled-in defaults from config.h.
+
+    tools/mkconfig.py --url https://example.com/health --check-interval 60000
+    pio run -t uploadfs
+
+The default output path is data/config.bin, which uploadfs copies to the
+board's LittleFS. Use --dump to inspect an existing record.
+"""
+
+import argparse
+import os
+import struct
+import sys
+import zlib
+
+MAGIC       = b"LPCF"
+VERSION     = 1
+HEADER_SIZE = 36
+RECORD_MAX  = 384
+CHECK_MIN   = 5000
+TIMEOUT_MIN = 500
+
+# magic, version, flags, length, crc, check, timeout, reconnect,
+# intensity, reserved, scroll speed, ssid, pass, url, rules
+HEADER = struct.Struct("<4sBBHIIIIBBHHHHH")
+
+
+def build(check=0, timeout=0, reconnect=0, intensity=0, speed=0,
+          ssid=None, password=None, url=None, rules=None):
+    if check and check < CHECK_MIN:
+        raise ValueError("check interval must be at least %d ms" % CHECK_MIN)
+    if timeout and timeout < TIMEOUT_MIN:
+        raise ValueError("HTTP timeout must be at least %d ms" % TIMEOUT_MIN)
+    if not 0 <= intensity <= 15:
+        raise ValueError("intensity must be 1-15")
+
+    strings = b""
+    offsets = []
+    for text in (ssid, password, url, rules):
+        if text is None:
+            offsets.append(0)
+            continue
+        offsets.append(HEADER_SIZE + len(strings))
+        strings += text.encode("utf-8") + b"\0"
+
+    length = HEADER_SIZE + len(strings)
+    if length > RECORD_MAX:
+        raise ValueError("record is %d bytes, limit is %d" % (length, RECORD_MAX))
+
+    def pack(crc):
+        return HEADER.pack(MAGIC, VERSION, 0, length, crc, check, timeout, reconnect,
+                           intensity, 0, speed, *offsets) + strings
+
+    body = pack(0)[12:]
+    return pack(zlib.crc32(body) & 0xFFFFFFFF)
+
+
+def dump(data):
+    fields = HEADER.unpack_from(data)
+    magic, version, _, length, crc = fields[:5]
+    print("magic=%r version=%d length=%d crc=%08x (%s)" % (
+        magic, version, length, crc,
+        "ok" if zlib.crc32(data[12:length]) & 0xFFFFFFFF == crc else "BAD"))
+    names = ("check_interval_ms", "http_timeout_ms", "reconnect_ms", "intensity", None,
+             "scroll_speed")
+    for name, value in zip(names, fields[5:11]):
+        if name:
+            print("%-18s %s" % (name, value if value else "(default)"))
+    for name, offset in zip(("ssid", "pass", "url", "rules"), fields[11:15]):
+        text = data[offset:data.index(b"\0", offset)].decode() if offset else "(default)"
+        print("%-18s %s" % (name, "***" if name == "pass" and offset else text))
+
+
+def main():
+    p = argparse.ArgumentParser(description="Build the LED panel's /config.bin")
+    p.add_argument("-o", "--output", default="data/config.bin")
+    p.add_argument("--check-interval", type=int, default=0, metavar="MS")
+    p.add_argument("--http-timeout", type=int, default=0, metavar="MS")
+    p.add_argument("--reconnect", type=int, default=0, metavar="MS")
+    p.add_argument("--intensity", type=int, default=0, help="1-15")
+    p.add_argument("--scroll-speed", type=int, default=0, metavar="MS")
+    p.add_argument("--ssid")
+    p.add_argument("--password")
+    p.add_argument("--url")
+    p.add_argument("--rules", help='probe rules, e.g. "status=200-299; body~ok"')
+    p.add_argument("--dump", metavar="FILE", help="print an existing record and exit")
+    args = p.parse_args()
+
+    if args.dump:
+        with open(args.dump, "rb") as f:
+            dump(f.read())
+        return 0
+
+    try:
+        record = build(args.check_interval, args.http_timeout, args.reconnect, args.intensity,
+                       args.scroll_speed, args.ssid, args.password, args.url, args.rules)
+    except ValueError as e:
+        p.error(str(e))
+    os.makedirs(os.path.dirname(args.output) or ".", exist_ok=True)
+    with open(args.output, "wb") as f:
+        f.write(record)
+    print("Wrote %s (%d bytes)" % (args.output, len(record)))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())